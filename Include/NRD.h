@@ -57,7 +57,14 @@ namespace nrd
     NRD_API Result NRD_CALL CreateInstance(const InstanceCreationDesc& instanceCreationDesc, Instance*& instance);
     NRD_API void NRD_CALL DestroyInstance(Instance& instance);
 
+    // Creates a frame context - an instance sharing "InstanceDesc" (pipelines, pools) with "instance", but owning settings, ping-pong state,
+    // dispatches and constants. Different frame contexts can be used simultaneously on different threads (for example, to record
+    // different views). A denoiser must be consistently driven by the same instance or frame context. Use "DestroyInstance" to destroy
+    NRD_API Result NRD_CALL CreateFrameContext(const Instance& instance, Instance*& frameContext);
+
     // Get
+    // EXPERIMENTAL: bindless ("NRD_BINDLESS" builds, see "LibraryDesc::isBindless") is a work in progress, the expected descriptor heap layout
+    // (see "InstanceDesc::bindlessTexturesNum") and the bindless index layout in constants (see "NRD.hlsli") can change without notice
     NRD_API const LibraryDesc& NRD_CALL GetLibraryDesc();
     NRD_API const InstanceDesc& NRD_CALL GetInstanceDesc(const Instance& instance);
 
@@ -67,10 +74,31 @@ namespace nrd
     // Typically needs to be called at least once per denoiser (not necessarily on each frame)
     NRD_API Result NRD_CALL SetDenoiserSettings(Instance& instance, Identifier identifier, const void* denoiserSettings);
 
-    // Retrieves dispatches for the list of identifiers (if they are parts of the instance)
-    // IMPORTANT: returned memory is owned by the "instance" and will be overwritten by the next "GetComputeDispatches" call
+    // Retrieves dispatches for the list of identifiers (if they are parts of the instance). If "InstanceCreationDesc::enableGuideSharing" is set,
+    // guides (IN_MV, IN_NORMAL_ROUGHNESS, IN_VIEWZ) must be the same for all these denoisers
+    // IMPORTANT: returned memory is owned by the "instance" and will be overwritten by the next "GetComputeDispatches" call (or stays valid
+    // until "ReleaseFrame" if "InstanceCreationDesc::framesInFlightNum" is not 0)
     NRD_API Result NRD_CALL GetComputeDispatches(Instance& instance, const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
 
+    // ( Optional ) Alternative to "SetCommonSettings" + "GetComputeDispatches" for several views (stereo, split-screen co-op) denoised by
+    // one instance. Dispatches of all views are merged into one list. If views don't share transient textures, dispatches of the same pass in
+    // different views are adjacent. Several lights of the same view are better served by "SIGMA_SHADOW_ARRAY". User resources (IN_* / OUT_*)
+    // are per view: "DispatchDesc::viewIndex" tells which view's textures to bind. Projection derived state is cached per view index, so keep the order of views stable from frame to frame
+    // Constants stay per dispatch (no view-indexed constant array), since shaders are shared with "GetComputeDispatches". The call is validated before the instance
+    // state changes: a rejected call (a denoiser in several views, shared previous-frame guides written by several views, a disabled feature) has no effect
+    // IMPORTANT: returned memory is owned by the "instance" and will be overwritten by the next "GetComputeDispatches" call (or stays valid
+    // until "ReleaseFrame" if "InstanceCreationDesc::framesInFlightNum" is not 0)
+    NRD_API Result NRD_CALL GetComputeDispatchesMultiView(Instance& instance, const ViewDesc* viewDescs, uint32_t viewDescsNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
+
+    // ( Optional ) Returns memory of a "GetComputeDispatches" call back to the instance (pass "dispatchDescs" returned by the call). Needed only
+    // if "InstanceCreationDesc::framesInFlightNum" is not 0, in this case "GetComputeDispatches" fails if all frames are in flight
+    NRD_API Result NRD_CALL ReleaseFrame(Instance& instance, const DispatchDesc* dispatchDescs);
+
+    // ( Optional ) Dependency graph (an edge list, RAW, WAR and WAW hazards) of dispatches returned by the last "GetComputeDispatches" call.
+    // Dispatches not connected by a path can be reordered or executed concurrently (for example, on different queues)
+    // IMPORTANT: returned memory is owned by the "instance" and will be overwritten by the next "GetComputeDispatches" call
+    NRD_API Result NRD_CALL GetDispatchDependencies(Instance& instance, const DispatchDependencyDesc*& dependencyDescs, uint32_t& dependencyDescsNum);
+
     // Helpers
     NRD_API const char* GetResourceTypeString(ResourceType resourceType);
     NRD_API const char* GetDenoiserString(Denoiser denoiser);
@@ -154,6 +154,9 @@ namespace nrd
         // Dedicated to NRD, can't be reused
         PERMANENT_POOL,
 
+        // Dedicated to NRD, can't be reused. Buffers (not textures) holding arguments of indirect dispatches ("DispatchDesc::isIndirect"), empty if no REBLUR denoiser is used
+        INDIRECT_ARGUMENTS_POOL,
+
         MAX_NUM,
     };
 
@@ -251,6 +254,11 @@ namespace nrd
         // OUTPUTS - OUT_SHADOW_TRANSLUCENCY
         SIGMA_SHADOW_TRANSLUCENCY,
 
+        // INPUTS - IN_PENUMBRA, OUT_SHADOW_TRANSLUCENCY (texture arrays, a layer per light)
+        // OUTPUTS - OUT_SHADOW_TRANSLUCENCY (texture array)
+        // Several lights (see "DenoiserDesc::layersNum") are denoised by the same number of dispatches as one light
+        SIGMA_SHADOW_ARRAY,
+
         // =============================================================================================================================
         // REFERENCE
         // =============================================================================================================================
@@ -330,6 +338,12 @@ namespace nrd
         // read-write, UAV
         STORAGE_TEXTURE,
 
+        // read-write, UAV ("RWStructuredBuffer<uint>")
+        STORAGE_BUFFER,
+
+        // read-only, indirect arguments (not bound, see "DispatchDesc::isIndirect")
+        INDIRECT_ARGUMENTS,
+
         MAX_NUM
     };
 
@@ -373,6 +387,23 @@ namespace nrd
         MAX_NUM
     };
 
+    // Features, which a denoiser can declare as never used. Permutations needed only for them are not created
+    enum class DenoiserFeatureBits : uint32_t
+    {
+        NONE                                = 0,
+
+        // CommonSettings
+        HISTORY_CONFIDENCE                  = 1 << 0, // "isHistoryConfidenceAvailable"
+        DISOCCLUSION_THRESHOLD_MIX          = 1 << 1, // "isDisocclusionThresholdMixAvailable"
+        BASECOLOR_METALNESS                 = 1 << 2, // "isBaseColorMetalnessAvailable"
+        VALIDATION                          = 1 << 3, // "enableValidation"
+        SPLIT_SCREEN                        = 1 << 4, // "splitScreen"
+
+        // Denoiser settings
+        PERFORMANCE_MODE                    = 1 << 5, // "enablePerformanceMode"
+        HIT_DISTANCE_RECONSTRUCTION         = 1 << 6, // "hitDistanceReconstructionMode"
+    };
+
     struct AllocationCallbacks
     {
         void* (*Allocate)(void* userArg, size_t size, size_t alignment);
@@ -399,12 +430,16 @@ namespace nrd
         uint8_t versionBuild;
         NormalEncoding normalEncoding;
         RoughnessEncoding roughnessEncoding;
+        bool isBindless; // built with "NRD_BINDLESS": shaders take resources from descriptor heaps, indices travel in constants
     };
 
     struct DenoiserDesc
     {
         Identifier identifier;
         Denoiser denoiser;
+        uint32_t disabledFeatures = 0; // a combination of "DenoiserFeatureBits", requesting a disabled feature makes "GetComputeDispatches" fail
+        bool isTransientPoolPrivate = false; // transient textures are not shared with other denoisers (more memory), but such denoisers can be batched by "GetComputeDispatchesMultiView"
+        uint16_t layersNum = 0; // SIGMA_SHADOW_ARRAY only: number of lights (texture array layers), [1; SIGMA_MAX_LAYERS_NUM]. Must be 0 for other denoisers (no layered REBLUR / RELAX)
     };
 
     struct InstanceCreationDesc
@@ -412,12 +447,27 @@ namespace nrd
         AllocationCallbacks allocationCallbacks;
         const DenoiserDesc* denoisers;
         uint32_t denoisersNum;
+
+        // ( Optional ) If not 0, output of "GetComputeDispatches" (dispatches, resources, barriers and constants) stays valid
+        // until "ReleaseFrame", allowing up to this number of frames in flight
+        uint32_t framesInFlightNum;
+
+        // ( Optional ) Bindless only ("LibraryDesc::isBindless"), see "InstanceDesc::bindlessTexturesNum"
+        uint32_t resourceDescriptorHeapOffset;
+        uint32_t samplerDescriptorHeapOffset;
+
+        // ( Optional ) Denoisers of a "GetComputeDispatches" call (or a view) get the same guides (IN_MV, IN_NORMAL_ROUGHNESS, IN_VIEWZ):
+        //  - passes depending only on guides (like tile classification) are executed once
+        //  - 3+ REBLUR denoisers share previous-frame guides, which are swapped once per "GetComputeDispatches" call. Such denoisers must be
+        //    dispatched at the same rate, by the same instance (not by frame contexts) and in the same view
+        bool enableGuideSharing;
     };
 
     struct TextureDesc
     {
         Format format;
         uint16_t downsampleFactor;
+        uint16_t layersNum = 0; // 0 - "Texture2D", otherwise "Texture2DArray" with this number of layers
     };
 
     struct ResourceDesc
@@ -425,6 +475,7 @@ namespace nrd
         DescriptorType descriptorType;
         ResourceType type;
         uint16_t indexInPool;
+        bool isArray = false; // a "Texture2DArray" view covering all layers is expected
     };
 
     struct ResourceRangeDesc
@@ -447,7 +498,7 @@ namespace nrd
         ComputeShaderDesc computeShaderSPIRV;
         const char* shaderFileName;
         const char* shaderEntryPointName;
-        const ResourceRangeDesc* resourceRanges; // up to 2 ranges: "TEXTURE" inputs (optional) and "TEXTURE_STORAGE" outputs
+        const ResourceRangeDesc* resourceRanges; // up to 3 ranges: "TEXTURE" inputs (optional), "STORAGE_TEXTURE" outputs and "STORAGE_BUFFER" outputs (optional)
         uint32_t resourceRangesNum;
 
         // Hint that pipeline has a constant buffer with shared parameters from "InstanceDesc"
@@ -461,6 +512,7 @@ namespace nrd
         uint32_t samplersMaxNum;
         uint32_t texturesMaxNum;
         uint32_t storageTexturesMaxNum;
+        uint32_t storageBuffersMaxNum;
     };
 
     struct InstanceDesc
@@ -487,31 +539,77 @@ namespace nrd
         const TextureDesc* transientPool;
         uint32_t transientPoolSize;
 
+        // Buffers ("STORAGE_BUFFER" and "INDIRECT_ARGUMENTS" usage, structure stride is 4)
+        uint32_t indirectArgumentsPoolSize;
+        uint32_t indirectArgumentsBufferSize; // bytes
+
+        // ( Optional ) Bindless only ("LibraryDesc::isBindless"), expected descriptor heap layout:
+        // - texture "i" is "permanentPool[i]", "transientPool[i - permanentPoolSize]" or "ResourceType(i - permanentPoolSize - transientPoolSize)"
+        // - SRV of texture "i" at "resourceDescriptorHeapOffset + i", UAV at "resourceDescriptorHeapOffset + bindlessTexturesNum + i"
+        // - UAV of "indirectArgumentsPool[i]" at "resourceDescriptorHeapOffset + bindlessTexturesNum * 2 + i"
+        // - sampler "i" at "samplerDescriptorHeapOffset + i"
+        uint32_t bindlessTexturesNum;
+
         // ( Optional) Limits
         // - "DescriptorPoolDesc::samplersMaxNum" counts samplers across all dispatches, assuming naive usage
         // - "DescriptorPoolDesc::samplersMaxNum" is not needed, if "samplers" are used as static/immutable samplers
         // - "DescriptorPoolDesc::samplersMaxNum" = "InstanceDesc::samplersNum", if "InstanceDesc::samplersBaseRegisterIndex" is a unique space
+        // - bindless: only constant buffers are counted
         DescriptorPoolDesc descriptorPoolDesc;
     };
 
+    // A barrier, which must be issued before a dispatch. "before == after == STORAGE_TEXTURE / STORAGE_BUFFER" means a storage (UAV) barrier
+    struct BarrierDesc
+    {
+        uint32_t resourceIndex; // in "DispatchDesc::resources"
+        DescriptorType before; // "MAX_NUM" - unknown to NRD (the first access in "GetComputeDispatches" output), the application must use the tracked state
+        DescriptorType after;
+    };
+
+    // "DispatchDesc::pipelineIndex" of a permutation needed only for features in "DenoiserDesc::disabledFeatures" (such dispatches are never returned)
+    const uint16_t UNUSED_PIPELINE_INDEX = uint16_t(-1);
+
     struct DispatchDesc
     {
         // ( Optional )
         const char* name;
         Identifier identifier; // denoiser this dispatch belongs to
 
-        // Concatenated resources for all "resourceRanges" in "DenoiserDesc::pipelines[ pipelineIndex ]"
+        // Concatenated resources for all "resourceRanges" in "DenoiserDesc::pipelines[ pipelineIndex ]". Can be shorter than the ranges (partially
+        // filled "clear" batches): slots past "resourcesNum" are not accessed by the shader, but still need a valid descriptor (any from the same range)
         const ResourceDesc* resources;
         uint32_t resourcesNum;
 
-        // Constants
+        // Minimal set of barriers for "resources", which must be issued before the dispatch
+        const BarrierDesc* barriers;
+        uint32_t barriersNum;
+
+        // Constants: the constant buffer is "sharedConstantBufferData" (common for all dispatches of a denoiser) immediately followed by "constantBufferData"
+        // (pass specific, like rotators or A-trous step sizes), i.e. "sharedConstantBufferDataSize + constantBufferDataSize" bytes. Each part can be empty
+        const uint8_t* sharedConstantBufferData;
         const uint8_t* constantBufferData;
+        uint32_t sharedConstantBufferDataSize;
         uint32_t constantBufferDataSize;
+        uint32_t constantBufferIndex; // dispatches with the same index have identical constants (both parts), indices are dense and start from 0 within a "GetComputeDispatches" call
         bool constantBufferDataMatchesPreviousDispatch; // i.e. no update needed
 
         // Other
         uint16_t pipelineIndex;
         uint16_t gridWidth;
         uint16_t gridHeight;
+        uint16_t gridDepth; // number of thread groups along Z: texture array layers processed by a layered dispatch ("SIGMA_SHADOW_ARRAY"), otherwise 1
+        uint16_t viewIndex; // index in "viewDescs" of "GetComputeDispatchesMultiView" (0 for "GetComputeDispatches"), user resources (IN_* / OUT_*) belong to this view
+
+        // Thread group counts (3 x uint32_t at offset 0) must be taken from the last entry of "resources" ("INDIRECT_ARGUMENTS", not covered by "resourceRanges"),
+        // "grid*" are upper bounds. A prior dispatch of the same "GetComputeDispatches" output writes the arguments.
+        // Only REBLUR dispatches are indirect (launched over tiles compacted by its tile classification), other denoisers always use "grid*"
+        bool isIndirect;
+    };
+
+    // An edge of the dependency graph: dispatch "after" must wait for dispatch "before" (indices in "GetComputeDispatches" output)
+    struct DispatchDependencyDesc
+    {
+        uint32_t before;
+        uint32_t after;
     };
 }
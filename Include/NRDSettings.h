@@ -170,6 +170,14 @@ namespace nrd
         bool enableValidation = false;
     };
 
+    // A view for "GetComputeDispatchesMultiView": its own common settings and denoisers (a denoiser can't belong to several views)
+    struct ViewDesc
+    {
+        const CommonSettings* commonSettings;
+        const Identifier* identifiers;
+        uint32_t identifiersNum;
+    };
+
     // REBLUR
 
     const uint32_t REBLUR_MAX_HISTORY_FRAME_NUM = 63;
@@ -401,6 +409,17 @@ namespace nrd
         float stabilizationStrength = 1.0f; // TODO: replace with number of accumulated frames
     };
 
+    const uint32_t SIGMA_MAX_LAYERS_NUM = 16;
+
+    struct SigmaArraySettings
+    {
+        // "sigma.lightDirection" is ignored
+        SigmaSettings sigma;
+
+        // Directions to the light sources, one per layer (see "SigmaSettings::lightDirection")
+        float lightDirections[SIGMA_MAX_LAYERS_NUM][3] = {};
+    };
+
     // REFERENCE
 
     struct ReferenceSettings
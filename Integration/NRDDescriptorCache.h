@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#pragma once
+
+// Texture views cached by "NRDIntegration", doesn't depend on NRI (can be used headless)
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nrd
+{
+
+template<class Texture, class Descriptor>
+class DescriptorCache
+{
+public:
+    // Open addressing hash table entry
+    struct Entry
+    {
+        uint64_t key; // 0 - empty
+        const Texture* texture; // a view is valid only for the texture object it has been created for
+        Descriptor* descriptor;
+        uint32_t lastUsedFrameIndex;
+    };
+
+    inline DescriptorCache()
+    { m_Entries.assign(64, {}); }
+
+    // Returns the entry for "key" ("descriptor" is NULL if the view needs to be created). A recreated texture can get the same native
+    // object (i.e. the same key), in this case the stale view goes to "retire". The entry is valid until the next call
+    template<class Retire>
+    Entry& Find(uint64_t key, const Texture* texture, uint32_t frameIndex, Retire retire)
+    {
+        // Keep load factor <= 0.5
+        if ((m_EntriesNum + 1) * 2 > m_Entries.size())
+            Rebuild(m_Entries.size() * 2, frameIndex, uint32_t(-1), retire);
+
+        uint32_t mask = (uint32_t)m_Entries.size() - 1;
+        uint32_t i = Hash(key) & mask;
+        for (; m_Entries[i].key; i = (i + 1) & mask)
+        {
+            Entry& entry = m_Entries[i];
+            if (entry.key != key)
+                continue;
+
+            entry.lastUsedFrameIndex = frameIndex;
+
+            if (entry.texture != texture)
+            {
+                if (entry.descriptor)
+                    retire(entry.descriptor);
+
+                entry.texture = texture;
+                entry.descriptor = nullptr;
+            }
+
+            return entry;
+        }
+
+        m_Entries[i] = {key, texture, nullptr, frameIndex};
+        m_EntriesNum++;
+
+        return m_Entries[i];
+    }
+
+    // Views not used for "maxAge" frames go to "retire"
+    template<class Retire>
+    void Evict(uint32_t frameIndex, uint32_t maxAge, Retire retire)
+    { Rebuild(m_Entries.size(), frameIndex, maxAge, retire); }
+
+    template<class Retire>
+    void Clear(Retire retire)
+    {
+        for (Entry& entry : m_Entries)
+        {
+            if (entry.key && entry.descriptor)
+                retire(entry.descriptor);
+
+            entry = {};
+        }
+
+        m_EntriesNum = 0;
+    }
+
+private:
+    static inline uint32_t Hash(uint64_t key)
+    { return uint32_t((key * 0x9E3779B97F4A7C15ull) >> 32ull); }
+
+    template<class Retire>
+    void Rebuild(size_t entriesMaxNum, uint32_t frameIndex, uint32_t maxAge, Retire retire)
+    {
+        // Nothing to do?
+        bool isEvictionNeeded = false;
+        for (const Entry& entry : m_Entries)
+            isEvictionNeeded |= entry.key && frameIndex - entry.lastUsedFrameIndex >= maxAge;
+
+        if (!isEvictionNeeded && entriesMaxNum == m_Entries.size())
+            return;
+
+        // Evict views not used for "maxAge" frames and reinsert the rest
+        m_EntriesTemp.swap(m_Entries);
+        m_Entries.assign(entriesMaxNum, {});
+        m_EntriesNum = 0;
+
+        uint32_t mask = (uint32_t)entriesMaxNum - 1;
+        for (const Entry& entry : m_EntriesTemp)
+        {
+            if (!entry.key)
+                continue;
+
+            if (frameIndex - entry.lastUsedFrameIndex >= maxAge)
+            {
+                if (entry.descriptor)
+                    retire(entry.descriptor);
+
+                continue;
+            }
+
+            uint32_t i = Hash(entry.key) & mask;
+            while (m_Entries[i].key)
+                i = (i + 1) & mask;
+
+            m_Entries[i] = entry;
+            m_EntriesNum++;
+        }
+    }
+
+private:
+    std::vector<Entry> m_Entries;
+    std::vector<Entry> m_EntriesTemp;
+    uint32_t m_EntriesNum = 0;
+};
+
+}
@@ -20,7 +20,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include <array>
 #include <vector>
-#include <map>
+
+#include "NRDDescriptorCache.h"
 
 #define NRD_INTEGRATION_MAJOR 1
 #define NRD_INTEGRATION_MINOR 13
@@ -40,8 +41,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 namespace nrd
 {
 
-// "TextureBarrierDesc::texture" represents the resource, the rest represents the state
-typedef std::array<nri::TextureBarrierDesc*, (size_t)ResourceType::MAX_NUM - 2> UserPool;
+// "TextureBarrierDesc::texture" represents the resource, the rest represents the state (user resources precede NRD pools)
+typedef std::array<nri::TextureBarrierDesc*, (size_t)ResourceType::TRANSIENT_POOL> UserPool;
 
 // User pool must contain valid entries for resources, which are required for requested denoisers,
 // but the entire pool must be zero-ed during initialization
@@ -65,9 +66,14 @@ struct IntegrationCreationDesc
     // that constant data and descriptor sets are not overwritten while being executed on the GPU
     uint8_t bufferedFramesNum = 2;
 
-    // true - enables descriptor caching for the whole lifetime of an Integration instance
-    // false - descriptors are cached only within a single "Denoise" call
-    bool enableDescriptorCaching = false;
+    // true - descriptors are cached across frames, descriptors not used for "bufferedFramesNum" frames get evicted (views of destroyed or recreated textures don't leak)
+    // false - descriptors are cached only within a single frame
+    bool enableDescriptorCaching = true;
+
+    // true - descriptor sets get baked once per dispatch and ping-pong parity and reused while the user pool doesn't change,
+    // a changed user texture replaces stale sets. Baked sets get rebuilt when a descriptor gets evicted or the baked pool is
+    // exhausted, in the latter case the call falls back to the per-frame pool (requires "enableDescriptorCaching")
+    bool enableDescriptorSetCaching = false;
 
     // Demote FP32 to FP16 (slightly improves performance in exchange of precision loss)
     // (FP32 is used only for viewZ under the hood, all denoisers are FP16 compatible)
@@ -98,8 +104,12 @@ public:
     bool SetCommonSettings(const CommonSettings& commonSettings);
     bool SetDenoiserSettings(Identifier denoiser, const void* denoiserSettings);
 
+    // "Denoise*": nothing gets recorded (an assert in debug) if constants of the call don't fit into the per-frame part of the constant buffer
     void Denoise(const Identifier* denoisers, uint32_t denoisersNum, nri::CommandBuffer& commandBuffer, const UserPool& userPool);
 
+    // Calls "GetComputeDispatchesMultiView" ("SetCommonSettings" is not needed), "userPools" has an entry per view
+    void DenoiseMultiView(const ViewDesc* viewDescs, const UserPool* userPools, uint32_t viewsNum, nri::CommandBuffer& commandBuffer);
+
     // This function assumes that the device is in the IDLE state, i.e. there is no work in flight
     void Destroy();
 
@@ -116,40 +126,92 @@ public:
     inline double GetAliasableMemoryUsageInMb() const
     { return double(m_TransientPoolSize) / (1024.0 * 1024.0); }
 
+    // Constant statistics for the current frame: bytes uploaded and bytes which would be uploaded without reusing identical blocks
+    inline uint32_t GetConstantDataSize() const
+    { return m_ConstantDataSize; }
+
+    inline uint32_t GetConstantDataSizeWithoutReuse() const
+    { return m_ConstantDataSizeWithoutReuse; }
+
+private:
+    static constexpr uint32_t DESCRIPTOR_SETS_MAX_NUM = 3; // constant buffer, samplers and resources spaces (at most)
+
+    // Open addressing hash table entry: baked descriptor sets of a dispatch, two variants at most (ping-pong parities)
+    struct BakedDescriptorSets
+    {
+        uint64_t key; // 0 - empty, see "BakeDescriptorSets"
+        nri::DescriptorSet* descriptorSets[2][DESCRIPTOR_SETS_MAX_NUM];
+        uint32_t descriptorsOffset[2]; // in "m_BakedDescriptors"
+        uint32_t pipelineIndex[2]; // uint32_t(-1) - not baked
+        uint32_t lastUsedVariant;
+    };
+
 private:
     Integration(const Integration&) = delete;
 
     void CreateResources(uint16_t resourceWidth, uint16_t resourceHeight);
     void AllocateAndBindMemory();
-    void Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, const UserPool& userPool);
+    void ValidateUserPool(const UserPool& userPool);
+    void Record(nri::CommandBuffer& commandBuffer, const DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, const UserPool* userPools, uint32_t userPoolsNum);
+    void Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, uint32_t dispatchIndex, const UserPool* userPools, bool useBakedDescriptorSets);
+    void GetDescriptors(const DispatchDesc& dispatchDesc, const UserPool* userPools, nri::Descriptor** descriptors, nri::DescriptorRangeUpdateDesc* resourceRanges);
+    void WriteDescriptorSets(nri::DescriptorPool& descriptorPool, nri::DescriptorSet*& descriptorSetSamplers, uint32_t pipelineIndex, const nri::DescriptorRangeUpdateDesc* resourceRanges, nri::DescriptorSet** descriptorSets);
+    bool BakeDescriptorSets(const DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, const UserPool* userPools);
+    bool BakeDispatchDescriptorSets(uint64_t key, const DispatchDesc& dispatchDesc, const UserPool* userPools, nri::DescriptorSet** descriptorSets);
+    void ResetBakedDescriptorSets();
+    uint32_t GetResourceIndex(const ResourceDesc& nrdResource, uint32_t viewIndex) const;
+    nri::TextureBarrierDesc* GetTexture(uint32_t resourceIndex, const UserPool* userPools);
+    nri::Descriptor* GetCachedDescriptor(nri::Texture& texture, bool isStorage, bool isArray);
+    void RetireDescriptor(nri::Descriptor* descriptor);
 
 private:
     std::vector<nri::TextureBarrierDesc> m_TexturePool;
-    std::map<uint64_t, nri::Descriptor*> m_CachedDescriptors;
-    std::vector<std::vector<nri::Descriptor*>> m_DescriptorsInFlight;
+    std::vector<nri::BufferBarrierDesc> m_BufferPool; // indirect arguments
+    std::vector<nri::Descriptor*> m_BufferViews;
+    DescriptorCache<nri::Texture, nri::Descriptor> m_CachedDescriptors;
+    std::vector<std::vector<nri::Descriptor*>> m_DescriptorsInFlight; // evicted, but can be still referenced by the GPU
     std::vector<nri::PipelineLayout*> m_PipelineLayouts;
     std::vector<nri::Pipeline*> m_Pipelines;
     std::vector<nri::Memory*> m_MemoryAllocations;
     std::vector<nri::Descriptor*> m_Samplers;
     std::vector<nri::DescriptorPool*> m_DescriptorPools = {};
     std::vector<nri::DescriptorSet*> m_DescriptorSetSamplers = {};
+    std::vector<uint32_t> m_ConstantBufferOffsets;
+    std::vector<BakedDescriptorSets> m_BakedDescriptorSets;
+    std::vector<BakedDescriptorSets> m_BakedDescriptorSetsTemp;
+    std::vector<nri::Descriptor*> m_BakedDescriptors;
+    std::vector<nri::DescriptorSet*> m_BakedDispatchDescriptorSets; // "DESCRIPTOR_SETS_MAX_NUM" per dispatch of the current call
+    std::vector<std::pair<Identifier, uint32_t>> m_BakedDispatchOccurrences; // dispatches per denoiser in the current call
+    std::vector<nri::DescriptorPool*> m_BakedDescriptorPoolsInFlight; // retired, but can be still referenced by the GPU
     const nri::CoreInterface* m_NRI = nullptr;
     const nri::HelperInterface* m_NRIHelper = nullptr;
     nri::Device* m_Device = nullptr;
     nri::Buffer* m_ConstantBuffer = nullptr;
     nri::Descriptor* m_ConstantBufferView = nullptr;
+    nri::DescriptorPool* m_BakedDescriptorPool = nullptr;
+    nri::DescriptorSet* m_BakedDescriptorSetSamplers = nullptr;
+    DescriptorPoolDesc m_BakedDescriptorPoolAvailable = {};
     Instance* m_Instance = nullptr;
     uint64_t m_PermanentPoolSize = 0;
     uint64_t m_TransientPoolSize = 0;
     uint64_t m_ConstantBufferSize = 0;
     uint32_t m_ConstantBufferViewSize = 0;
+    uint8_t* m_ConstantBufferData = nullptr; // persistently mapped (not D3D11)
     uint32_t m_ConstantBufferOffset = 0;
+    uint32_t m_ConstantBufferFrameSize = 0;
+    uint32_t m_ConstantBufferAlignment = 0;
+    uint32_t m_ConstantDataSize = 0;
+    uint32_t m_ConstantDataSizeWithoutReuse = 0;
     uint32_t m_DescriptorPoolIndex = 0;
+    uint32_t m_BakedDescriptorSetsNum = 0;
     uint32_t m_FrameIndex = 0;
+    uint32_t m_UserPoolsNum = 0;
     uint8_t m_BufferedFramesNum = 0;
     char m_Name[32] = {};
     bool m_ReloadShaders = false;
     bool m_EnableDescriptorCaching = false;
+    bool m_EnableDescriptorSetCaching = false;
+    bool m_IsBakedDescriptorSetsInvalid = false;
     bool m_DemoteFloat32to16 = false;
     bool m_PromoteFloat16to32 = false;
 };
@@ -77,14 +77,29 @@ static inline uint16_t DivideUp(uint32_t x, uint16_t y)
 static inline nri::Format GetNriFormat(Format format)
 { return g_NrdFormatToNri[(uint32_t)format]; }
 
-static inline uint64_t CreateDescriptorKey(uint64_t texture, bool isStorage)
+static inline uint64_t CreateDescriptorKey(uint64_t texture, bool isStorage, bool isArray)
 {
     uint64_t key = uint64_t(isStorage ? 1 : 0) << 63ull;
-    key |= texture & ((1ull << 63ull) - 1);
+    key |= uint64_t(isArray ? 1 : 0) << 62ull;
+    key |= texture & ((1ull << 62ull) - 1);
 
     return key;
 }
 
+static inline uint32_t HashDescriptorKey(uint64_t key)
+{
+    return uint32_t((key * 0x9E3779B97F4A7C15ull) >> 32ull);
+}
+
+static inline uint32_t GetDescriptorsNum(const PipelineDesc& pipelineDesc)
+{
+    uint32_t descriptorsNum = 0;
+    for (uint32_t i = 0; i < pipelineDesc.resourceRangesNum; i++)
+        descriptorsNum += pipelineDesc.resourceRanges[i].descriptorsNum;
+
+    return descriptorsNum;
+}
+
 template<typename T, typename A> constexpr T GetAlignedSize(const T& size, A alignment)
 {
     return T(((size + alignment - 1) / alignment) * alignment);
@@ -111,11 +126,20 @@ bool Integration::Initialize(const IntegrationCreationDesc& integrationDesc, con
         return false;
     }
 
+    // NRI doesn't expose descriptor heap indices, bindless NRD must be integrated manually
+    if (libraryDesc.isBindless)
+    {
+        NRD_INTEGRATION_ASSERT(false, "Bindless NRD is not supported by the integration!");
+
+        return false;
+    }
+
     if (CreateInstance(instanceDesc, m_Instance) != Result::SUCCESS)
         return false;
 
     m_BufferedFramesNum = integrationDesc.bufferedFramesNum;
     m_EnableDescriptorCaching = integrationDesc.enableDescriptorCaching;
+    m_EnableDescriptorSetCaching = integrationDesc.enableDescriptorSetCaching && integrationDesc.enableDescriptorCaching;
     m_PromoteFloat16to32 = integrationDesc.promoteFloat16to32;
     m_DemoteFloat32to16 = integrationDesc.demoteFloat32to16;
     m_Device = &nriDevice;
@@ -218,7 +242,7 @@ void Integration::CreatePipelines()
             else
             {
                 resourcesRanges[j].baseRegisterIndex = storageTextureAndBufferOffset + nrdResourceRange.baseRegisterIndex;
-                resourcesRanges[j].descriptorType = nri::DescriptorType::STORAGE_TEXTURE;
+                resourcesRanges[j].descriptorType = nrdResourceRange.descriptorType == DescriptorType::STORAGE_BUFFER ? nri::DescriptorType::STORAGE_STRUCTURED_BUFFER : nri::DescriptorType::STORAGE_TEXTURE;
             }
 
             resourcesRanges[j].descriptorNum = nrdResourceRange.descriptorsNum;
@@ -324,6 +348,7 @@ void Integration::CreateResources(uint16_t resourceWidth, uint16_t resourceHeigh
         textureDesc.width = w;
         textureDesc.height = h;
         textureDesc.mipNum = 1;
+        textureDesc.layerNum = std::max(nrdTextureDesc.layersNum, (uint16_t)1);
 
         nri::Texture* texture = nullptr;
         NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateTexture(*m_Device, textureDesc, texture));
@@ -357,6 +382,28 @@ void Integration::CreateResources(uint16_t resourceWidth, uint16_t resourceHeigh
     printf("%s: %.1f Mb (permanent), %.1f Mb (transient)\n\n", m_Name, double(m_PermanentPoolSize) / (1024.0f * 1024.0f), double(m_TransientPoolSize) / (1024.0f * 1024.0f));
 #endif
 
+    // Indirect arguments pool
+    m_BufferPool.resize(instanceDesc.indirectArgumentsPoolSize);
+
+    for (uint32_t i = 0; i < instanceDesc.indirectArgumentsPoolSize; i++)
+    {
+        nri::BufferDesc bufferDesc = {};
+        bufferDesc.size = instanceDesc.indirectArgumentsBufferSize;
+        bufferDesc.structureStride = sizeof(uint32_t);
+        bufferDesc.usage = nri::BufferUsageBits::SHADER_RESOURCE_STORAGE | nri::BufferUsageBits::ARGUMENT_BUFFER;
+
+        nri::Buffer* buffer = nullptr;
+        NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateBuffer(*m_Device, bufferDesc, buffer));
+
+        char name[128];
+        snprintf(name, sizeof(name), "%s::IndirectArgumentsPool%u", m_Name, i);
+        m_NRI->SetBufferDebugName(*buffer, name);
+
+        nri::BufferBarrierDesc& nrdBuffer = m_BufferPool[i];
+        nrdBuffer = {};
+        nrdBuffer.buffer = buffer;
+    }
+
     // Samplers
     for (uint32_t i = 0; i < instanceDesc.samplersNum; i++)
     {
@@ -372,10 +419,12 @@ void Integration::CreateResources(uint16_t resourceWidth, uint16_t resourceHeigh
         m_Samplers.push_back(descriptor);
     }
 
-    // Constant buffer
+    // Constant buffer (a ring of per-frame regions, blocks are packed tightly, but the last view can't overrun the buffer)
     const nri::DeviceDesc& deviceDesc = m_NRI->GetDeviceDesc(*m_Device);
-    m_ConstantBufferViewSize = GetAlignedSize(instanceDesc.constantBufferMaxDataSize, deviceDesc.constantBufferOffsetAlignment);
-    m_ConstantBufferSize = uint64_t(m_ConstantBufferViewSize) * instanceDesc.descriptorPoolDesc.setsMaxNum * m_BufferedFramesNum;
+    m_ConstantBufferAlignment = deviceDesc.constantBufferOffsetAlignment;
+    m_ConstantBufferViewSize = GetAlignedSize(instanceDesc.constantBufferMaxDataSize, m_ConstantBufferAlignment);
+    m_ConstantBufferFrameSize = m_ConstantBufferViewSize * instanceDesc.descriptorPoolDesc.setsMaxNum;
+    m_ConstantBufferSize = uint64_t(m_ConstantBufferFrameSize) * m_BufferedFramesNum + m_ConstantBufferViewSize;
 
     nri::BufferDesc bufferDesc = {};
     bufferDesc.size = m_ConstantBufferSize;
@@ -384,6 +433,22 @@ void Integration::CreateResources(uint16_t resourceWidth, uint16_t resourceHeigh
 
     AllocateAndBindMemory();
 
+    // D3D11 can't write to a mapped buffer used by the GPU
+    if (deviceDesc.graphicsAPI != nri::GraphicsAPI::D3D11)
+        m_ConstantBufferData = (uint8_t*)m_NRI->MapBuffer(*m_ConstantBuffer, 0, m_ConstantBufferSize);
+
+    for (const nri::BufferBarrierDesc& nrdBuffer : m_BufferPool)
+    {
+        nri::BufferViewDesc bufferViewDesc = {};
+        bufferViewDesc.buffer = nrdBuffer.buffer;
+        bufferViewDesc.viewType = nri::BufferViewType::SHADER_RESOURCE_STORAGE;
+        bufferViewDesc.size = instanceDesc.indirectArgumentsBufferSize;
+
+        nri::Descriptor* bufferView = nullptr;
+        NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateBufferView(bufferViewDesc, bufferView));
+        m_BufferViews.push_back(bufferView);
+    }
+
     nri::BufferViewDesc constantBufferViewDesc = {};
     constantBufferViewDesc.viewType = nri::BufferViewType::CONSTANT;
     constantBufferViewDesc.buffer = m_ConstantBuffer;
@@ -394,6 +459,7 @@ void Integration::CreateResources(uint16_t resourceWidth, uint16_t resourceHeigh
     nri::DescriptorPoolDesc descriptorPoolDesc = {};
     descriptorPoolDesc.descriptorSetMaxNum = instanceDesc.descriptorPoolDesc.setsMaxNum;
     descriptorPoolDesc.storageTextureMaxNum = instanceDesc.descriptorPoolDesc.storageTexturesMaxNum;
+    descriptorPoolDesc.storageStructuredBufferMaxNum = instanceDesc.descriptorPoolDesc.storageBuffersMaxNum;
     descriptorPoolDesc.textureMaxNum = instanceDesc.descriptorPoolDesc.texturesMaxNum;
     descriptorPoolDesc.dynamicConstantBufferMaxNum = instanceDesc.descriptorPoolDesc.constantBuffersMaxNum;
     descriptorPoolDesc.samplerMaxNum = instanceDesc.descriptorPoolDesc.samplersMaxNum;
@@ -406,7 +472,11 @@ void Integration::CreateResources(uint16_t resourceWidth, uint16_t resourceHeigh
 
         m_DescriptorSetSamplers.push_back(nullptr);
         m_DescriptorsInFlight.push_back({});
+        m_BakedDescriptorPoolsInFlight.push_back(nullptr);
     }
+
+    if (m_EnableDescriptorSetCaching)
+        ResetBakedDescriptorSets();
 }
 
 void Integration::AllocateAndBindMemory()
@@ -415,10 +485,16 @@ void Integration::AllocateAndBindMemory()
     for (size_t i = 0; i < m_TexturePool.size(); i++)
         textures[i] = m_TexturePool[i].texture;
 
+    std::vector<nri::Buffer*> buffers(m_BufferPool.size(), nullptr);
+    for (size_t i = 0; i < m_BufferPool.size(); i++)
+        buffers[i] = m_BufferPool[i].buffer;
+
     nri::ResourceGroupDesc resourceGroupDesc = {};
     resourceGroupDesc.memoryLocation = nri::MemoryLocation::DEVICE;
     resourceGroupDesc.textureNum = (uint32_t)textures.size();
     resourceGroupDesc.textures = textures.data();
+    resourceGroupDesc.bufferNum = (uint32_t)buffers.size();
+    resourceGroupDesc.buffers = buffers.data();
 
     size_t baseAllocation = m_MemoryAllocations.size();
     const size_t allocationNum = m_NRIHelper->CalculateAllocationNumber(*m_Device, resourceGroupDesc);
@@ -450,14 +526,30 @@ void Integration::NewFrame()
     // Needs to be reset because the corresponding descriptor pool has been just reset
     m_DescriptorSetSamplers[m_DescriptorPoolIndex] = nullptr;
 
+    // The region of the frame which used the same descriptor pool is not referenced by the GPU anymore
+    m_ConstantBufferOffset = m_ConstantBufferFrameSize * m_DescriptorPoolIndex;
+    m_ConstantDataSize = 0;
+    m_ConstantDataSizeWithoutReuse = 0;
+
     // Referenced by the GPU descriptors can't be destroyed...
-    if (!m_EnableDescriptorCaching)
+    for (const auto& entry : m_DescriptorsInFlight[m_DescriptorPoolIndex])
+        m_NRI->DestroyDescriptor(*entry);
+    m_DescriptorsInFlight[m_DescriptorPoolIndex].clear();
+
+    // ... so descriptors evicted now get destroyed when the current descriptor pool gets reset next time
+    m_CachedDescriptors.Evict(m_FrameIndex, m_EnableDescriptorCaching ? m_BufferedFramesNum : 0, [this](nri::Descriptor* descriptor) { RetireDescriptor(descriptor); });
+
+    // Baked descriptor sets referencing evicted descriptors must not be used anymore
+    nri::DescriptorPool*& bakedDescriptorPool = m_BakedDescriptorPoolsInFlight[m_DescriptorPoolIndex];
+    if (bakedDescriptorPool)
     {
-        for (const auto& entry : m_DescriptorsInFlight[m_DescriptorPoolIndex])
-            m_NRI->DestroyDescriptor(*entry);
-        m_DescriptorsInFlight[m_DescriptorPoolIndex].clear();
+        m_NRI->DestroyDescriptorPool(*bakedDescriptorPool);
+        bakedDescriptorPool = nullptr;
     }
 
+    if (m_EnableDescriptorSetCaching && m_IsBakedDescriptorSetsInvalid)
+        ResetBakedDescriptorSets();
+
     m_FrameIndex++;
 }
 
@@ -487,43 +579,105 @@ void Integration::Denoise(const Identifier* denoisers, uint32_t denoisersNum, nr
 
     // One time sanity check
     if (m_FrameIndex == 0)
-    {
-        const nri::Texture* normalRoughnessTexture = userPool[(size_t)ResourceType::IN_NORMAL_ROUGHNESS]->texture;
-        const nri::TextureDesc& normalRoughnessDesc = m_NRI->GetTextureDesc(*normalRoughnessTexture);
-        const LibraryDesc& nrdLibraryDesc = GetLibraryDesc();
-        
-        bool isNormalRoughnessFormatValid = false;
-        switch(nrdLibraryDesc.normalEncoding)
-        {
-            case NormalEncoding::RGBA8_UNORM:
-                isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA8_UNORM;
-                break;
-            case NormalEncoding::RGBA8_SNORM:
-                isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA8_SNORM;
-                break;
-            case NormalEncoding::R10_G10_B10_A2_UNORM:
-                isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::R10_G10_B10_A2_UNORM;
-                break;
-            case NormalEncoding::RGBA16_UNORM:
-                isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA16_UNORM;
-                break;
-            case NormalEncoding::RGBA16_SNORM:
-                isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA16_SNORM || normalRoughnessDesc.format == nri::Format::RGBA16_SFLOAT || normalRoughnessDesc.format == nri::Format::RGBA32_SFLOAT;
-                break;
-        }
+        ValidateUserPool(userPool);
 
-        NRD_INTEGRATION_ASSERT(isNormalRoughnessFormatValid, "IN_NORMAL_ROUGHNESS format doesn't match NRD normal encoding");
+    const DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+    GetComputeDispatches(*m_Instance, denoisers, denoisersNum, dispatchDescs, dispatchDescsNum);
+
+    Record(commandBuffer, dispatchDescs, dispatchDescsNum, &userPool, 1);
+}
+
+void Integration::DenoiseMultiView(const ViewDesc* viewDescs, const UserPool* userPools, uint32_t viewsNum, nri::CommandBuffer& commandBuffer)
+{
+    NRD_INTEGRATION_ASSERT(m_Instance, "Uninitialized! Did you forget to call 'Initialize'?");
+
+    // One time sanity check
+    if (m_FrameIndex == 0)
+    {
+        for (uint32_t i = 0; i < viewsNum; i++)
+            ValidateUserPool(userPools[i]);
     }
 
     const DispatchDesc* dispatchDescs = nullptr;
     uint32_t dispatchDescsNum = 0;
-    GetComputeDispatches(*m_Instance, denoisers, denoisersNum, dispatchDescs, dispatchDescsNum);
+    GetComputeDispatchesMultiView(*m_Instance, viewDescs, viewsNum, dispatchDescs, dispatchDescsNum);
 
-    // Even if descriptor caching is disabled it's better to cache descriptors inside a single "Denoise" call
-    if (!m_EnableDescriptorCaching)
-        m_CachedDescriptors.clear();
+    Record(commandBuffer, dispatchDescs, dispatchDescsNum, userPools, viewsNum);
+}
 
-    nri::DescriptorPool* descriptorPool = m_DescriptorPools[m_DescriptorPoolIndex];
+void Integration::ValidateUserPool(const UserPool& userPool)
+{
+    const nri::Texture* normalRoughnessTexture = userPool[(size_t)ResourceType::IN_NORMAL_ROUGHNESS]->texture;
+    const nri::TextureDesc& normalRoughnessDesc = m_NRI->GetTextureDesc(*normalRoughnessTexture);
+    const LibraryDesc& nrdLibraryDesc = GetLibraryDesc();
+
+    bool isNormalRoughnessFormatValid = false;
+    switch(nrdLibraryDesc.normalEncoding)
+    {
+        case NormalEncoding::RGBA8_UNORM:
+            isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA8_UNORM;
+            break;
+        case NormalEncoding::RGBA8_SNORM:
+            isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA8_SNORM;
+            break;
+        case NormalEncoding::R10_G10_B10_A2_UNORM:
+            isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::R10_G10_B10_A2_UNORM;
+            break;
+        case NormalEncoding::RGBA16_UNORM:
+            isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA16_UNORM;
+            break;
+        case NormalEncoding::RGBA16_SNORM:
+            isNormalRoughnessFormatValid = normalRoughnessDesc.format == nri::Format::RGBA16_SNORM || normalRoughnessDesc.format == nri::Format::RGBA16_SFLOAT || normalRoughnessDesc.format == nri::Format::RGBA32_SFLOAT;
+            break;
+    }
+
+    NRD_INTEGRATION_ASSERT(isNormalRoughnessFormatValid, "IN_NORMAL_ROUGHNESS format doesn't match NRD normal encoding");
+}
+
+void Integration::Record(nri::CommandBuffer& commandBuffer, const DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, const UserPool* userPools, uint32_t userPoolsNum)
+{
+    m_UserPoolsNum = userPoolsNum;
+
+    // Each unique constant block gets uploaded only once. Constants of the whole call must fit into the current frame part of the
+    // constant buffer, otherwise the call gets skipped (rewinding would overwrite constants of earlier dispatches)
+    m_ConstantBufferOffsets.assign(dispatchDescsNum, uint32_t(-1));
+
+    uint32_t constantBufferSize = 0;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const DispatchDesc& dispatchDesc = dispatchDescs[i];
+
+        // Permutations of disabled features have no pipeline (NRD never returns them, the call gets skipped if it happens)
+        bool isPipelineUnused = dispatchDesc.pipelineIndex == UNUSED_PIPELINE_INDEX;
+        NRD_INTEGRATION_ASSERT(!isPipelineUnused, "A dispatch of a disabled feature! Check 'DenoiserDesc::disabledFeatures'");
+        if (isPipelineUnused)
+            return;
+
+        uint32_t constantDataSize = dispatchDesc.sharedConstantBufferDataSize + dispatchDesc.constantBufferDataSize;
+        uint32_t& constantBufferOffset = m_ConstantBufferOffsets[dispatchDesc.constantBufferIndex];
+        if (constantDataSize && constantBufferOffset == uint32_t(-1))
+        {
+            constantBufferOffset = 0;
+            constantBufferSize += GetAlignedSize(constantDataSize, m_ConstantBufferAlignment);
+        }
+    }
+
+    uint32_t frameEnd = m_ConstantBufferFrameSize * (m_DescriptorPoolIndex + 1);
+    bool isConstantBufferOverflow = m_ConstantBufferOffset + constantBufferSize > frameEnd;
+    NRD_INTEGRATION_ASSERT(!isConstantBufferOverflow, "Constant buffer overflow! Did you forget to call 'NewFrame'?");
+    if (isConstantBufferOverflow)
+        return;
+
+    m_ConstantBufferOffsets.assign(dispatchDescsNum, uint32_t(-1));
+
+    // Baked descriptor sets live in their own pool, which must be the bound one (a descriptor heap in D3D12), i.e. either all dispatches use
+    // baked sets or none. If baking fails (the pool is exhausted), the whole call uses the per-frame pool and baked sets get rebuilt next frame
+    bool useBakedDescriptorSets = m_EnableDescriptorSetCaching && BakeDescriptorSets(dispatchDescs, dispatchDescsNum, userPools);
+    if (m_EnableDescriptorSetCaching && !useBakedDescriptorSets)
+        m_IsBakedDescriptorSetsInvalid = true;
+
+    nri::DescriptorPool* descriptorPool = useBakedDescriptorSets ? m_BakedDescriptorPool : m_DescriptorPools[m_DescriptorPoolIndex];
     m_NRI->CmdSetDescriptorPool(commandBuffer, *descriptorPool);
 
     for (uint32_t i = 0; i < dispatchDescsNum; i++)
@@ -531,124 +685,239 @@ void Integration::Denoise(const Identifier* denoisers, uint32_t denoisersNum, nr
         const DispatchDesc& dispatchDesc = dispatchDescs[i];
         m_NRI->CmdBeginAnnotation(commandBuffer, dispatchDesc.name);
 
-        Dispatch(commandBuffer, *descriptorPool, dispatchDesc, userPool);
+        Dispatch(commandBuffer, *descriptorPool, dispatchDesc, i, userPools, useBakedDescriptorSets);
 
         m_NRI->CmdEndAnnotation(commandBuffer);
     }
 }
 
-void Integration::Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, const UserPool& userPool)
+void Integration::Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPool& descriptorPool, const DispatchDesc& dispatchDesc, uint32_t dispatchIndex, const UserPool* userPools, bool useBakedDescriptorSets)
 {
     const InstanceDesc& instanceDesc = GetInstanceDesc(*m_Instance);
-    const PipelineDesc& pipelineDesc = instanceDesc.pipelines[dispatchDesc.pipelineIndex];
 
-    nri::Descriptor** descriptors = (nri::Descriptor**)alloca(sizeof(nri::Descriptor*) * dispatchDesc.resourcesNum);
-    memset(descriptors, 0, sizeof(nri::Descriptor*) * dispatchDesc.resourcesNum);
+    nri::TextureBarrierDesc* transitions = (nri::TextureBarrierDesc*)alloca(sizeof(nri::TextureBarrierDesc) * dispatchDesc.barriersNum);
+    memset(transitions, 0, sizeof(nri::TextureBarrierDesc) * dispatchDesc.barriersNum);
 
-    nri::DescriptorRangeUpdateDesc* resourceRanges = (nri::DescriptorRangeUpdateDesc*)alloca(sizeof(nri::DescriptorRangeUpdateDesc) * pipelineDesc.resourceRangesNum);
-    memset(resourceRanges, 0, sizeof(nri::DescriptorRangeUpdateDesc) * pipelineDesc.resourceRangesNum);
-
-    nri::TextureBarrierDesc* transitions = (nri::TextureBarrierDesc*)alloca(sizeof(nri::TextureBarrierDesc) * dispatchDesc.resourcesNum);
-    memset(transitions, 0, sizeof(nri::TextureBarrierDesc) * dispatchDesc.resourcesNum);
+    nri::BufferBarrierDesc* bufferTransitions = (nri::BufferBarrierDesc*)alloca(sizeof(nri::BufferBarrierDesc) * dispatchDesc.barriersNum);
+    memset(bufferTransitions, 0, sizeof(nri::BufferBarrierDesc) * dispatchDesc.barriersNum);
 
     nri::BarrierGroupDesc transitionBarriers = {};
     transitionBarriers.textures = transitions;
+    transitionBarriers.buffers = bufferTransitions;
 
-    uint32_t n = 0;
-    for (uint32_t i = 0; i < pipelineDesc.resourceRangesNum; i++)
+    // Barriers (precomputed by NRD)
+    for (uint32_t i = 0; i < dispatchDesc.barriersNum; i++)
     {
-        const ResourceRangeDesc& resourceRange = pipelineDesc.resourceRanges[i];
-        const bool isStorage = resourceRange.descriptorType == DescriptorType::STORAGE_TEXTURE;
-
-        resourceRanges[i].descriptors = descriptors + n;
-        resourceRanges[i].descriptorNum = resourceRange.descriptorsNum;
+        const BarrierDesc& barrierDesc = dispatchDesc.barriers[i];
+        uint32_t resourceIndex = GetResourceIndex(dispatchDesc.resources[barrierDesc.resourceIndex], dispatchDesc.viewIndex);
 
-        for (uint32_t j = 0; j < resourceRange.descriptorsNum; j++)
+        // Indirect arguments
+        uint32_t bufferIndex = resourceIndex - (uint32_t)m_TexturePool.size();
+        if (bufferIndex < m_BufferPool.size())
         {
-            const ResourceDesc& nrdResource = dispatchDesc.resources[n];
+            nri::BufferBarrierDesc& nrdBuffer = m_BufferPool[bufferIndex];
 
-            nri::TextureBarrierDesc* nrdTexture = nullptr;
-            if (nrdResource.type == ResourceType::TRANSIENT_POOL)
-                nrdTexture = &m_TexturePool[nrdResource.indexInPool + instanceDesc.permanentPoolSize];
-            else if (nrdResource.type == ResourceType::PERMANENT_POOL)
-                nrdTexture = &m_TexturePool[nrdResource.indexInPool];
-            else
+            nri::AccessStage next = {nri::AccessBits::SHADER_RESOURCE_STORAGE, nri::StageBits::COMPUTE_SHADER};
+            if (barrierDesc.after == DescriptorType::INDIRECT_ARGUMENTS)
+                next = {nri::AccessBits::ARGUMENT_BUFFER, nri::StageBits::INDIRECT};
+
+            if (barrierDesc.before == DescriptorType::MAX_NUM)
             {
-                nrdTexture = userPool[(uint32_t)nrdResource.type];
-                NRD_INTEGRATION_ASSERT(nrdTexture && nrdTexture->texture, "'userPool' entry can't be NULL if it's in use!");
+                bool isStateChanged = next.access != nrdBuffer.after.access;
+                bool isStorageBarrier = next.access == nri::AccessBits::SHADER_RESOURCE_STORAGE && nrdBuffer.after.access == nri::AccessBits::SHADER_RESOURCE_STORAGE;
+                if (!isStateChanged && !isStorageBarrier)
+                    continue;
             }
 
-            const nri::AccessBits nextAccess = nrdResource.descriptorType == DescriptorType::TEXTURE ? nri::AccessBits::SHADER_RESOURCE : nri::AccessBits::SHADER_RESOURCE_STORAGE;
-            const nri::Layout nextLayout =  nrdResource.descriptorType == DescriptorType::TEXTURE ? nri::Layout::SHADER_RESOURCE : nri::Layout::SHADER_RESOURCE_STORAGE;
+            nrdBuffer.before = nrdBuffer.after;
+            nrdBuffer.after = next;
+            bufferTransitions[transitionBarriers.bufferNum++] = nrdBuffer;
+
+            continue;
+        }
+
+        nri::TextureBarrierDesc* nrdTexture = GetTexture(resourceIndex, userPools);
+
+        const nri::AccessBits nextAccess = barrierDesc.after == DescriptorType::TEXTURE ? nri::AccessBits::SHADER_RESOURCE : nri::AccessBits::SHADER_RESOURCE_STORAGE;
+        const nri::Layout nextLayout = barrierDesc.after == DescriptorType::TEXTURE ? nri::Layout::SHADER_RESOURCE : nri::Layout::SHADER_RESOURCE_STORAGE;
+
+        // The first access - the current state is known only here
+        if (barrierDesc.before == DescriptorType::MAX_NUM)
+        {
             bool isStateChanged = nextAccess != nrdTexture->after.access || nextLayout != nrdTexture->after.layout;
             bool isStorageBarrier = nextAccess == nri::AccessBits::SHADER_RESOURCE_STORAGE && nrdTexture->after.access == nri::AccessBits::SHADER_RESOURCE_STORAGE;
-            if (isStateChanged || isStorageBarrier)
-                transitions[transitionBarriers.textureNum++] = nri::TextureBarrierFromState(*nrdTexture, {nextAccess, nextLayout}, 0, 1);
+            if (!isStateChanged && !isStorageBarrier)
+                continue;
+        }
 
-            uint64_t resource = m_NRI->GetTextureNativeObject(*nrdTexture->texture);
-            uint64_t key = CreateDescriptorKey(resource, isStorage);
-            const auto& entry = m_CachedDescriptors.find(key);
+        transitions[transitionBarriers.textureNum++] = nri::TextureBarrierFromState(*nrdTexture, {nextAccess, nextLayout}, 0, 1);
+    }
 
-            nri::Descriptor* descriptor = nullptr;
-            if (entry == m_CachedDescriptors.end())
+    // Uploading constants (shared constants followed by pass specific constants)
+    uint32_t dynamicConstantBufferOffset = 0;
+    uint32_t constantDataSize = dispatchDesc.sharedConstantBufferDataSize + dispatchDesc.constantBufferDataSize;
+    if (constantDataSize)
+    {
+        // Identical blocks get uploaded only once
+        uint32_t& constantBufferOffset = m_ConstantBufferOffsets[dispatchDesc.constantBufferIndex];
+        if (constantBufferOffset == uint32_t(-1))
+        {
+            uint8_t* data = m_ConstantBufferData ? m_ConstantBufferData + m_ConstantBufferOffset : (uint8_t*)m_NRI->MapBuffer(*m_ConstantBuffer, m_ConstantBufferOffset, constantDataSize);
+            if (data)
             {
-                const nri::TextureDesc& textureDesc = m_NRI->GetTextureDesc(*nrdTexture->texture);
-
-                nri::Texture2DViewDesc desc = {nrdTexture->texture, isStorage ? nri::Texture2DViewType::SHADER_RESOURCE_STORAGE_2D : nri::Texture2DViewType::SHADER_RESOURCE_2D, textureDesc.format, 0, 1};
-                NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateTexture2DView(desc, descriptor));
-
-                m_CachedDescriptors.insert( std::make_pair(key, descriptor) );
-                m_DescriptorsInFlight[m_DescriptorPoolIndex].push_back(descriptor);
+                if (dispatchDesc.sharedConstantBufferDataSize)
+                    memcpy(data, dispatchDesc.sharedConstantBufferData, dispatchDesc.sharedConstantBufferDataSize);
+                if (dispatchDesc.constantBufferDataSize)
+                    memcpy(data + dispatchDesc.sharedConstantBufferDataSize, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
             }
-            else
-                descriptor = entry->second;
 
-            descriptors[n++] = descriptor;
+            if (!m_ConstantBufferData)
+                m_NRI->UnmapBuffer(*m_ConstantBuffer);
+
+            constantBufferOffset = m_ConstantBufferOffset;
+            m_ConstantBufferOffset += GetAlignedSize(constantDataSize, m_ConstantBufferAlignment);
+            m_ConstantDataSize += constantDataSize;
         }
+
+        m_ConstantDataSizeWithoutReuse += constantDataSize;
+
+        dynamicConstantBufferOffset = constantBufferOffset;
     }
 
-    // Allocating descriptor sets
+    // Descriptor sets (baked or allocated from the per-frame pool)
     uint32_t descriptorSetSamplersIndex = instanceDesc.constantBufferSpaceIndex == instanceDesc.samplersSpaceIndex ? 0 : 1;
     uint32_t descriptorSetResourcesIndex = instanceDesc.resourcesSpaceIndex == instanceDesc.constantBufferSpaceIndex ? 0 : (instanceDesc.resourcesSpaceIndex == instanceDesc.samplersSpaceIndex ? descriptorSetSamplersIndex : descriptorSetSamplersIndex + 1);
     uint32_t descriptorSetNum = std::max(descriptorSetSamplersIndex, descriptorSetResourcesIndex) + 1;
-    bool samplersAreInSeparateSet = instanceDesc.samplersSpaceIndex != instanceDesc.constantBufferSpaceIndex && instanceDesc.samplersSpaceIndex != instanceDesc.resourcesSpaceIndex;
 
     nri::DescriptorSet** descriptorSets = (nri::DescriptorSet**)alloca(sizeof(nri::DescriptorSet*) * descriptorSetNum);
     nri::PipelineLayout* pipelineLayout = m_PipelineLayouts[dispatchDesc.pipelineIndex];
 
+    if (useBakedDescriptorSets)
+        memcpy(descriptorSets, &m_BakedDispatchDescriptorSets[dispatchIndex * DESCRIPTOR_SETS_MAX_NUM], sizeof(nri::DescriptorSet*) * descriptorSetNum);
+    else
+    {
+        const PipelineDesc& pipelineDesc = instanceDesc.pipelines[dispatchDesc.pipelineIndex];
+        uint32_t descriptorsNum = GetDescriptorsNum(pipelineDesc);
+
+        nri::Descriptor** descriptors = (nri::Descriptor**)alloca(sizeof(nri::Descriptor*) * descriptorsNum);
+        nri::DescriptorRangeUpdateDesc* resourceRanges = (nri::DescriptorRangeUpdateDesc*)alloca(sizeof(nri::DescriptorRangeUpdateDesc) * pipelineDesc.resourceRangesNum);
+        GetDescriptors(dispatchDesc, userPools, descriptors, resourceRanges);
+
+        WriteDescriptorSets(descriptorPool, m_DescriptorSetSamplers[m_DescriptorPoolIndex], dispatchDesc.pipelineIndex, resourceRanges, descriptorSets);
+    }
+
+    // Rendering
+    if (transitionBarriers.textureNum || transitionBarriers.bufferNum)
+        m_NRI->CmdBarrier(commandBuffer, transitionBarriers);
+
+    m_NRI->CmdSetPipelineLayout(commandBuffer, *pipelineLayout);
+
+    nri::Pipeline* pipeline = m_Pipelines[dispatchDesc.pipelineIndex];
+    m_NRI->CmdSetPipeline(commandBuffer, *pipeline);
+
     for (uint32_t i = 0; i < descriptorSetNum; i++)
+        m_NRI->CmdSetDescriptorSet(commandBuffer, i, *descriptorSets[i], i == 0 ? &dynamicConstantBufferOffset : nullptr);
+
+    if (dispatchDesc.isIndirect)
     {
-        if (!samplersAreInSeparateSet || i != descriptorSetSamplersIndex)
-            NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->AllocateDescriptorSets(descriptorPool, *pipelineLayout, i, &descriptorSets[i], 1, 0));
+        const ResourceDesc& indirectArguments = dispatchDesc.resources[dispatchDesc.resourcesNum - 1];
+        m_NRI->CmdDispatchIndirect(commandBuffer, *m_BufferPool[indirectArguments.indexInPool].buffer, 0);
     }
+    else
+        m_NRI->CmdDispatch(commandBuffer, {dispatchDesc.gridWidth, dispatchDesc.gridHeight, dispatchDesc.gridDepth});
 
-    // Updating constants
-    uint32_t dynamicConstantBufferOffset = 0;
-    if (dispatchDesc.constantBufferDataSize)
+    // Debug logging
+    #if( NRD_INTEGRATION_DEBUG_LOGGING == 1 )
+        printf("Pipeline #%u : %s\n\t", dispatchDesc.pipelineIndex, dispatchDesc.name);
+        for( uint32_t i = 0; i < dispatchDesc.resourcesNum; i++ )
+        {
+            const ResourceDesc& r = dispatchDesc.resources[i];
+
+            if( r.type == ResourceType::PERMANENT_POOL )
+                printf("P(%u) ", r.indexInPool);
+            else if( r.type == ResourceType::TRANSIENT_POOL )
+                printf("T(%u) ", r.indexInPool);
+            else if( r.type == ResourceType::INDIRECT_ARGUMENTS_POOL )
+                printf("I(%u) ", r.indexInPool);
+            else
+            {
+                const char* s = GetResourceTypeString(r.type);
+                printf("%s ", s);
+            }
+        }
+        printf("\n\n");
+    #endif
+}
+
+void Integration::GetDescriptors(const DispatchDesc& dispatchDesc, const UserPool* userPools, nri::Descriptor** descriptors, nri::DescriptorRangeUpdateDesc* resourceRanges)
+{
+    const InstanceDesc& instanceDesc = GetInstanceDesc(*m_Instance);
+    const PipelineDesc& pipelineDesc = instanceDesc.pipelines[dispatchDesc.pipelineIndex];
+
+    memset(descriptors, 0, sizeof(nri::Descriptor*) * GetDescriptorsNum(pipelineDesc));
+    memset(resourceRanges, 0, sizeof(nri::DescriptorRangeUpdateDesc) * pipelineDesc.resourceRangesNum);
+
+    uint32_t n = 0;
+    uint32_t d = 0;
+    for (uint32_t i = 0; i < pipelineDesc.resourceRangesNum; i++)
     {
-        if (!dispatchDesc.constantBufferDataMatchesPreviousDispatch)
+        const ResourceRangeDesc& resourceRange = pipelineDesc.resourceRanges[i];
+        const bool isStorage = resourceRange.descriptorType == DescriptorType::STORAGE_TEXTURE;
+
+        resourceRanges[i].descriptors = descriptors + d;
+        resourceRanges[i].descriptorNum = resourceRange.descriptorsNum;
+
+        for (uint32_t j = 0; j < resourceRange.descriptorsNum; j++)
         {
-            if (m_ConstantBufferOffset + m_ConstantBufferViewSize > m_ConstantBufferSize)
-                m_ConstantBufferOffset = 0;
+            // Slots not covered by "resources" (partially filled clear batches) are not accessed, but need a valid descriptor
+            if (n == dispatchDesc.resourcesNum)
+            {
+                NRD_INTEGRATION_ASSERT(j != 0, "A resource range is not covered by resources!");
+                descriptors[d++] = resourceRanges[i].descriptors[0];
+                continue;
+            }
 
-            // TODO: persistent mapping? But no D3D11 support...
-            void* data = m_NRI->MapBuffer(*m_ConstantBuffer, m_ConstantBufferOffset, dispatchDesc.constantBufferDataSize);
-            if (data)
-                memcpy(data, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
-            m_NRI->UnmapBuffer(*m_ConstantBuffer);
+            const ResourceDesc& nrdResource = dispatchDesc.resources[n++];
+            if (resourceRange.descriptorType == DescriptorType::STORAGE_BUFFER)
+            {
+                descriptors[d++] = m_BufferViews[nrdResource.indexInPool];
+                continue;
+            }
+
+            nri::TextureBarrierDesc* nrdTexture = GetTexture(GetResourceIndex(nrdResource, dispatchDesc.viewIndex), userPools);
+
+            descriptors[d++] = GetCachedDescriptor(*nrdTexture->texture, isStorage, nrdResource.isArray);
         }
+    }
+}
 
-        m_NRI->UpdateDynamicConstantBuffers(*descriptorSets[0], 0, 1, &m_ConstantBufferView);
+void Integration::WriteDescriptorSets(nri::DescriptorPool& descriptorPool, nri::DescriptorSet*& descriptorSetSamplers, uint32_t pipelineIndex, const nri::DescriptorRangeUpdateDesc* resourceRanges, nri::DescriptorSet** descriptorSets)
+{
+    const InstanceDesc& instanceDesc = GetInstanceDesc(*m_Instance);
+    const PipelineDesc& pipelineDesc = instanceDesc.pipelines[pipelineIndex];
 
-        dynamicConstantBufferOffset = m_ConstantBufferOffset;
-        m_ConstantBufferOffset += m_ConstantBufferViewSize;
+    // Allocating descriptor sets
+    uint32_t descriptorSetSamplersIndex = instanceDesc.constantBufferSpaceIndex == instanceDesc.samplersSpaceIndex ? 0 : 1;
+    uint32_t descriptorSetResourcesIndex = instanceDesc.resourcesSpaceIndex == instanceDesc.constantBufferSpaceIndex ? 0 : (instanceDesc.resourcesSpaceIndex == instanceDesc.samplersSpaceIndex ? descriptorSetSamplersIndex : descriptorSetSamplersIndex + 1);
+    uint32_t descriptorSetNum = std::max(descriptorSetSamplersIndex, descriptorSetResourcesIndex) + 1;
+    bool samplersAreInSeparateSet = instanceDesc.samplersSpaceIndex != instanceDesc.constantBufferSpaceIndex && instanceDesc.samplersSpaceIndex != instanceDesc.resourcesSpaceIndex;
+
+    nri::PipelineLayout* pipelineLayout = m_PipelineLayouts[pipelineIndex];
+
+    for (uint32_t i = 0; i < descriptorSetNum; i++)
+    {
+        if (!samplersAreInSeparateSet || i != descriptorSetSamplersIndex)
+            NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->AllocateDescriptorSets(descriptorPool, *pipelineLayout, i, &descriptorSets[i], 1, 0));
     }
 
+    // Updating constants
+    if (pipelineDesc.hasConstantData)
+        m_NRI->UpdateDynamicConstantBuffers(*descriptorSets[0], 0, 1, &m_ConstantBufferView);
+
     // Updating samplers
     const nri::DescriptorRangeUpdateDesc samplersDescriptorRange = {m_Samplers.data(), instanceDesc.samplersNum, 0};
     if (samplersAreInSeparateSet)
     {
-        nri::DescriptorSet*& descriptorSetSamplers = m_DescriptorSetSamplers[m_DescriptorPoolIndex];
         if (!descriptorSetSamplers)
         {
             NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->AllocateDescriptorSets(descriptorPool, *pipelineLayout, descriptorSetSamplersIndex, &descriptorSetSamplers, 1, 0));
@@ -662,44 +931,243 @@ void Integration::Dispatch(nri::CommandBuffer& commandBuffer, nri::DescriptorPoo
 
     // Updating resources
     m_NRI->UpdateDescriptorRanges(*descriptorSets[descriptorSetResourcesIndex], instanceDesc.samplersSpaceIndex == instanceDesc.resourcesSpaceIndex ? 1 : 0, pipelineDesc.resourceRangesNum, resourceRanges);
+}
 
-    // Rendering
-    m_NRI->CmdBarrier(commandBuffer, transitionBarriers);
-    m_NRI->CmdSetPipelineLayout(commandBuffer, *pipelineLayout);
+bool Integration::BakeDescriptorSets(const DispatchDesc* dispatchDescs, uint32_t dispatchDescsNum, const UserPool* userPools)
+{
+    m_BakedDispatchDescriptorSets.resize(dispatchDescsNum * DESCRIPTOR_SETS_MAX_NUM);
+    m_BakedDispatchOccurrences.clear();
 
-    nri::Pipeline* pipeline = m_Pipelines[dispatchDesc.pipelineIndex];
-    m_NRI->CmdSetPipeline(commandBuffer, *pipeline);
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const DispatchDesc& dispatchDesc = dispatchDescs[i];
 
-    for (uint32_t i = 0; i < descriptorSetNum; i++)
-        m_NRI->CmdSetDescriptorSet(commandBuffer, i, *descriptorSets[i], i == 0 ? &dynamicConstantBufferOffset : nullptr);
+        // A dispatch is identified by its denoiser and its order among dispatches of the denoiser (stable from call to call)
+        uint32_t j = 0;
+        while (j < m_BakedDispatchOccurrences.size() && m_BakedDispatchOccurrences[j].first != dispatchDesc.identifier)
+            j++;
 
-    m_NRI->CmdDispatch(commandBuffer, {dispatchDesc.gridWidth, dispatchDesc.gridHeight, 1});
+        if (j == m_BakedDispatchOccurrences.size())
+            m_BakedDispatchOccurrences.push_back({dispatchDesc.identifier, 0});
 
-    // Debug logging
-    #if( NRD_INTEGRATION_DEBUG_LOGGING == 1 )
-        printf("Pipeline #%u : %s\n\t", dispatchDesc.pipelineIndex, dispatchDesc.name);
-        for( uint32_t i = 0; i < dispatchDesc.resourcesNum; i++ )
+        uint64_t key = (((uint64_t)dispatchDesc.identifier << 32ull) | m_BakedDispatchOccurrences[j].second++) + 1;
+        if (!BakeDispatchDescriptorSets(key, dispatchDesc, userPools, &m_BakedDispatchDescriptorSets[i * DESCRIPTOR_SETS_MAX_NUM]))
+            return false;
+    }
+
+    return true;
+}
+
+bool Integration::BakeDispatchDescriptorSets(uint64_t key, const DispatchDesc& dispatchDesc, const UserPool* userPools, nri::DescriptorSet** descriptorSets)
+{
+    const InstanceDesc& instanceDesc = GetInstanceDesc(*m_Instance);
+    const uint32_t pipelineIndex = dispatchDesc.pipelineIndex;
+    const PipelineDesc& pipelineDesc = instanceDesc.pipelines[pipelineIndex];
+
+    uint32_t descriptorSetSamplersIndex = instanceDesc.constantBufferSpaceIndex == instanceDesc.samplersSpaceIndex ? 0 : 1;
+    uint32_t descriptorSetResourcesIndex = instanceDesc.resourcesSpaceIndex == instanceDesc.constantBufferSpaceIndex ? 0 : (instanceDesc.resourcesSpaceIndex == instanceDesc.samplersSpaceIndex ? descriptorSetSamplersIndex : descriptorSetSamplersIndex + 1);
+    uint32_t descriptorSetNum = std::max(descriptorSetSamplersIndex, descriptorSetResourcesIndex) + 1;
+    bool samplersAreInSeparateSet = instanceDesc.samplersSpaceIndex != instanceDesc.constantBufferSpaceIndex && instanceDesc.samplersSpaceIndex != instanceDesc.resourcesSpaceIndex;
+
+    uint32_t descriptorsNum = GetDescriptorsNum(pipelineDesc);
+    nri::Descriptor** descriptors = (nri::Descriptor**)alloca(sizeof(nri::Descriptor*) * descriptorsNum);
+    nri::DescriptorRangeUpdateDesc* resourceRanges = (nri::DescriptorRangeUpdateDesc*)alloca(sizeof(nri::DescriptorRangeUpdateDesc) * pipelineDesc.resourceRangesNum);
+    GetDescriptors(dispatchDesc, userPools, descriptors, resourceRanges);
+
+    // Keep load factor <= 0.5
+    if ((m_BakedDescriptorSetsNum + 1) * 2 > m_BakedDescriptorSets.size())
+    {
+        m_BakedDescriptorSetsTemp.swap(m_BakedDescriptorSets);
+        m_BakedDescriptorSets.assign(m_BakedDescriptorSetsTemp.size() * 2, {});
+
+        uint32_t mask = (uint32_t)m_BakedDescriptorSets.size() - 1;
+        for (const BakedDescriptorSets& entry : m_BakedDescriptorSetsTemp)
         {
-            const ResourceDesc& r = dispatchDesc.resources[i];
+            if (!entry.key)
+                continue;
 
-            if( r.type == ResourceType::PERMANENT_POOL )
-                printf("P(%u) ", r.indexInPool);
-            else if( r.type == ResourceType::TRANSIENT_POOL )
-                printf("T(%u) ", r.indexInPool);
-            else
-            {
-                const char* s = GetResourceTypeString(r.type);
-                printf("%s ", s);
-            }
+            uint32_t j = HashDescriptorKey(entry.key) & mask;
+            while (m_BakedDescriptorSets[j].key)
+                j = (j + 1) & mask;
+
+            m_BakedDescriptorSets[j] = entry;
         }
-        printf("\n\n");
-    #endif
+    }
+
+    uint32_t mask = (uint32_t)m_BakedDescriptorSets.size() - 1;
+    uint32_t i = HashDescriptorKey(key) & mask;
+    while (m_BakedDescriptorSets[i].key && m_BakedDescriptorSets[i].key != key)
+        i = (i + 1) & mask;
+
+    BakedDescriptorSets& bakedDescriptorSets = m_BakedDescriptorSets[i];
+    if (!bakedDescriptorSets.key)
+    {
+        bakedDescriptorSets = {key, {}, {}, {uint32_t(-1), uint32_t(-1)}, 1};
+        m_BakedDescriptorSetsNum++;
+    }
+
+    // Already baked? (the user pool and the ping-pong parity select the variant)
+    for (uint32_t v = 0; v < 2; v++)
+    {
+        if (bakedDescriptorSets.pipelineIndex[v] == pipelineIndex && !memcmp(&m_BakedDescriptors[bakedDescriptorSets.descriptorsOffset[v]], descriptors, sizeof(nri::Descriptor*) * descriptorsNum))
+        {
+            bakedDescriptorSets.lastUsedVariant = v;
+            memcpy(descriptorSets, bakedDescriptorSets.descriptorSets[v], sizeof(nri::DescriptorSet*) * descriptorSetNum);
+
+            return true;
+        }
+    }
+
+    // Enough space in the pool?
+    DescriptorPoolDesc required = {};
+    required.setsMaxNum = samplersAreInSeparateSet ? descriptorSetNum - 1 : descriptorSetNum;
+    required.constantBuffersMaxNum = pipelineDesc.hasConstantData ? 1 : 0;
+    required.samplersMaxNum = samplersAreInSeparateSet ? 0 : instanceDesc.samplersNum;
+
+    if (samplersAreInSeparateSet && !m_BakedDescriptorSetSamplers)
+    {
+        required.setsMaxNum++;
+        required.samplersMaxNum += instanceDesc.samplersNum;
+    }
+
+    for (uint32_t j = 0; j < pipelineDesc.resourceRangesNum; j++)
+    {
+        const ResourceRangeDesc& resourceRange = pipelineDesc.resourceRanges[j];
+        if (resourceRange.descriptorType == DescriptorType::TEXTURE)
+            required.texturesMaxNum += resourceRange.descriptorsNum;
+        else if (resourceRange.descriptorType == DescriptorType::STORAGE_BUFFER)
+            required.storageBuffersMaxNum += resourceRange.descriptorsNum;
+        else
+            required.storageTexturesMaxNum += resourceRange.descriptorsNum;
+    }
+
+    DescriptorPoolDesc& available = m_BakedDescriptorPoolAvailable;
+    if (required.setsMaxNum > available.setsMaxNum || required.constantBuffersMaxNum > available.constantBuffersMaxNum || required.samplersMaxNum > available.samplersMaxNum
+        || required.texturesMaxNum > available.texturesMaxNum || required.storageTexturesMaxNum > available.storageTexturesMaxNum || required.storageBuffersMaxNum > available.storageBuffersMaxNum)
+        return false;
+
+    available.setsMaxNum -= required.setsMaxNum;
+    available.constantBuffersMaxNum -= required.constantBuffersMaxNum;
+    available.samplersMaxNum -= required.samplersMaxNum;
+    available.texturesMaxNum -= required.texturesMaxNum;
+    available.storageTexturesMaxNum -= required.storageTexturesMaxNum;
+    available.storageBuffersMaxNum -= required.storageBuffersMaxNum;
+
+    // Bake, replacing the least recently used variant (i.e. a changed user texture replaces stale sets). Replaced sets can be still referenced
+    // by the GPU, they keep occupying the pool until it gets rebuilt
+    uint32_t v = bakedDescriptorSets.lastUsedVariant ^ 1;
+    WriteDescriptorSets(*m_BakedDescriptorPool, m_BakedDescriptorSetSamplers, pipelineIndex, resourceRanges, bakedDescriptorSets.descriptorSets[v]);
+
+    bakedDescriptorSets.pipelineIndex[v] = pipelineIndex;
+    bakedDescriptorSets.descriptorsOffset[v] = (uint32_t)m_BakedDescriptors.size();
+    bakedDescriptorSets.lastUsedVariant = v;
+    memcpy(descriptorSets, bakedDescriptorSets.descriptorSets[v], sizeof(nri::DescriptorSet*) * descriptorSetNum);
+
+    m_BakedDescriptors.insert(m_BakedDescriptors.end(), descriptors, descriptors + descriptorsNum);
+
+    return true;
+}
+
+void Integration::ResetBakedDescriptorSets()
+{
+    m_IsBakedDescriptorSetsInvalid = false;
+    if (m_BakedDescriptorPool && !m_BakedDescriptorSetsNum)
+        return;
+
+    // Baked descriptor sets can be still referenced by the GPU, the pool gets destroyed when the current descriptor pool gets reset next time
+    if (m_BakedDescriptorPool)
+        m_BakedDescriptorPoolsInFlight[m_DescriptorPoolIndex] = m_BakedDescriptorPool;
+
+    // Both ping-pong parities (i.e. both variants of every dispatch)
+    const InstanceDesc& instanceDesc = GetInstanceDesc(*m_Instance);
+    m_BakedDescriptorPoolAvailable = instanceDesc.descriptorPoolDesc;
+    m_BakedDescriptorPoolAvailable.setsMaxNum *= 2;
+    m_BakedDescriptorPoolAvailable.constantBuffersMaxNum *= 2;
+    m_BakedDescriptorPoolAvailable.samplersMaxNum *= 2;
+    m_BakedDescriptorPoolAvailable.texturesMaxNum *= 2;
+    m_BakedDescriptorPoolAvailable.storageTexturesMaxNum *= 2;
+    m_BakedDescriptorPoolAvailable.storageBuffersMaxNum *= 2;
+
+    nri::DescriptorPoolDesc descriptorPoolDesc = {};
+    descriptorPoolDesc.descriptorSetMaxNum = m_BakedDescriptorPoolAvailable.setsMaxNum;
+    descriptorPoolDesc.storageTextureMaxNum = m_BakedDescriptorPoolAvailable.storageTexturesMaxNum;
+    descriptorPoolDesc.storageStructuredBufferMaxNum = m_BakedDescriptorPoolAvailable.storageBuffersMaxNum;
+    descriptorPoolDesc.textureMaxNum = m_BakedDescriptorPoolAvailable.texturesMaxNum;
+    descriptorPoolDesc.dynamicConstantBufferMaxNum = m_BakedDescriptorPoolAvailable.constantBuffersMaxNum;
+    descriptorPoolDesc.samplerMaxNum = m_BakedDescriptorPoolAvailable.samplersMaxNum;
+
+    NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateDescriptorPool(*m_Device, descriptorPoolDesc, m_BakedDescriptorPool));
+
+    m_BakedDescriptorSets.assign(64, {});
+    m_BakedDescriptors.clear();
+    m_BakedDescriptorSetSamplers = nullptr;
+    m_BakedDescriptorSetsNum = 0;
+}
+
+uint32_t Integration::GetResourceIndex(const ResourceDesc& nrdResource, uint32_t viewIndex) const
+{
+    // Pool textures first, then indirect arguments, then user textures (per view)
+    if (nrdResource.type == ResourceType::TRANSIENT_POOL)
+        return nrdResource.indexInPool + GetInstanceDesc(*m_Instance).permanentPoolSize;
+    else if (nrdResource.type == ResourceType::PERMANENT_POOL)
+        return nrdResource.indexInPool;
+    else if (nrdResource.type == ResourceType::INDIRECT_ARGUMENTS_POOL)
+        return (uint32_t)m_TexturePool.size() + nrdResource.indexInPool;
+
+    NRD_INTEGRATION_ASSERT(viewIndex < m_UserPoolsNum, "Not enough user pools!");
+
+    return uint32_t(m_TexturePool.size() + m_BufferPool.size()) + viewIndex * (uint32_t)ResourceType::TRANSIENT_POOL + (uint32_t)nrdResource.type;
+}
+
+nri::TextureBarrierDesc* Integration::GetTexture(uint32_t resourceIndex, const UserPool* userPools)
+{
+    if (resourceIndex < m_TexturePool.size())
+        return &m_TexturePool[resourceIndex];
+
+    NRD_INTEGRATION_ASSERT(resourceIndex >= m_TexturePool.size() + m_BufferPool.size(), "Not a texture!");
+
+    uint32_t userIndex = resourceIndex - uint32_t(m_TexturePool.size() + m_BufferPool.size());
+    uint32_t userPoolSize = (uint32_t)ResourceType::TRANSIENT_POOL;
+
+    nri::TextureBarrierDesc* nrdTexture = userPools[userIndex / userPoolSize][userIndex % userPoolSize];
+    NRD_INTEGRATION_ASSERT(nrdTexture && nrdTexture->texture, "'userPool' entry can't be NULL if it's in use!");
+
+    return nrdTexture;
+}
+
+nri::Descriptor* Integration::GetCachedDescriptor(nri::Texture& texture, bool isStorage, bool isArray)
+{
+    // The texture object changes if a texture in the user pool gets recreated, even if the native object is the same
+    uint64_t key = CreateDescriptorKey(m_NRI->GetTextureNativeObject(texture), isStorage, isArray);
+    auto& entry = m_CachedDescriptors.Find(key, &texture, m_FrameIndex, [this](nri::Descriptor* descriptor) { RetireDescriptor(descriptor); });
+    if (entry.descriptor)
+        return entry.descriptor;
+
+    const nri::TextureDesc& textureDesc = m_NRI->GetTextureDesc(texture);
+
+    nri::Texture2DViewDesc desc = {&texture, isStorage ? nri::Texture2DViewType::SHADER_RESOURCE_STORAGE_2D : nri::Texture2DViewType::SHADER_RESOURCE_2D, textureDesc.format, 0, 1};
+    if (isArray)
+        desc = {&texture, isStorage ? nri::Texture2DViewType::SHADER_RESOURCE_STORAGE_2D_ARRAY : nri::Texture2DViewType::SHADER_RESOURCE_2D_ARRAY, textureDesc.format, 0, 1, 0, textureDesc.layerNum};
+
+    NRD_INTEGRATION_ABORT_ON_FAILURE(m_NRI->CreateTexture2DView(desc, entry.descriptor));
+
+    return entry.descriptor;
+}
+
+void Integration::RetireDescriptor(nri::Descriptor* descriptor)
+{
+    // Can be still referenced by the GPU, gets destroyed when the current descriptor pool gets reset next time
+    m_DescriptorsInFlight[m_DescriptorPoolIndex].push_back(descriptor);
+    m_IsBakedDescriptorSetsInvalid = true;
 }
 
 void Integration::Destroy()
 {
     NRD_INTEGRATION_ASSERT(m_Instance, "Already destroyed! Did you forget to call 'Initialize'?");
 
+    if (m_ConstantBufferData)
+        m_NRI->UnmapBuffer(*m_ConstantBuffer);
+
     m_NRI->DestroyDescriptor(*m_ConstantBufferView);
     m_NRI->DestroyBuffer(*m_ConstantBuffer);
 
@@ -710,12 +1178,21 @@ void Integration::Destroy()
         descriptors.clear();
     }
     m_DescriptorsInFlight.clear();
-    m_CachedDescriptors.clear();
+
+    m_CachedDescriptors.Clear([this](nri::Descriptor* descriptor) { m_NRI->DestroyDescriptor(*descriptor); });
 
     for (const nri::TextureBarrierDesc& nrdTexture : m_TexturePool)
         m_NRI->DestroyTexture(*nrdTexture.texture);
     m_TexturePool.clear();
 
+    for (nri::Descriptor* bufferView : m_BufferViews)
+        m_NRI->DestroyDescriptor(*bufferView);
+    m_BufferViews.clear();
+
+    for (const nri::BufferBarrierDesc& nrdBuffer : m_BufferPool)
+        m_NRI->DestroyBuffer(*nrdBuffer.buffer);
+    m_BufferPool.clear();
+
     for (nri::Descriptor* descriptor : m_Samplers)
         m_NRI->DestroyDescriptor(*descriptor);
     m_Samplers.clear();
@@ -737,6 +1214,25 @@ void Integration::Destroy()
     m_DescriptorPools.clear();
     m_DescriptorSetSamplers.clear();
 
+    for (nri::DescriptorPool* descriptorPool : m_BakedDescriptorPoolsInFlight)
+    {
+        if (descriptorPool)
+            m_NRI->DestroyDescriptorPool(*descriptorPool);
+    }
+    m_BakedDescriptorPoolsInFlight.clear();
+
+    if (m_BakedDescriptorPool)
+        m_NRI->DestroyDescriptorPool(*m_BakedDescriptorPool);
+    m_BakedDescriptorPool = nullptr;
+    m_BakedDescriptorSetSamplers = nullptr;
+    m_BakedDescriptorSets.clear();
+    m_BakedDescriptorSetsTemp.clear();
+    m_BakedDescriptors.clear();
+    m_BakedDispatchDescriptorSets.clear();
+    m_BakedDispatchOccurrences.clear();
+    m_BakedDescriptorSetsNum = 0;
+    m_ConstantBufferOffsets.clear();
+
     DestroyInstance(*m_Instance);
 
     m_NRI = nullptr;
@@ -749,12 +1245,19 @@ void Integration::Destroy()
     m_TransientPoolSize = 0;
     m_ConstantBufferSize = 0;
     m_ConstantBufferViewSize = 0;
+    m_ConstantBufferData = nullptr;
     m_ConstantBufferOffset = 0;
+    m_ConstantBufferFrameSize = 0;
+    m_ConstantBufferAlignment = 0;
+    m_ConstantDataSize = 0;
+    m_ConstantDataSizeWithoutReuse = 0;
     m_BufferedFramesNum = 0;
     m_DescriptorPoolIndex = 0;
     m_FrameIndex = 0;
     m_ReloadShaders = false;
     m_EnableDescriptorCaching = false;
+    m_EnableDescriptorSetCaching = false;
+    m_IsBakedDescriptorSetsInvalid = false;
 }
 
 }
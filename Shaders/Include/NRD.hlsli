@@ -83,6 +83,12 @@ NOISY INPUTS:
 
 #define NRD_RESOURCES_SPACE_INDEX                                                       0
 
+// ( Optional ) Bindless ( "NRD_BINDLESS", SM 6.6 ): resource indices travel in the constant block, slots per register type
+#define NRD_BINDLESS_OFFSET_t                                                           0 // textures ( up to 24 )
+#define NRD_BINDLESS_OFFSET_u                                                           24 // storage textures ( up to 12 )
+#define NRD_BINDLESS_OFFSET_s                                                           36 // samplers ( up to 4 )
+#define NRD_BINDLESS_INDICES_NUM                                                        40
+
 // ( Optional ) Entry point
 #ifndef NRD_CS_MAIN
     #define NRD_CS_MAIN                                                                 main
@@ -113,6 +119,30 @@ NOISY INPUTS:
 
     #define NRD_EXPORT
 
+// DXC ( bindless )
+#elif( defined( NRD_BINDLESS ) && ( defined( NRD_COMPILER_DXC ) || defined( __hlsl_dx_compiler ) ) )
+
+    #define NRD_BINDLESS_SLOT( regName, bindingIndex )                                  ( NRD_MERGE_TOKENS( NRD_BINDLESS_OFFSET_, regName ) + bindingIndex )
+    #define NRD_BINDLESS_INDEX( regName, bindingIndex )                                 gNrdBindlessIndices[ NRD_BINDLESS_SLOT( regName, bindingIndex ) / 4 ][ NRD_BINDLESS_SLOT( regName, bindingIndex ) % 4 ]
+
+    #define NRD_CONSTANTS_START( resourceName )                                         cbuffer resourceName : register( NRD_MERGE_TOKENS( b, NRD_CONSTANT_BUFFER_REGISTER_INDEX ), NRD_MERGE_TOKENS( space, NRD_CONSTANT_BUFFER_SPACE_INDEX ) ) {
+    #define NRD_CONSTANT( constantType, constantName )                                  constantType constantName;
+    #define NRD_CONSTANTS_END                                                           uint4 gNrdBindlessIndices[ NRD_BINDLESS_INDICES_NUM / 4 ]; };
+
+    #define NRD_INPUTS_START
+    #define NRD_INPUT( resourceType, resourceName, regName, bindingIndex )              static resourceType resourceName = ResourceDescriptorHeap[ NRD_BINDLESS_INDEX( regName, bindingIndex ) ];
+    #define NRD_INPUTS_END
+
+    #define NRD_OUTPUTS_START
+    #define NRD_OUTPUT( resourceType, resourceName, regName, bindingIndex )             static resourceType resourceName = ResourceDescriptorHeap[ NRD_BINDLESS_INDEX( regName, bindingIndex ) ];
+    #define NRD_OUTPUTS_END
+
+    #define NRD_SAMPLERS_START
+    #define NRD_SAMPLER( resourceType, resourceName, regName, bindingIndex )            static resourceType resourceName = SamplerDescriptorHeap[ NRD_BINDLESS_INDEX( regName, bindingIndex ) ];
+    #define NRD_SAMPLERS_END
+
+    #define NRD_EXPORT
+
 // DXC
 #elif( defined( NRD_COMPILER_DXC ) || defined( __hlsl_dx_compiler ) )
 
@@ -172,6 +202,8 @@ NOISY INPUTS:
     #define GroupMemoryBarrierWithGroupSync                                             ThreadGroupMemoryBarrierSync
     #define GroupMemoryBarrier                                                          ThreadGroupMemoryBarrier
     #define RWTexture2D                                                                 RW_Texture2D
+    #define Texture2DArray                                                              Texture2D_Array
+    #define RWTexture2DArray                                                            RW_Texture2D_Array
     #define cbuffer                                                                     ConstantBuffer
     #define SampleLevel( ... )                                                          EXPAND( GET_NTH_MACRO_4_arg( __VA_ARGS__, SampleLevel4, SampleLevel3 )( __VA_ARGS__ ) )
     #define GatherRed( ... )                                                            EXPAND( GET_NTH_MACRO_3_arg( __VA_ARGS__, GatherRed3, GatherRed2 )( __VA_ARGS__ ) )
@@ -20,6 +20,19 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define REBLUR_ACCUMSPEED_BITS                          7 // "( 1 << REBLUR_ACCUMSPEED_BITS ) - 1" must be >= REBLUR_MAX_ACCUM_FRAME_NUM
 #define REBLUR_MATERIALID_BITS                          ( 16 - REBLUR_ACCUMSPEED_BITS - REBLUR_ACCUMSPEED_BITS )
 
+// Tiles ( see "REBLUR_CompactTiles" )
+
+// Maps a group of an indirect dispatch to a pixel of a non-sky tile. An unused slot of the tile list lands far outside
+// of the rect, i.e. it must be rejected by the rect check ( after the preload, since "GroupMemoryBarrierWithGroupSync" follows )
+int2 GetTilePixelPos( Texture2D<uint> tileList, uint2 groupId, uint2 threadPos )
+{
+    uint2 groupsPerTile = uint2( REBLUR_TILE_GROUPS_X, REBLUR_TILE_GROUPS_Y );
+    uint packedTile = tileList[ groupId / groupsPerTile ];
+    uint2 tilePos = uint2( packedTile & 0xFFFF, packedTile >> 16 );
+
+    return int2( tilePos * REBLUR_TILE_SIZE + ( groupId % groupsPerTile ) * uint2( GROUP_X, GROUP_Y ) + threadPos );
+}
+
 // Internal data ( from the previous frame )
 
 uint PackInternalData( float diffAccumSpeed, float specAccumSpeed, float materialID )
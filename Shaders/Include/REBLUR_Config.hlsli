@@ -76,6 +76,10 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define REBLUR_ANTI_FIREFLY_FILTER_RADIUS                       4 // pixels
 #define REBLUR_ANTI_FIREFLY_SIGMA_SCALE                         2.0
 #define REBLUR_ROUGHNESS_SENSITIVITY_IN_TA                      ( NRD_ROUGHNESS_SENSITIVITY * 0.3 )
+#define REBLUR_TILE_SIZE                                        16 // must match "ClassifyTiles"
+#define REBLUR_TILE_GROUPS_X                                    2 // "REBLUR_TILE_SIZE / GROUP_X" of all indirect passes
+#define REBLUR_TILE_GROUPS_Y                                    1 // "REBLUR_TILE_SIZE / GROUP_Y" of all indirect passes
+#define REBLUR_INVALID_TILE                                     0xFFFFFFFF
 #define REBLUR_SAMPLES_PER_FRAME                                1.0 // TODO: expose in settings, it will become useful with very clean signals, when max number of accumulated frames is low
 
 #if( defined REBLUR_OCCLUSION || defined REBLUR_DIRECTIONAL_OCCLUSION )
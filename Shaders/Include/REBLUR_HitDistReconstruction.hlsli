@@ -41,14 +41,14 @@ void Preload( uint2 sharedPos, int2 globalPos )
 }
 
 [numthreads( GROUP_X, GROUP_Y, 1 )]
-NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos : SV_DispatchThreadId, uint threadIndex : SV_GroupIndex )
+NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, uint2 groupId : SV_GroupId, uint threadIndex : SV_GroupIndex )
 {
-    // Preload
-    float isSky = gIn_Tiles[ pixelPos >> 4 ];
-    PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
+    // Preload (sky tiles are not dispatched)
+    int2 pixelPos = GetTilePixelPos( gIn_TileList, groupId, threadPos );
+    PRELOAD_INTO_SMEM;
 
-    // Tile-based early out
-    if( isSky != 0.0 || any( pixelPos > gRectSizeMinusOne ) )
+    // Early out for unused slots of the tile list and pixels outside of the rect
+    if( any( pixelPos > gRectSizeMinusOne ) )
         return;
 
     // Early out
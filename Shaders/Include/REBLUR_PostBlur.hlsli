@@ -9,11 +9,11 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
 [numthreads( GROUP_X, GROUP_Y, 1 )]
-NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos : SV_DispatchThreadId, uint threadIndex : SV_GroupIndex )
+NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, uint2 groupId : SV_GroupId, uint threadIndex : SV_GroupIndex )
 {
-    // Tile-based early out
-    float isSky = gIn_Tiles[ pixelPos >> 4 ];
-    if( isSky != 0.0 || any( pixelPos > gRectSizeMinusOne ) )
+    // Tile-based early out (sky tiles are not dispatched)
+    int2 pixelPos = GetTilePixelPos( gIn_TileList, groupId, threadPos );
+    if( any( pixelPos > gRectSizeMinusOne ) )
         return; // IMPORTANT: no data output, must be rejected by the "viewZ" check!
 
     // Early out
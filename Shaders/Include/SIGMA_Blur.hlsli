@@ -16,14 +16,14 @@ void Preload( uint2 sharedPos, int2 globalPos )
     globalPos = clamp( globalPos, 0, gRectSizeMinusOne );
 
     float2 data;
-    data.x = gIn_Penumbra[ globalPos ];
+    data.x = gIn_Penumbra[ SIGMA_AT( globalPos ) ];
     data.y = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( globalPos ) ] );
 
     s_Penumbra_ViewZ[ sharedPos.y ][ sharedPos.x ] = data;
 
     SIGMA_TYPE s;
     #if( !defined SIGMA_FIRST_PASS || defined SIGMA_TRANSLUCENT )
-        s = gIn_Shadow_Translucency[ globalPos ];
+        s = gIn_Shadow_Translucency[ SIGMA_AT( globalPos ) ];
     #else
         s = IsLit( data.x );
     #endif
@@ -36,10 +36,12 @@ void Preload( uint2 sharedPos, int2 globalPos )
 }
 
 [numthreads( GROUP_X, GROUP_Y, 1 )]
-NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos : SV_DispatchThreadId, uint threadIndex : SV_GroupIndex )
+NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos : SV_DispatchThreadId, uint threadIndex : SV_GroupIndex SIGMA_LAYER_ARG )
 {
+    SIGMA_SET_LAYER;
+
     // Preload
-    float isSky = gIn_Tiles[ pixelPos >> 4 ].y;
+    float isSky = gIn_Tiles[ SIGMA_AT( pixelPos >> 4 ) ].y;
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out
@@ -60,7 +62,7 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
     // Copy history
     #ifdef SIGMA_FIRST_PASS
         if( gStabilizationStrength != 0 )
-            gOut_History[ pixelPos ] = gIn_History[ pixelPos ];
+            gOut_History[ SIGMA_AT( pixelPos ) ] = gIn_History[ SIGMA_AT( pixelPos ) ];
     #endif
 
     // Tile-based early out ( potentially )
@@ -72,8 +74,8 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
 
     if( ( tileValue == 0.0 && NRD_USE_TILE_CHECK ) || centerPenumbra == 0.0 )
     {
-        gOut_Penumbra[ pixelPos ] = centerPenumbra;
-        gOut_Shadow_Translucency[ pixelPos ] = PackShadow( s_Shadow_Translucency[ smemPos.y ][ smemPos.x ] );
+        gOut_Penumbra[ SIGMA_AT( pixelPos ) ] = centerPenumbra;
+        gOut_Shadow_Translucency[ SIGMA_AT( pixelPos ) ] = PackShadow( s_Shadow_Translucency[ smemPos.y ][ smemPos.x ] );
 
         return;
     }
@@ -160,13 +162,13 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
     float3 Tv = mWorldToLocal[ 0 ];
     float3 Bv = mWorldToLocal[ 1 ];
 
-    float3 t = cross( gLightDirectionView.xyz, Nv ); // TODO: add support for other light types to bring proper anisotropic filtering
+    float3 t = cross( SIGMA_LIGHT_DIRECTION.xyz, Nv ); // TODO: add support for other light types to bring proper anisotropic filtering
     if( length( t ) > 0.001 )
     {
         Tv = normalize( t );
         Bv = cross( Tv, Nv );
 
-        float cosa = abs( dot( Nv, gLightDirectionView.xyz ) );
+        float cosa = abs( dot( Nv, SIGMA_LIGHT_DIRECTION.xyz ) );
         float skewFactor = lerp( 0.25, 1.0, cosa );
 
         //Tv *= skewFactor; // TODO: let's not srink filtering in the other direction
@@ -199,7 +201,7 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
         float2 uvScaled = ClampUvToViewport( uv );
 
         // Fetch data
-        float penum = gIn_Penumbra.SampleLevel( gNearestClamp, uvScaled, 0 );
+        float penum = gIn_Penumbra.SampleLevel( gNearestClamp, SIGMA_UV( uvScaled ), 0 );
         float z = UnpackViewZ( gIn_ViewZ.SampleLevel( gNearestClamp, WithRectOffset( uvScaled ), 0 ) );
         float signNoL = float( penum != 0.0 );
 
@@ -220,7 +222,7 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
         // Fetch shadow
         SIGMA_TYPE s;
         #if( !defined SIGMA_FIRST_PASS || defined SIGMA_TRANSLUCENT )
-            s = gIn_Shadow_Translucency.SampleLevel( gNearestClamp, uvScaled, 0 );
+            s = gIn_Shadow_Translucency.SampleLevel( gNearestClamp, SIGMA_UV( uvScaled ), 0 );
         #else
             s = IsLit( penum );
         #endif
@@ -249,7 +251,7 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
     #ifndef SIGMA_FIRST_PASS
         if( gStabilizationStrength != 0 )
     #endif
-            gOut_Penumbra[ pixelPos ] = penumbra;
+            gOut_Penumbra[ SIGMA_AT( pixelPos ) ] = penumbra;
 
-    gOut_Shadow_Translucency[ pixelPos ] = PackShadow( result );
+    gOut_Shadow_Translucency[ SIGMA_AT( pixelPos ) ] = PackShadow( result );
 }
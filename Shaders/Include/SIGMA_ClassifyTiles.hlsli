@@ -8,74 +8,91 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-groupshared uint s_Mask;
-groupshared uint s_Radius;
+groupshared uint s_Mask[ SIGMA_MAX_LAYERS ];
+groupshared uint s_Radius[ SIGMA_MAX_LAYERS ];
 
+// A single dispatch classifies tiles of all layers, guides are loaded once
 [numthreads( 8, 4, 1 )]
 NRD_EXPORT void NRD_CS_MAIN( uint2 threadPos : SV_GroupThreadId, uint2 tilePos : SV_GroupId, uint threadIndex : SV_GroupIndex )
 {
-    if( threadIndex == 0 )
+    if( threadIndex < SIGMA_LAYERS_NUM )
     {
-        s_Mask = 0;
-        s_Radius = 0;
+        s_Mask[ threadIndex ] = 0;
+        s_Radius[ threadIndex ] = 0;
     }
 
     GroupMemoryBarrier();
 
     uint2 pixelPos = tilePos * 16 + threadPos * uint2( 2, 4 );
 
-    uint mask = 0;
-    float maxRadius = 0.0;
+    float viewZ[ 2 ][ 4 ];
 
     [unroll]
-    for( uint i = 0; i < 2; i++ )
+    for( uint x = 0; x < 2; x++ )
     {
         [unroll]
-        for( uint j = 0; j < 4; j++ )
-        {
-            uint2 pos = pixelPos + uint2( i, j );
-            float h = gIn_Penumbra[ pos ];
-            float viewZ = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pos ) ] );
-
-            bool isInf = viewZ > gDenoisingRange;
-            bool isShadow = h == 0;
-            bool isLit = IsLit( h );
-
-            bool isOpaque = true;
-            #ifdef SIGMA_TRANSLUCENT
-                float3 translucency = gIn_Shadow_Translucency[ pos ].yzw;
-                isOpaque = Color::Luminance( translucency ) < 0.003; // TODO: replace with a uniformity test?
-            #endif
-
-            mask += ( ( isLit || isInf || isShadow ) ? 1 : 0 ) << 0;
-            mask += ( ( ( !isLit && isOpaque ) || isInf || isShadow ) ? 1 : 0 ) << 9;
-            mask += ( isInf ? 1 : 0 ) << 18;
+        for( uint y = 0; y < 4; y++ )
+            viewZ[ x ][ y ] = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pixelPos + uint2( x, y ) ) ] );
+    }
 
-            float hitDist = ( isLit || isInf ) ? 0 : h;
-            float unprojectZ = PixelRadiusToWorld( gUnproject, gOrthoMode, 1.0, viewZ );
-            float pixelRadius = GetKernelRadiusInPixels( hitDist, unprojectZ );
+    for( g_Layer = 0; g_Layer < SIGMA_LAYERS_NUM; g_Layer++ )
+    {
+        uint mask = 0;
+        float maxRadius = 0.0;
 
-            maxRadius = max( pixelRadius, maxRadius );
+        [unroll]
+        for( uint i = 0; i < 2; i++ )
+        {
+            [unroll]
+            for( uint j = 0; j < 4; j++ )
+            {
+                uint2 pos = pixelPos + uint2( i, j );
+                float h = gIn_Penumbra[ SIGMA_AT( pos ) ];
+                float z = viewZ[ i ][ j ];
+
+                bool isInf = z > gDenoisingRange;
+                bool isShadow = h == 0;
+                bool isLit = IsLit( h );
+
+                bool isOpaque = true;
+                #ifdef SIGMA_TRANSLUCENT
+                    float3 translucency = gIn_Shadow_Translucency[ SIGMA_AT( pos ) ].yzw;
+                    isOpaque = Color::Luminance( translucency ) < 0.003; // TODO: replace with a uniformity test?
+                #endif
+
+                mask += ( ( isLit || isInf || isShadow ) ? 1 : 0 ) << 0;
+                mask += ( ( ( !isLit && isOpaque ) || isInf || isShadow ) ? 1 : 0 ) << 9;
+                mask += ( isInf ? 1 : 0 ) << 18;
+
+                float hitDist = ( isLit || isInf ) ? 0 : h;
+                float unprojectZ = PixelRadiusToWorld( gUnproject, gOrthoMode, 1.0, z );
+                float pixelRadius = GetKernelRadiusInPixels( hitDist, unprojectZ );
+
+                maxRadius = max( pixelRadius, maxRadius );
+            }
         }
-    }
 
-    InterlockedAdd( s_Mask, mask );
-    InterlockedMax( s_Radius, asuint( maxRadius ) );
+        InterlockedAdd( s_Mask[ g_Layer ], mask );
+        InterlockedMax( s_Radius[ g_Layer ], asuint( maxRadius ) );
+    }
 
     GroupMemoryBarrier();
 
-    if( threadIndex == 0 )
+    if( threadIndex < SIGMA_LAYERS_NUM )
     {
-        bool isLit = ( ( s_Mask >> 0 ) & 511 ) == 256;
-        bool isUmbra = ( ( s_Mask >> 9 ) & 511 ) == 256;
-        bool isInf = ( ( s_Mask >> 18 ) & 511 ) == 256;
+        g_Layer = threadIndex;
+
+        uint tileMask = s_Mask[ g_Layer ];
+        bool isLit = ( ( tileMask >> 0 ) & 511 ) == 256;
+        bool isUmbra = ( ( tileMask >> 9 ) & 511 ) == 256;
+        bool isInf = ( ( tileMask >> 18 ) & 511 ) == 256;
 
         float4 result;
         result.x = ( isLit || isUmbra ) ? 0.0 : 1.0;
-        result.y = saturate( asfloat( s_Radius ) / 16.0 );
+        result.y = saturate( asfloat( s_Radius[ g_Layer ] ) / 16.0 );
         result.z = isInf ? 1.0 : 0.0;
         result.w = 0.0;
 
-        gOut_Tiles[ tilePos ] = result;
+        gOut_Tiles[ SIGMA_AT( tilePos ) ] = result;
     }
 }
@@ -13,6 +13,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define PackShadow( s )         Math::Sqrt01( s ) // must match "SIGMA_BackEnd_UnpackShadow"
 #define IsLit( p )              ( p >= NRD_FP16_MAX )
 
+static uint g_Layer = 0; // texture array layer ( see "SIGMA_AT" )
+
 float GetKernelRadiusInPixels( float hitDist, float unprojectZ, float scale = 1.0 )
 {
     float unclampedRadius = hitDist / unprojectZ;
@@ -55,19 +57,24 @@ float2 FilterBicubic(float2 size, float2 uv, out float4 uv_10_00, out float4 uv_
     return float2( yw.z, xw.z );
 }
 
-float TextureCubic(Texture2D<float2> tex, float2 uv)
+float TextureCubic(SIGMA_TEXTURE( float2 ) tex, float2 uv)
 {
     uint w, h;
-    tex.GetDimensions( w, h );
+    #ifdef SIGMA_ARRAY
+        uint layersNum;
+        tex.GetDimensions( w, h, layersNum );
+    #else
+        tex.GetDimensions( w, h );
+    #endif
     float2 size = float2( w, h );
 
     float4 uv_10_00, uv_11_01;
     float2 t = FilterBicubic( size, uv.xy, uv_10_00, uv_11_01 );
 
-    float c00 = tex.SampleLevel( gLinearClamp, uv_10_00.zw, 0 ).x;
-    float c10 = tex.SampleLevel( gLinearClamp, uv_10_00.xy, 0 ).x;
-    float c01 = tex.SampleLevel( gLinearClamp, uv_11_01.zw, 0 ).x;
-    float c11 = tex.SampleLevel( gLinearClamp, uv_11_01.xy, 0 ).x;
+    float c00 = tex.SampleLevel( gLinearClamp, SIGMA_UV( uv_10_00.zw ), 0 ).x;
+    float c10 = tex.SampleLevel( gLinearClamp, SIGMA_UV( uv_10_00.xy ), 0 ).x;
+    float c01 = tex.SampleLevel( gLinearClamp, SIGMA_UV( uv_11_01.zw ), 0 ).x;
+    float c11 = tex.SampleLevel( gLinearClamp, SIGMA_UV( uv_11_01.xy ), 0 ).x;
 
     c00 = lerp( c00, c01, t.x );
     c10 = lerp( c10, c11, t.x );
@@ -75,32 +82,43 @@ float TextureCubic(Texture2D<float2> tex, float2 uv)
     return lerp( c00, c10, t.y );
 }
 
+// "_BicubicFilterNoCornersWithFallbackToBilinearFilterWithCustomWeights_Color" with layer support
+#define _SIGMA_BicubicFilterNoCorners_Color( color, tex ) \
+    /* Sampling */ \
+    color = tex.SampleLevel( gLinearClamp, SIGMA_UV( uv01.xy ), 0 ) * w.x; \
+    color += tex.SampleLevel( gLinearClamp, SIGMA_UV( uv01.zw ), 0 ) * w.y; \
+    color += tex.SampleLevel( gLinearClamp, SIGMA_UV( uv23.xy ), 0 ) * w.z; \
+    color += tex.SampleLevel( gLinearClamp, SIGMA_UV( uv23.zw ), 0 ) * w.w; \
+    color += tex.SampleLevel( gLinearClamp, SIGMA_UV( uv4 ), 0 ) * w4; \
+    /* Normalize similarly to "Filtering::ApplyBilinearCustomWeights()" */ \
+    color = sum < 0.0001 ? 0 : color / sum;
+
 void BicubicFilterNoCorners(
     float2 samplePos, float2 invResourceSize, bool useBicubic,
-    Texture2D<float4> tex0, out float4 c0 )
+    SIGMA_TEXTURE( float4 ) tex0, out float4 c0 )
 {
     if( useBicubic )
     {
         float4 bilinearCustomWeights = 0;
 
         _BicubicFilterNoCornersWithFallbackToBilinearFilterWithCustomWeights_Init;
-        _BicubicFilterNoCornersWithFallbackToBilinearFilterWithCustomWeights_Color( c0, tex0 );
+        _SIGMA_BicubicFilterNoCorners_Color( c0, tex0 );
     }
     else
-        c0 = tex0.SampleLevel( gLinearClamp, samplePos * invResourceSize, 0 );
+        c0 = tex0.SampleLevel( gLinearClamp, SIGMA_UV( samplePos * invResourceSize ), 0 );
 }
 
 void BicubicFilterNoCorners(
     float2 samplePos, float2 invResourceSize, bool useBicubic,
-    Texture2D<float> tex0, out float c0 )
+    SIGMA_TEXTURE( float ) tex0, out float c0 )
 {
     if( useBicubic )
     {
         float4 bilinearCustomWeights = 0;
 
         _BicubicFilterNoCornersWithFallbackToBilinearFilterWithCustomWeights_Init;
-        _BicubicFilterNoCornersWithFallbackToBilinearFilterWithCustomWeights_Color( c0, tex0 );
+        _SIGMA_BicubicFilterNoCorners_Color( c0, tex0 );
     }
     else
-        c0 = tex0.SampleLevel( gLinearClamp, samplePos * invResourceSize, 0 );
+        c0 = tex0.SampleLevel( gLinearClamp, SIGMA_UV( samplePos * invResourceSize ), 0 );
 }
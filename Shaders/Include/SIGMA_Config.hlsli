@@ -64,4 +64,34 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
     NRD_CONSTANT( float, gSplitScreen ) \
     NRD_CONSTANT( float, gViewZScale ) \
     NRD_CONSTANT( float, gMinRectDimMulUnproject ) \
-    NRD_CONSTANT( uint, gFrameIndex )
+    NRD_CONSTANT( uint, gFrameIndex ) \
+    SIGMA_LAYER_CONSTANTS
+
+// Layered variant ( SIGMA_SHADOW_ARRAY ): a light per texture array layer, "SV_GroupId.z" is the layer
+#define SIGMA_MAX_LAYERS                                16 // must match "nrd::SIGMA_MAX_LAYERS_NUM"
+
+#define SIGMA_ARRAY_CONSTANTS \
+    NRD_CONSTANT( float4, gLightDirectionsView[ SIGMA_MAX_LAYERS ] ) \
+    NRD_CONSTANT( uint, gLayersNum )
+
+#ifdef SIGMA_ARRAY
+    #define SIGMA_LAYER_CONSTANTS                       SIGMA_ARRAY_CONSTANTS
+    #define SIGMA_LAYERS_NUM                            gLayersNum
+    #define SIGMA_LIGHT_DIRECTION                       gLightDirectionsView[ g_Layer ]
+    #define SIGMA_TEXTURE( type )                       Texture2DArray<type>
+    #define SIGMA_RW_TEXTURE( type )                    RWTexture2DArray<type>
+    #define SIGMA_AT( pos )                             uint3( pos, g_Layer )
+    #define SIGMA_UV( uv )                              float3( uv, g_Layer )
+    #define SIGMA_LAYER_ARG                             , uint3 layerPos : SV_GroupId
+    #define SIGMA_SET_LAYER                             g_Layer = layerPos.z
+#else
+    #define SIGMA_LAYER_CONSTANTS
+    #define SIGMA_LAYERS_NUM                            1
+    #define SIGMA_LIGHT_DIRECTION                       gLightDirectionView
+    #define SIGMA_TEXTURE( type )                       Texture2D<type>
+    #define SIGMA_RW_TEXTURE( type )                    RWTexture2D<type>
+    #define SIGMA_AT( pos )                             ( pos )
+    #define SIGMA_UV( uv )                              ( uv )
+    #define SIGMA_LAYER_ARG
+    #define SIGMA_SET_LAYER                             g_Layer = 0
+#endif
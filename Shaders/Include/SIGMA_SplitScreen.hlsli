@@ -9,18 +9,20 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
 [numthreads( GROUP_X, GROUP_Y, 1)]
-NRD_EXPORT void NRD_CS_MAIN( int2 pixelPos : SV_DispatchThreadId)
+NRD_EXPORT void NRD_CS_MAIN( int2 pixelPos : SV_DispatchThreadId SIGMA_LAYER_ARG )
 {
+    SIGMA_SET_LAYER;
+
     float2 pixelUv = float2( pixelPos + 0.5 ) * gRectSizeInv;
     if( pixelUv.x > gSplitScreen || any( pixelPos > gRectSizeMinusOne ) )
         return;
 
-    float2 data = gIn_Penumbra[ pixelPos ];
+    float2 data = gIn_Penumbra[ SIGMA_AT( pixelPos ) ];
     float viewZ = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( pixelPos ) ] );
 
     SIGMA_TYPE s;
     #ifdef SIGMA_TRANSLUCENT
-        s = gIn_Shadow_Translucency[ pixelPos ];
+        s = gIn_Shadow_Translucency[ SIGMA_AT( pixelPos ) ];
     #else
         s = IsLit( data.x );
     #endif
@@ -29,5 +31,5 @@ NRD_EXPORT void NRD_CS_MAIN( int2 pixelPos : SV_DispatchThreadId)
         s = PackShadow( data.x );
     #endif
 
-    gOut_Shadow_Translucency[ pixelPos ] = s * float( viewZ < gDenoisingRange );
+    gOut_Shadow_Translucency[ SIGMA_AT( pixelPos ) ] = s * float( viewZ < gDenoisingRange );
 }
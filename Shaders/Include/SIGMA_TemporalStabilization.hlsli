@@ -16,22 +16,24 @@ void Preload( uint2 sharedPos, int2 globalPos )
     globalPos = clamp( globalPos, 0, gRectSizeMinusOne );
 
     float2 data;
-    data.x = gIn_Penumbra[ globalPos ];
+    data.x = gIn_Penumbra[ SIGMA_AT( globalPos ) ];
     data.y = UnpackViewZ( gIn_ViewZ[ WithRectOrigin( globalPos ) ] );
 
     s_Penumbra_ViewZ[ sharedPos.y ][ sharedPos.x ] = data;
 
-    SIGMA_TYPE s = gIn_Shadow_Translucency[ globalPos ];
+    SIGMA_TYPE s = gIn_Shadow_Translucency[ SIGMA_AT( globalPos ) ];
     s = SIGMA_BackEnd_UnpackShadow( s );
 
     s_Shadow_Translucency[ sharedPos.y ][ sharedPos.x ] = s;
 }
 
 [numthreads( GROUP_X, GROUP_Y, 1 )]
-NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos : SV_DispatchThreadId, uint threadIndex : SV_GroupIndex )
+NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos : SV_DispatchThreadId, uint threadIndex : SV_GroupIndex SIGMA_LAYER_ARG )
 {
+    SIGMA_SET_LAYER;
+
     // Preload
-    float isSky = gIn_Tiles[ pixelPos >> 4 ].y;
+    float isSky = gIn_Tiles[ SIGMA_AT( pixelPos >> 4 ) ].y;
     PRELOAD_INTO_SMEM_WITH_TILE_CHECK;
 
     // Tile-based early out
@@ -56,7 +58,7 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
 
     if( isHardShadow && SIGMA_SHOW == 0 )
     {
-        gOut_Shadow_Translucency[ pixelPos ] = PackShadow( s_Shadow_Translucency[ smemPos.y ][ smemPos.x ] );
+        gOut_Shadow_Translucency[ SIGMA_AT( pixelPos ) ] = PackShadow( s_Shadow_Translucency[ smemPos.y ][ smemPos.x ] );
 
         return;
     }
@@ -153,7 +155,7 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
 
     // Debug
     #if( SIGMA_SHOW == 1 )
-        tileValue = gIn_Tiles[ pixelPos >> 4 ].x;
+        tileValue = gIn_Tiles[ SIGMA_AT( pixelPos >> 4 ) ].x;
         tileValue = float( tileValue != 0.0 ); // optional, just to show fully discarded tiles
 
         #ifdef SIGMA_TRANSLUCENT
@@ -177,5 +179,5 @@ NRD_EXPORT void NRD_CS_MAIN( int2 threadPos : SV_GroupThreadId, int2 pixelPos :
     #endif
 
     // Output
-    gOut_Shadow_Translucency[ pixelPos ] = PackShadow( result );
+    gOut_Shadow_Translucency[ SIGMA_AT( pixelPos ) ] = PackShadow( result );
 }
@@ -11,15 +11,24 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 NRD_CONSTANTS_START( Clear_UintConstants )
     NRD_CONSTANT( float, gDebug ) // only for availability in Common.hlsl
     NRD_CONSTANT( float, gViewZScale ) // only for availability in Common.hlsl
+    NRD_CONSTANT( uint, gClearOutputNum ) // number of used outputs (the last batch can be partially filled)
 NRD_CONSTANTS_END
 
 NRD_OUTPUTS_START
-    NRD_OUTPUT( RWTexture2D<uint4>, gOut, u, 0 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut0, u, 0 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut1, u, 1 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut2, u, 2 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut3, u, 3 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut4, u, 4 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut5, u, 5 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut6, u, 6 )
+    NRD_OUTPUT( RWTexture2D<uint4>, gOut7, u, 7 )
 NRD_OUTPUTS_END
 
 // Macro magic
 #define Clear_UintGroupX 16
 #define Clear_UintGroupY 16
+#define Clear_UintOutputNum 8
 
 // Redirection
 #undef GROUP_X
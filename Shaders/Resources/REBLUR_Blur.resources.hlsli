@@ -21,7 +21,7 @@ NRD_SAMPLERS_END
 #if( defined REBLUR_DIFFUSE && defined REBLUR_SPECULAR )
 
     NRD_INPUTS_START
-        NRD_INPUT( Texture2D<float>, gIn_Tiles, t, 0 )
+        NRD_INPUT( Texture2D<uint>, gIn_TileList, t, 0 )
         NRD_INPUT( Texture2D<float4>, gIn_Normal_Roughness, t, 1 )
         NRD_INPUT( Texture2D<REBLUR_DATA1_TYPE>, gIn_Data1, t, 2 )
         NRD_INPUT( Texture2D<REBLUR_TYPE>, gIn_Diff, t, 3 )
@@ -46,7 +46,7 @@ NRD_SAMPLERS_END
 #elif( defined REBLUR_DIFFUSE )
 
     NRD_INPUTS_START
-        NRD_INPUT( Texture2D<float>, gIn_Tiles, t, 0 )
+        NRD_INPUT( Texture2D<uint>, gIn_TileList, t, 0 )
         NRD_INPUT( Texture2D<float4>, gIn_Normal_Roughness, t, 1 )
         NRD_INPUT( Texture2D<REBLUR_DATA1_TYPE>, gIn_Data1, t, 2 )
         NRD_INPUT( Texture2D<REBLUR_TYPE>, gIn_Diff, t, 3 )
@@ -67,7 +67,7 @@ NRD_SAMPLERS_END
 #else
 
     NRD_INPUTS_START
-        NRD_INPUT( Texture2D<float>, gIn_Tiles, t, 0 )
+        NRD_INPUT( Texture2D<uint>, gIn_TileList, t, 0 )
         NRD_INPUT( Texture2D<float4>, gIn_Normal_Roughness, t, 1 )
         NRD_INPUT( Texture2D<REBLUR_DATA1_TYPE>, gIn_Data1, t, 2 )
         NRD_INPUT( Texture2D<REBLUR_TYPE>, gIn_Spec, t, 3 )
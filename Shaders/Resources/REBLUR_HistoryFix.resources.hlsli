@@ -20,7 +20,7 @@ NRD_SAMPLERS_END
 #if( defined REBLUR_DIFFUSE && defined REBLUR_SPECULAR )
 
     NRD_INPUTS_START
-        NRD_INPUT( Texture2D<float>, gIn_Tiles, t, 0 )
+        NRD_INPUT( Texture2D<uint>, gIn_TileList, t, 0 )
         NRD_INPUT( Texture2D<float4>, gIn_Normal_Roughness, t, 1 )
         NRD_INPUT( Texture2D<REBLUR_DATA1_TYPE>, gIn_Data1, t, 2 )
         NRD_INPUT( Texture2D<float>, gIn_ViewZ, t, 3 )
@@ -48,7 +48,7 @@ NRD_SAMPLERS_END
 #elif( defined REBLUR_DIFFUSE )
 
     NRD_INPUTS_START
-        NRD_INPUT( Texture2D<float>, gIn_Tiles, t, 0 )
+        NRD_INPUT( Texture2D<uint>, gIn_TileList, t, 0 )
         NRD_INPUT( Texture2D<float4>, gIn_Normal_Roughness, t, 1 )
         NRD_INPUT( Texture2D<REBLUR_DATA1_TYPE>, gIn_Data1, t, 2 )
         NRD_INPUT( Texture2D<float>, gIn_ViewZ, t, 3 )
@@ -70,7 +70,7 @@ NRD_SAMPLERS_END
 #else
 
     NRD_INPUTS_START
-        NRD_INPUT( Texture2D<float>, gIn_Tiles, t, 0 )
+        NRD_INPUT( Texture2D<uint>, gIn_TileList, t, 0 )
         NRD_INPUT( Texture2D<float4>, gIn_Normal_Roughness, t, 1 )
         NRD_INPUT( Texture2D<REBLUR_DATA1_TYPE>, gIn_Data1, t, 2 )
         NRD_INPUT( Texture2D<float>, gIn_ViewZ, t, 3 )
@@ -19,14 +19,14 @@ NRD_SAMPLERS_END
 
 NRD_INPUTS_START
     NRD_INPUT( Texture2D<float>, gIn_ViewZ, t, 0 )
-    NRD_INPUT( Texture2D<float>, gIn_Penumbra, t, 1 )
+    NRD_INPUT( SIGMA_TEXTURE( float ), gIn_Penumbra, t, 1 )
     #ifdef SIGMA_TRANSLUCENT
-        NRD_INPUT( Texture2D<SIGMA_TYPE>, gIn_Shadow_Translucency, t, 2 )
+        NRD_INPUT( SIGMA_TEXTURE( SIGMA_TYPE ), gIn_Shadow_Translucency, t, 2 )
     #endif
 NRD_INPUTS_END
 
 NRD_OUTPUTS_START
-    NRD_OUTPUT( RWTexture2D<float4>, gOut_Tiles, u, 0 )
+    NRD_OUTPUT( SIGMA_RW_TEXTURE( float4 ), gOut_Tiles, u, 0 )
 NRD_OUTPUTS_END
 
 // Macro magic
@@ -20,14 +20,14 @@ NRD_SAMPLERS_END
 NRD_INPUTS_START
     NRD_INPUT( Texture2D<float>, gIn_ViewZ, t, 0 )
     NRD_INPUT( Texture2D<float3>, gIn_Mv, t, 1 )
-    NRD_INPUT( Texture2D<float>, gIn_Penumbra, t, 2 )
-    NRD_INPUT( Texture2D<SIGMA_TYPE>, gIn_Shadow_Translucency, t, 3 )
-    NRD_INPUT( Texture2D<SIGMA_TYPE>, gIn_History, t, 4 )
-    NRD_INPUT( Texture2D<float2>, gIn_Tiles, t, 5 )
+    NRD_INPUT( SIGMA_TEXTURE( float ), gIn_Penumbra, t, 2 )
+    NRD_INPUT( SIGMA_TEXTURE( SIGMA_TYPE ), gIn_Shadow_Translucency, t, 3 )
+    NRD_INPUT( SIGMA_TEXTURE( SIGMA_TYPE ), gIn_History, t, 4 )
+    NRD_INPUT( SIGMA_TEXTURE( float2 ), gIn_Tiles, t, 5 )
 NRD_INPUTS_END
 
 NRD_OUTPUTS_START
-    NRD_OUTPUT( RWTexture2D<SIGMA_TYPE>, gOut_Shadow_Translucency, u, 0 )
+    NRD_OUTPUT( SIGMA_RW_TEXTURE( SIGMA_TYPE ), gOut_Shadow_Translucency, u, 0 )
 NRD_OUTPUTS_END
 
 // Macro magic
@@ -15,8 +15,26 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "Common.hlsli"
 
+// Textures in a batch can have different sizes, a batch can be partially filled
+#define CLEAR( tex, index ) \
+    if( index < gClearOutputNum ) \
+    { \
+        tex.GetDimensions( size.x, size.y ); \
+        if( all( pixelPos < size ) ) \
+            tex[ pixelPos ] = 0; \
+    }
+
 [numthreads( 16, 16, 1 )]
 NRD_EXPORT void NRD_CS_MAIN( uint2 pixelPos : SV_DispatchThreadId )
 {
-    gOut[ pixelPos ] = 0;
+    uint2 size;
+
+    CLEAR( gOut0, 0 )
+    CLEAR( gOut1, 1 )
+    CLEAR( gOut2, 2 )
+    CLEAR( gOut3, 3 )
+    CLEAR( gOut4, 4 )
+    CLEAR( gOut5, 5 )
+    CLEAR( gOut6, 6 )
+    CLEAR( gOut7, 7 )
 }
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#include "NRD.hlsli"
+#include "ml.hlsli"
+
+#include "REBLUR_Config.hlsli"
+#include "REBLUR_CompactTiles.resources.hlsli"
+
+#include "Common.hlsli"
+
+// Compacts non-sky tiles into a row-major list ( texel "i" is at "( i % tilesW, i / tilesW )" ) and writes the indirect arguments
+// of the passes consuming it. A single group, each thread owns a contiguous chunk of tiles, so the list order is the scan order
+
+#define THREAD_NUM ( GROUP_X * GROUP_Y )
+
+groupshared uint s_Offsets[ THREAD_NUM ];
+
+[numthreads( GROUP_X, GROUP_Y, 1 )]
+NRD_EXPORT void NRD_CS_MAIN( uint threadIndex : SV_GroupIndex )
+{
+    uint2 tilesSize = ( uint2( gRectSize ) + REBLUR_TILE_SIZE - 1 ) / REBLUR_TILE_SIZE;
+    uint tilesNum = tilesSize.x * tilesSize.y;
+    uint chunkSize = ( tilesNum + THREAD_NUM - 1 ) / THREAD_NUM;
+    uint chunkBegin = min( threadIndex * chunkSize, tilesNum );
+    uint chunkEnd = min( chunkBegin + chunkSize, tilesNum );
+
+    // Count live tiles in the chunk
+    uint liveNum = 0;
+    for( uint n = chunkBegin; n < chunkEnd; n++ )
+    {
+        float isSky = gIn_Tiles[ uint2( n % tilesSize.x, n / tilesSize.x ) ];
+        liveNum += ( isSky == 0.0 || !NRD_USE_TILE_CHECK ) ? 1 : 0;
+    }
+
+    s_Offsets[ threadIndex ] = liveNum;
+    GroupMemoryBarrierWithGroupSync( );
+
+    // Inclusive prefix sum ( Hillis-Steele )
+    [unroll]
+    for( uint stride = 1; stride < THREAD_NUM; stride <<= 1 )
+    {
+        uint sum = s_Offsets[ threadIndex ];
+        if( threadIndex >= stride )
+            sum += s_Offsets[ threadIndex - stride ];
+
+        GroupMemoryBarrierWithGroupSync( );
+        s_Offsets[ threadIndex ] = sum;
+        GroupMemoryBarrierWithGroupSync( );
+    }
+
+    // Write the list
+    uint listIndex = s_Offsets[ threadIndex ] - liveNum;
+    for( uint m = chunkBegin; m < chunkEnd; m++ )
+    {
+        uint2 tilePos = uint2( m % tilesSize.x, m / tilesSize.x );
+        float isSky = gIn_Tiles[ tilePos ];
+
+        if( isSky == 0.0 || !NRD_USE_TILE_CHECK )
+        {
+            gOut_TileList[ uint2( listIndex % tilesSize.x, listIndex / tilesSize.x ) ] = tilePos.x | ( tilePos.y << 16 );
+            listIndex++;
+        }
+    }
+
+    // Unused slots of the last row get rejected by the rect check of the consumers
+    uint listNum = s_Offsets[ THREAD_NUM - 1 ];
+    uint listRowsNum = ( listNum + tilesSize.x - 1 ) / tilesSize.x;
+    uint listEnd = listRowsNum * tilesSize.x;
+
+    for( uint k = listNum + threadIndex; k < listEnd; k += THREAD_NUM )
+        gOut_TileList[ uint2( k % tilesSize.x, k / tilesSize.x ) ] = REBLUR_INVALID_TILE;
+
+    // Indirect arguments
+    if( threadIndex == 0 )
+    {
+        gOut_IndirectArgs[ 0 ] = REBLUR_TILE_GROUPS_X * min( listNum, tilesSize.x );
+        gOut_IndirectArgs[ 1 ] = REBLUR_TILE_GROUPS_Y * listRowsNum;
+        gOut_IndirectArgs[ 2 ] = 1;
+    }
+}
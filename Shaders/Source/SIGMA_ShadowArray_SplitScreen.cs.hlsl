@@ -0,0 +1,21 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#include "NRD.hlsli"
+#include "ml.hlsli"
+
+#define SIGMA_ARRAY
+
+#include "SIGMA_Config.hlsli"
+#include "SIGMA_SplitScreen.resources.hlsli"
+
+#include "Common.hlsli"
+#include "SIGMA_Common.hlsli"
+#include "SIGMA_SplitScreen.hlsli"
@@ -8,15 +8,12 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-void nrd::InstanceImpl::Add_ReblurDiffuseOcclusion(DenoiserData& denoiserData)
+namespace nrd::ReblurDiffuseOcclusion
 {
     #define DENOISER_NAME REBLUR_DiffuseOcclusion
     #define DIFF_TEMP1 AsUint(Transient::DIFF_TMP1)
     #define DIFF_TEMP2 AsUint(Transient::DIFF_TMP2)
 
-    denoiserData.settings.reblur = ReblurSettings();
-    denoiserData.settingsSize = sizeof(denoiserData.settings.reblur);
-
     enum class Permanent
     {
         PREV_VIEWZ = PERMANENT_POOL_START,
@@ -25,11 +22,6 @@ void nrd::InstanceImpl::Add_ReblurDiffuseOcclusion(DenoiserData& denoiserData)
         DIFF_FAST_HISTORY,
     };
 
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_VIEWZ, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_INTERNAL_DATA, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1} );
-
     enum class Transient
     {
         DATA1 = TRANSIENT_POOL_START,
@@ -37,160 +29,252 @@ void nrd::InstanceImpl::Add_ReblurDiffuseOcclusion(DenoiserData& denoiserData)
         DIFF_TMP2,
         DIFF_FAST_HISTORY,
         TILES,
+        TILE_LIST,
     };
 
-    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_OCCLUSION, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_OCCLUSION, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
-
-    PushPass("Classify tiles");
+    enum class IndirectArguments
     {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( AsUint(Transient::TILES) );
-
-        // Shaders
-        AddDispatch( REBLUR_ClassifyTiles, REBLUR_ClassifyTiles, 1 );
-    }
+        TILES = INDIRECT_ARGUMENTS_POOL_START,
+    };
 
-    for (int i = 0; i < REBLUR_OCCLUSION_HITDIST_RECONSTRUCTION_PERMUTATION_NUM; i++)
+    constexpr auto AddPass = [](auto& instance, ReblurOcclusionPass pass, uint32_t i)
     {
-        bool is5x5 = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Hit distance reconstruction");
+        switch (pass)
         {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_DIFF_HITDIST) );
+            case ReblurOcclusionPass::CLASSIFY_TILES:
+            {
+                instance.PushPass("Classify tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_ClassifyTiles, REBLUR_ClassifyTiles, 1 );
+                }
+                break;
+            }
 
-            // Outputs
-            PushOutput( DIFF_TEMP1 );
+            case ReblurOcclusionPass::COMPACT_TILES:
+            {
+                instance.PushPass("Compact tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILE_LIST) );
+                    instance.PushIndirectArgumentsOutput( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_CompactTiles, REBLUR_CompactTiles, SINGLE_GROUP );
+                }
+                break;
+            }
 
-            // Shaders
-            if (is5x5)
+            case ReblurOcclusionPass::HITDIST_RECONSTRUCTION:
             {
-                AddDispatch( REBLUR_DiffuseOcclusion_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseOcclusion_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                bool is5x5 = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Hit distance reconstruction");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_HITDIST) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP1 );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    if (is5x5)
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseOcclusion_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseOcclusion_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                    }
+                    else
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseOcclusion_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseOcclusion_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                    }
+                }
+                break;
             }
-            else
+
+            case ReblurOcclusionPass::TEMPORAL_ACCUMULATION:
             {
-                AddDispatch( REBLUR_DiffuseOcclusion_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseOcclusion_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                bool hasDisocclusionThresholdMix = ( ( ( i >> 2 ) & 0x1 ) != 0 );
+                bool hasConfidenceInputs = ( ( ( i >> 1 ) & 0x1 ) != 0 );
+                bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Temporal accumulation");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_MV) );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+                    instance.PushInput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                    instance.PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : REBLUR_DUMMY );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : REBLUR_DUMMY );
+                    instance.PushInput( isAfterReconstruction ? DIFF_TEMP1 : AsUint(ResourceType::IN_DIFF_HITDIST) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_HITDIST) );
+                    instance.PushInput( AsUint(Permanent::DIFF_FAST_HISTORY) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( AsUint(Transient::DIFF_FAST_HISTORY) );
+                    instance.PushOutput( AsUint(Transient::DATA1) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseOcclusion_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseOcclusion_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
+                }
+                break;
             }
-        }
-    }
 
-    for (int i = 0; i < REBLUR_OCCLUSION_TEMPORAL_ACCUMULATION_PERMUTATION_NUM; i++)
-    {
-        bool hasDisocclusionThresholdMix = ( ( ( i >> 2 ) & 0x1 ) != 0 );
-        bool hasConfidenceInputs = ( ( ( i >> 1 ) & 0x1 ) != 0 );
-        bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case ReblurOcclusionPass::HISTORY_FIX:
+            {
+                instance.PushPass("History fix");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( AsUint(Transient::DIFF_FAST_HISTORY) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP1 );
+                    instance.PushOutput( AsUint(Permanent::DIFF_FAST_HISTORY) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseOcclusion_HistoryFix, REBLUR_HistoryFix, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseOcclusion_HistoryFix, REBLUR_HistoryFix, 1 );
+                }
+                break;
+            }
 
-        PushPass("Temporal accumulation");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_MV) );
-            PushInput( AsUint(Permanent::PREV_VIEWZ) );
-            PushInput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(Permanent::PREV_INTERNAL_DATA) );
-            PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : REBLUR_DUMMY );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : REBLUR_DUMMY );
-            PushInput( isAfterReconstruction ? DIFF_TEMP1 : AsUint(ResourceType::IN_DIFF_HITDIST) );
-            PushInput( AsUint(ResourceType::OUT_DIFF_HITDIST) );
-            PushInput( AsUint(Permanent::DIFF_FAST_HISTORY) );
-
-            // Outputs
-            PushOutput( DIFF_TEMP2 );
-            PushOutput( AsUint(Transient::DIFF_FAST_HISTORY) );
-            PushOutput( AsUint(Transient::DATA1) );
-
-            // Shaders
-            AddDispatch( REBLUR_DiffuseOcclusion_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
-            AddDispatch( REBLUR_Perf_DiffuseOcclusion_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
-        }
-    }
+            case ReblurOcclusionPass::BLUR:
+            {
+                instance.PushPass("Blur");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( DIFF_TEMP1 );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( AsUint(Permanent::PREV_VIEWZ) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseOcclusion_Blur, REBLUR_Blur, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseOcclusion_Blur, REBLUR_Blur, 1 );
+                }
+                break;
+            }
 
-    PushPass("History fix");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(Transient::DATA1) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( DIFF_TEMP2 );
-        PushInput( AsUint(Transient::DIFF_FAST_HISTORY) );
-
-        // Outputs
-        PushOutput( DIFF_TEMP1 );
-        PushOutput( AsUint(Permanent::DIFF_FAST_HISTORY) );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseOcclusion_HistoryFix, REBLUR_HistoryFix, 1 );
-        AddDispatch( REBLUR_Perf_DiffuseOcclusion_HistoryFix, REBLUR_HistoryFix, 1 );
-    }
-
-    PushPass("Blur");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(Transient::DATA1) );
-        PushInput( DIFF_TEMP1 );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( DIFF_TEMP2 );
-        PushOutput( AsUint(Permanent::PREV_VIEWZ) );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseOcclusion_Blur, REBLUR_Blur, 1 );
-        AddDispatch( REBLUR_Perf_DiffuseOcclusion_Blur, REBLUR_Blur, 1 );
-    }
-
-    PushPass("Post-blur");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(Transient::DATA1) );
-        PushInput( DIFF_TEMP2 );
-        PushInput( AsUint(Permanent::PREV_VIEWZ) );
-
-        // Outputs
-        PushOutput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_HITDIST) );
-        PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseOcclusion_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
-        AddDispatch( REBLUR_Perf_DiffuseOcclusion_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
-    }
-
-    PushPass("Split screen");
-    {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_HITDIST) );
+            case ReblurOcclusionPass::POST_BLUR:
+            {
+                instance.PushPass("Post-blur");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_HITDIST) );
+                    instance.PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseOcclusion_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseOcclusion_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                }
+                break;
+            }
 
-        // Outputs
-        PushOutput( AsUint(ResourceType::OUT_DIFF_HITDIST) );
+            case ReblurOcclusionPass::SPLIT_SCREEN:
+            {
+                instance.PushPass("Split screen");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_HITDIST) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_HITDIST) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_Diffuse_SplitScreen, REBLUR_SplitScreen, 1 );
+                }
+                break;
+            }
 
-        // Shaders
-        AddDispatch( REBLUR_Diffuse_SplitScreen, REBLUR_SplitScreen, 1 );
-    }
+            case ReblurOcclusionPass::VALIDATION:
+            {
+                REBLUR_ADD_VALIDATION_DISPATCH( Transient::DATA1, ResourceType::IN_DIFF_HITDIST, ResourceType::IN_DIFF_HITDIST );
+                break;
+            }
 
-    REBLUR_ADD_VALIDATION_DISPATCH( Transient::DATA1, ResourceType::IN_DIFF_HITDIST, ResourceType::IN_DIFF_HITDIST );
+            default:
+                break;
+        }
+    };
 
     #undef DENOISER_NAME
     #undef DIFF_TEMP1
     #undef DIFF_TEMP2
 }
+
+void nrd::InstanceImpl::Add_ReblurDiffuseOcclusion(DenoiserData& denoiserData)
+{
+    denoiserData.settings.reblur = ReblurSettings();
+    denoiserData.settingsSize = sizeof(denoiserData.settings.reblur);
+
+    // In "ReblurDiffuseOcclusion::Permanent" order
+    AddGuideToPermanentPool( {REBLUR_FORMAT_PREV_VIEWZ, 1}, ResourceType::IN_VIEWZ );
+    AddGuideToPermanentPool( {REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1}, ResourceType::IN_NORMAL_ROUGHNESS );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_INTERNAL_DATA, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1} );
+
+    // In "ReblurDiffuseOcclusion::Transient" order
+    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_OCCLUSION, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_OCCLUSION, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_OCCLUSION_FAST_HISTORY, 1} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
+    AddTextureToTransientPool( {Format::R32_UINT, 16} );
+
+    // In "ReblurDiffuseOcclusion::IndirectArguments" order
+    AddBufferToIndirectArgumentsPool();
+
+    AddPasses<ReblurOcclusionPass, g_ReblurOcclusionPasses, ReblurDiffuseOcclusion::AddPass>();
+}
@@ -8,7 +8,7 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-void nrd::InstanceImpl::Add_ReblurDiffuseSpecular(DenoiserData& denoiserData)
+namespace nrd::ReblurDiffuseSpecular
 {
     #define DENOISER_NAME REBLUR_DiffuseSpecular
     #define DIFF_TEMP1 AsUint(Transient::DIFF_TMP1)
@@ -16,9 +16,6 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecular(DenoiserData& denoiserData)
     #define SPEC_TEMP1 AsUint(Transient::SPEC_TMP1)
     #define SPEC_TEMP2 AsUint(Transient::SPEC_TMP2)
 
-    denoiserData.settings.reblur = ReblurSettings();
-    denoiserData.settingsSize = sizeof(denoiserData.settings.reblur);
-
     enum class Permanent
     {
         PREV_VIEWZ = PERMANENT_POOL_START,
@@ -32,16 +29,6 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecular(DenoiserData& denoiserData)
         SPEC_HITDIST_FOR_TRACKING_PONG,
     };
 
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_VIEWZ, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_INTERNAL_DATA, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
-
     enum class Transient
     {
         DATA1 = TRANSIENT_POOL_START,
@@ -54,279 +41,350 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecular(DenoiserData& denoiserData)
         SPEC_TMP2,
         SPEC_FAST_HISTORY,
         TILES,
+        TILE_LIST,
     };
 
-    AddTextureToTransientPool( {Format::RG8_UNORM, 1} );
-    AddTextureToTransientPool( {Format::R32_UINT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
-
-    PushPass("Classify tiles");
+    enum class IndirectArguments
     {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( AsUint(Transient::TILES) );
-
-        // Shaders
-        AddDispatch( REBLUR_ClassifyTiles, REBLUR_ClassifyTiles, 1 );
-    }
+        TILES = INDIRECT_ARGUMENTS_POOL_START,
+    };
 
-    for (int i = 0; i < REBLUR_HITDIST_RECONSTRUCTION_PERMUTATION_NUM; i++)
+    constexpr auto AddPass = [](auto& instance, ReblurPass pass, uint32_t i)
     {
-        bool is5x5 = ( ( ( i >> 1 ) & 0x1 ) != 0 );
-        bool isPrepassEnabled = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Hit distance reconstruction");
+        switch (pass)
         {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
-            PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
-
-            // Outputs
-            PushOutput( isPrepassEnabled ? DIFF_TEMP2 : DIFF_TEMP1 );
-            PushOutput( isPrepassEnabled ? SPEC_TEMP2 : SPEC_TEMP1 );
-
-            // Shaders
-            if (is5x5)
+            case ReblurPass::CLASSIFY_TILES:
             {
-                AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                instance.PushPass("Classify tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_ClassifyTiles, REBLUR_ClassifyTiles, 1 );
+                }
+                break;
             }
-            else
+
+            case ReblurPass::COMPACT_TILES:
             {
-                AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                instance.PushPass("Compact tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILE_LIST) );
+                    instance.PushIndirectArgumentsOutput( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_CompactTiles, REBLUR_CompactTiles, SINGLE_GROUP );
+                }
+                break;
             }
-        }
-    }
-
-    for (int i = 0; i < REBLUR_PREPASS_PERMUTATION_NUM; i++)
-    {
-        bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Pre-pass");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( isAfterReconstruction ? DIFF_TEMP2 : AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
-            PushInput( isAfterReconstruction ? SPEC_TEMP2 : AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
-
-            // Outputs
-            PushOutput( DIFF_TEMP1 );
-            PushOutput( SPEC_TEMP1 );
-            PushOutput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
-
-            // Shaders
-            AddDispatch( REBLUR_DiffuseSpecular_PrePass, REBLUR_PrePass, 1 );
-            AddDispatch( REBLUR_Perf_DiffuseSpecular_PrePass, REBLUR_PrePass, 1 );
-        }
-    }
-
-    for (int i = 0; i < REBLUR_TEMPORAL_ACCUMULATION_PERMUTATION_NUM; i++)
-    {
-        bool hasDisocclusionThresholdMix = ( ( ( i >> 3 ) & 0x1 ) != 0 );
-        bool isTemporalStabilization = ( ( ( i >> 2 ) & 0x1 ) != 0 );
-        bool hasConfidenceInputs = ( ( ( i >> 1 ) & 0x1 ) != 0 );
-        bool isAfterPrepass = ( ( ( i >> 0 ) & 0x1 ) != 0 );
 
-        PushPass("Temporal accumulation");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_MV) );
-            PushInput( AsUint(Permanent::PREV_VIEWZ) );
-            PushInput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(Permanent::PREV_INTERNAL_DATA) );
-            PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : REBLUR_DUMMY );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : REBLUR_DUMMY );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : REBLUR_DUMMY );
-            PushInput( isAfterPrepass ? DIFF_TEMP1 : AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
-            PushInput( isAfterPrepass ? SPEC_TEMP1 : AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
-            PushInput( isTemporalStabilization ? AsUint(Permanent::DIFF_HISTORY) : AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
-            PushInput( isTemporalStabilization ? AsUint(Permanent::SPEC_HISTORY) : AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-            PushInput( AsUint(Permanent::DIFF_FAST_HISTORY) );
-            PushInput( AsUint(Permanent::SPEC_FAST_HISTORY) );
-            PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG) );
-            PushInput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
-
-            // Outputs
-            PushOutput( DIFF_TEMP2 );
-            PushOutput( SPEC_TEMP2 );
-            PushOutput( AsUint(Transient::DIFF_FAST_HISTORY) );
-            PushOutput( AsUint(Transient::SPEC_FAST_HISTORY) );
-            PushOutput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
-            PushOutput( AsUint(Transient::DATA1) );
-            PushOutput( AsUint(Transient::DATA2) );
-
-            // Shaders
-            AddDispatch( REBLUR_DiffuseSpecular_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
-            AddDispatch( REBLUR_Perf_DiffuseSpecular_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
-        }
-    }
+            case ReblurPass::HITDIST_RECONSTRUCTION:
+            {
+                bool is5x5 = ( ( ( i >> 1 ) & 0x1 ) != 0 );
+                bool isPrepassEnabled = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Hit distance reconstruction");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
+
+                    // Outputs
+                    instance.PushOutput( isPrepassEnabled ? DIFF_TEMP2 : DIFF_TEMP1 );
+                    instance.PushOutput( isPrepassEnabled ? SPEC_TEMP2 : SPEC_TEMP1 );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    if (is5x5)
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                    }
+                    else
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                    }
+                }
+                break;
+            }
 
-    PushPass("History fix");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(Transient::DATA1) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( DIFF_TEMP2 );
-        PushInput( SPEC_TEMP2 );
-        PushInput( AsUint(Transient::DIFF_FAST_HISTORY) );
-        PushInput( AsUint(Transient::SPEC_FAST_HISTORY) );
-
-        // Outputs
-        PushOutput( DIFF_TEMP1 );
-        PushOutput( SPEC_TEMP1 );
-        PushOutput( AsUint(Permanent::DIFF_FAST_HISTORY) );
-        PushOutput( AsUint(Permanent::SPEC_FAST_HISTORY) );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecular_HistoryFix, REBLUR_HistoryFix, 1 );
-        AddDispatch( REBLUR_Perf_DiffuseSpecular_HistoryFix, REBLUR_HistoryFix, 1 );
-    }
-
-    PushPass("Blur");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(Transient::DATA1) );
-        PushInput( DIFF_TEMP1 );
-        PushInput( SPEC_TEMP1 );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( DIFF_TEMP2 );
-        PushOutput( SPEC_TEMP2 );
-        PushOutput( AsUint(Permanent::PREV_VIEWZ) );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecular_Blur, REBLUR_Blur, 1 );
-        AddDispatch( REBLUR_Perf_DiffuseSpecular_Blur, REBLUR_Blur, 1 );
-    }
-
-    for (int i = 0; i < REBLUR_POST_BLUR_PERMUTATION_NUM; i++)
-    {
-        bool isTemporalStabilization = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case ReblurPass::PREPASS:
+            {
+                bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Pre-pass");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( isAfterReconstruction ? DIFF_TEMP2 : AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
+                    instance.PushInput( isAfterReconstruction ? SPEC_TEMP2 : AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP1 );
+                    instance.PushOutput( SPEC_TEMP1 );
+                    instance.PushOutput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecular_PrePass, REBLUR_PrePass, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_PrePass, REBLUR_PrePass, 1 );
+                }
+                break;
+            }
 
-        PushPass("Post-blur");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(Transient::DATA1) );
-            PushInput( DIFF_TEMP2 );
-            PushInput( SPEC_TEMP2 );
-            PushInput( AsUint(Permanent::PREV_VIEWZ) );
-
-            // Outputs
-            PushOutput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
-
-            if (isTemporalStabilization)
+            case ReblurPass::TEMPORAL_ACCUMULATION:
             {
-                PushOutput( AsUint(Permanent::DIFF_HISTORY) );
-                PushOutput( AsUint(Permanent::SPEC_HISTORY) );
+                bool hasDisocclusionThresholdMix = ( ( ( i >> 3 ) & 0x1 ) != 0 );
+                bool isTemporalStabilization = ( ( ( i >> 2 ) & 0x1 ) != 0 );
+                bool hasConfidenceInputs = ( ( ( i >> 1 ) & 0x1 ) != 0 );
+                bool isAfterPrepass = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Temporal accumulation");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_MV) );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+                    instance.PushInput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                    instance.PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : REBLUR_DUMMY );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : REBLUR_DUMMY );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : REBLUR_DUMMY );
+                    instance.PushInput( isAfterPrepass ? DIFF_TEMP1 : AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
+                    instance.PushInput( isAfterPrepass ? SPEC_TEMP1 : AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
+                    instance.PushInput( isTemporalStabilization ? AsUint(Permanent::DIFF_HISTORY) : AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
+                    instance.PushInput( isTemporalStabilization ? AsUint(Permanent::SPEC_HISTORY) : AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+                    instance.PushInput( AsUint(Permanent::DIFF_FAST_HISTORY) );
+                    instance.PushInput( AsUint(Permanent::SPEC_FAST_HISTORY) );
+                    instance.PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG) );
+                    instance.PushInput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( SPEC_TEMP2 );
+                    instance.PushOutput( AsUint(Transient::DIFF_FAST_HISTORY) );
+                    instance.PushOutput( AsUint(Transient::SPEC_FAST_HISTORY) );
+                    instance.PushOutput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
+                    instance.PushOutput( AsUint(Transient::DATA1) );
+                    instance.PushOutput( AsUint(Transient::DATA2) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecular_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
+                }
+                break;
             }
-            else
+
+            case ReblurPass::HISTORY_FIX:
             {
-                PushOutput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
-                PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-                PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                instance.PushPass("History fix");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( SPEC_TEMP2 );
+                    instance.PushInput( AsUint(Transient::DIFF_FAST_HISTORY) );
+                    instance.PushInput( AsUint(Transient::SPEC_FAST_HISTORY) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP1 );
+                    instance.PushOutput( SPEC_TEMP1 );
+                    instance.PushOutput( AsUint(Permanent::DIFF_FAST_HISTORY) );
+                    instance.PushOutput( AsUint(Permanent::SPEC_FAST_HISTORY) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecular_HistoryFix, REBLUR_HistoryFix, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_HistoryFix, REBLUR_HistoryFix, 1 );
+                }
+                break;
             }
 
-            // Shaders
-            if (isTemporalStabilization)
+            case ReblurPass::BLUR:
             {
-                AddDispatch( REBLUR_DiffuseSpecular_PostBlur, REBLUR_PostBlur, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecular_PostBlur, REBLUR_PostBlur, 1 );
+                instance.PushPass("Blur");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( DIFF_TEMP1 );
+                    instance.PushInput( SPEC_TEMP1 );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( SPEC_TEMP2 );
+                    instance.PushOutput( AsUint(Permanent::PREV_VIEWZ) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecular_Blur, REBLUR_Blur, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_Blur, REBLUR_Blur, 1 );
+                }
+                break;
             }
-            else
+
+            case ReblurPass::POST_BLUR:
             {
-                AddDispatch( REBLUR_DiffuseSpecular_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecular_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                bool isTemporalStabilization = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Post-blur");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( SPEC_TEMP2 );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
+
+                    if (isTemporalStabilization)
+                    {
+                        instance.PushOutput( AsUint(Permanent::DIFF_HISTORY) );
+                        instance.PushOutput( AsUint(Permanent::SPEC_HISTORY) );
+                    }
+                    else
+                    {
+                        instance.PushOutput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
+                        instance.PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+                        instance.PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                    }
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    if (isTemporalStabilization)
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecular_PostBlur, REBLUR_PostBlur, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_PostBlur, REBLUR_PostBlur, 1 );
+                    }
+                    else
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecular_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                    }
+                }
+                break;
             }
-        }
-    }
 
-    PushPass("Copy");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
-        PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+            case ReblurPass::COPY:
+            {
+                instance.PushPass("Copy");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
+                    instance.PushInput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( SPEC_TEMP2 );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecular_Copy, REBLUR_Copy, USE_MAX_DIMS );
+                }
+                break;
+            }
 
-        // Outputs
-        PushOutput( DIFF_TEMP2 );
-        PushOutput( SPEC_TEMP2 );
+            case ReblurPass::TEMPORAL_STABILIZATION:
+            {
+                bool hasRf0AndMetalness = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Temporal stabilization");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( hasRf0AndMetalness ? AsUint(ResourceType::IN_BASECOLOR_METALNESS) : REBLUR_DUMMY );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( AsUint(Transient::DATA2) );
+                    instance.PushInput( AsUint(Permanent::DIFF_HISTORY) );
+                    instance.PushInput( AsUint(Permanent::SPEC_HISTORY) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( SPEC_TEMP2 );
+                    instance.PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::IN_MV) );
+                    instance.PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecular_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
+                }
+                break;
+            }
 
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecular_Copy, REBLUR_Copy, USE_MAX_DIMS );
-    }
+            case ReblurPass::SPLIT_SCREEN:
+            {
+                instance.PushPass("Split screen");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecular_SplitScreen, REBLUR_SplitScreen, 1 );
+                }
+                break;
+            }
 
-    for (int i = 0; i < REBLUR_TEMPORAL_STABILIZATION_PERMUTATION_NUM; i++)
-    {
-        bool hasRf0AndMetalness = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case ReblurPass::VALIDATION:
+            {
+                REBLUR_ADD_VALIDATION_DISPATCH( Transient::DATA2, ResourceType::IN_DIFF_RADIANCE_HITDIST, ResourceType::IN_SPEC_RADIANCE_HITDIST );
+                break;
+            }
 
-        PushPass("Temporal stabilization");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( hasRf0AndMetalness ? AsUint(ResourceType::IN_BASECOLOR_METALNESS) : REBLUR_DUMMY );
-            PushInput( AsUint(Permanent::PREV_VIEWZ) );
-            PushInput( AsUint(Transient::DATA1) );
-            PushInput( AsUint(Transient::DATA2) );
-            PushInput( AsUint(Permanent::DIFF_HISTORY) );
-            PushInput( AsUint(Permanent::SPEC_HISTORY) );
-            PushInput( DIFF_TEMP2 );
-            PushInput( SPEC_TEMP2 );
-            PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
-
-            // Outputs
-            PushOutput( AsUint(ResourceType::IN_MV) );
-            PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
-            PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-
-            // Shaders
-            AddDispatch( REBLUR_DiffuseSpecular_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
-            AddDispatch( REBLUR_Perf_DiffuseSpecular_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
+            default:
+                break;
         }
-    }
-
-    PushPass("Split screen");
-    {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_RADIANCE_HITDIST) );
-        PushInput( AsUint(ResourceType::IN_SPEC_RADIANCE_HITDIST) );
-
-        // Outputs
-        PushOutput( AsUint(ResourceType::OUT_DIFF_RADIANCE_HITDIST) );
-        PushOutput( AsUint(ResourceType::OUT_SPEC_RADIANCE_HITDIST) );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecular_SplitScreen, REBLUR_SplitScreen, 1 );
-    }
-
-    REBLUR_ADD_VALIDATION_DISPATCH( Transient::DATA2, ResourceType::IN_DIFF_RADIANCE_HITDIST, ResourceType::IN_SPEC_RADIANCE_HITDIST );
+    };
 
     #undef DENOISER_NAME
     #undef DIFF_TEMP1
@@ -334,3 +392,38 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecular(DenoiserData& denoiserData)
     #undef DIFF_TEMP2
     #undef SPEC_TEMP2
 }
+
+void nrd::InstanceImpl::Add_ReblurDiffuseSpecular(DenoiserData& denoiserData)
+{
+    denoiserData.settings.reblur = ReblurSettings();
+    denoiserData.settingsSize = sizeof(denoiserData.settings.reblur);
+
+    // In "ReblurDiffuseSpecular::Permanent" order
+    AddGuideToPermanentPool( {REBLUR_FORMAT_PREV_VIEWZ, 1}, ResourceType::IN_VIEWZ );
+    AddGuideToPermanentPool( {REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1}, ResourceType::IN_NORMAL_ROUGHNESS );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_INTERNAL_DATA, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
+
+    // In "ReblurDiffuseSpecular::Transient" order
+    AddTextureToTransientPool( {Format::RG8_UNORM, 1} );
+    AddTextureToTransientPool( {Format::R32_UINT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
+    AddTextureToTransientPool( {Format::R32_UINT, 16} );
+
+    // In "ReblurDiffuseSpecular::IndirectArguments" order
+    AddBufferToIndirectArgumentsPool();
+
+    AddPasses<ReblurPass, g_ReblurPasses, ReblurDiffuseSpecular::AddPass>();
+}
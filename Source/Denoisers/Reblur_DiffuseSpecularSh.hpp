@@ -8,7 +8,7 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-void nrd::InstanceImpl::Add_ReblurDiffuseSpecularSh(DenoiserData& denoiserData)
+namespace nrd::ReblurDiffuseSpecularSh
 {
     #define DENOISER_NAME REBLUR_DiffuseSpecularSh
     #define DIFF_TEMP1 AsUint(Transient::DIFF_TMP1)
@@ -20,9 +20,6 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecularSh(DenoiserData& denoiserData)
     #define SPEC_SH_TEMP1 AsUint(Transient::SPEC_SH_TMP1)
     #define SPEC_SH_TEMP2 AsUint(Transient::SPEC_SH_TMP2)
 
-    denoiserData.settings.reblur = ReblurSettings();
-    denoiserData.settingsSize = sizeof(denoiserData.settings.reblur);
-
     enum class Permanent
     {
         PREV_VIEWZ = PERMANENT_POOL_START,
@@ -38,18 +35,6 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecularSh(DenoiserData& denoiserData)
         SPEC_HITDIST_FOR_TRACKING_PONG,
     };
 
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_VIEWZ, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_INTERNAL_DATA, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
-    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
-
     enum class Transient
     {
         DATA1 = TRANSIENT_POOL_START,
@@ -66,321 +51,388 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecularSh(DenoiserData& denoiserData)
         SPEC_SH_TMP1,
         SPEC_SH_TMP2,
         TILES,
+        TILE_LIST,
     };
 
-    AddTextureToTransientPool( {Format::RG8_UNORM, 1} );
-    AddTextureToTransientPool( {Format::R32_UINT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
-
-    PushPass("Classify tiles");
+    enum class IndirectArguments
     {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( AsUint(Transient::TILES) );
-
-        // Shaders
-        AddDispatch( REBLUR_ClassifyTiles, REBLUR_ClassifyTiles, 1 );
-    }
+        TILES = INDIRECT_ARGUMENTS_POOL_START,
+    };
 
-    for (int i = 0; i < REBLUR_HITDIST_RECONSTRUCTION_PERMUTATION_NUM; i++)
+    constexpr auto AddPass = [](auto& instance, ReblurPass pass, uint32_t i)
     {
-        bool is5x5 = ( ( ( i >> 1 ) & 0x1 ) != 0 );
-        bool isPrepassEnabled = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Hit distance reconstruction");
+        switch (pass)
         {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
-
-            // Outputs
-            PushOutput( isPrepassEnabled ? DIFF_TEMP2 : DIFF_TEMP1 );
-            PushOutput( isPrepassEnabled ? SPEC_TEMP2 : SPEC_TEMP1 );
-
-            // Shaders
-            if (is5x5)
+            case ReblurPass::CLASSIFY_TILES:
             {
-                AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                instance.PushPass("Classify tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_ClassifyTiles, REBLUR_ClassifyTiles, 1 );
+                }
+                break;
             }
-            else
+
+            case ReblurPass::COMPACT_TILES:
             {
-                AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                instance.PushPass("Compact tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILE_LIST) );
+                    instance.PushIndirectArgumentsOutput( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_CompactTiles, REBLUR_CompactTiles, SINGLE_GROUP );
+                }
+                break;
             }
-        }
-    }
 
-    for (int i = 0; i < REBLUR_PREPASS_PERMUTATION_NUM; i++)
-    {
-        bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case ReblurPass::HITDIST_RECONSTRUCTION:
+            {
+                bool is5x5 = ( ( ( i >> 1 ) & 0x1 ) != 0 );
+                bool isPrepassEnabled = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Hit distance reconstruction");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
+
+                    // Outputs
+                    instance.PushOutput( isPrepassEnabled ? DIFF_TEMP2 : DIFF_TEMP1 );
+                    instance.PushOutput( isPrepassEnabled ? SPEC_TEMP2 : SPEC_TEMP1 );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    if (is5x5)
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction_5x5, REBLUR_HitDistReconstruction, 1 );
+                    }
+                    else
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecular_HitDistReconstruction, REBLUR_HitDistReconstruction, 1 );
+                    }
+                }
+                break;
+            }
 
-        PushPass("Pre-pass");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( isAfterReconstruction ? DIFF_TEMP2 : AsUint(ResourceType::IN_DIFF_SH0) );
-            PushInput( isAfterReconstruction ? SPEC_TEMP2 : AsUint(ResourceType::IN_SPEC_SH0) );
-            PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
-            PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
-
-            // Outputs
-            PushOutput( DIFF_TEMP1 );
-            PushOutput( SPEC_TEMP1 );
-            PushOutput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
-            PushOutput( DIFF_SH_TEMP1 );
-            PushOutput( SPEC_SH_TEMP1 );
-
-            // Shaders
-            AddDispatch( REBLUR_DiffuseSpecularSh_PrePass, REBLUR_PrePass, 1 );
-            AddDispatch( REBLUR_Perf_DiffuseSpecularSh_PrePass, REBLUR_PrePass, 1 );
-        }
-    }
+            case ReblurPass::PREPASS:
+            {
+                bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Pre-pass");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( isAfterReconstruction ? DIFF_TEMP2 : AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( isAfterReconstruction ? SPEC_TEMP2 : AsUint(ResourceType::IN_SPEC_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP1 );
+                    instance.PushOutput( SPEC_TEMP1 );
+                    instance.PushOutput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
+                    instance.PushOutput( DIFF_SH_TEMP1 );
+                    instance.PushOutput( SPEC_SH_TEMP1 );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecularSh_PrePass, REBLUR_PrePass, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecularSh_PrePass, REBLUR_PrePass, 1 );
+                }
+                break;
+            }
 
-    for (int i = 0; i < REBLUR_TEMPORAL_ACCUMULATION_PERMUTATION_NUM; i++)
-    {
-        bool hasDisocclusionThresholdMix = ( ( ( i >> 3 ) & 0x1 ) != 0 );
-        bool isTemporalStabilization = ( ( ( i >> 2 ) & 0x1 ) != 0 );
-        bool hasConfidenceInputs = ( ( ( i >> 1 ) & 0x1 ) != 0 );
-        bool isAfterPrepass = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case ReblurPass::TEMPORAL_ACCUMULATION:
+            {
+                bool hasDisocclusionThresholdMix = ( ( ( i >> 3 ) & 0x1 ) != 0 );
+                bool isTemporalStabilization = ( ( ( i >> 2 ) & 0x1 ) != 0 );
+                bool hasConfidenceInputs = ( ( ( i >> 1 ) & 0x1 ) != 0 );
+                bool isAfterPrepass = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Temporal accumulation");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_MV) );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+                    instance.PushInput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                    instance.PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : REBLUR_DUMMY );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : REBLUR_DUMMY );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : REBLUR_DUMMY );
+                    instance.PushInput( isAfterPrepass ? DIFF_TEMP1 : AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( isAfterPrepass ? SPEC_TEMP1 : AsUint(ResourceType::IN_SPEC_SH0) );
+                    instance.PushInput( isTemporalStabilization ? AsUint(Permanent::DIFF_HISTORY) : AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( isTemporalStabilization ? AsUint(Permanent::SPEC_HISTORY) : AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushInput( AsUint(Permanent::DIFF_FAST_HISTORY) );
+                    instance.PushInput( AsUint(Permanent::SPEC_FAST_HISTORY) );
+                    instance.PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG) );
+                    instance.PushInput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
+                    instance.PushInput( isAfterPrepass ? DIFF_SH_TEMP1 : AsUint(ResourceType::IN_DIFF_SH1) );
+                    instance.PushInput( isAfterPrepass ? SPEC_SH_TEMP1 : AsUint(ResourceType::IN_SPEC_SH1) );
+                    instance.PushInput( isTemporalStabilization ? AsUint(Permanent::DIFF_SH_HISTORY) : AsUint(ResourceType::OUT_DIFF_SH1) );
+                    instance.PushInput( isTemporalStabilization ? AsUint(Permanent::SPEC_SH_HISTORY) : AsUint(ResourceType::OUT_SPEC_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( SPEC_TEMP2 );
+                    instance.PushOutput( AsUint(Transient::DIFF_FAST_HISTORY) );
+                    instance.PushOutput( AsUint(Transient::SPEC_FAST_HISTORY) );
+                    instance.PushOutput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
+                    instance.PushOutput( AsUint(Transient::DATA1) );
+                    instance.PushOutput( AsUint(Transient::DATA2) );
+                    instance.PushOutput( DIFF_SH_TEMP2 );
+                    instance.PushOutput( SPEC_SH_TEMP2 );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecularSh_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecularSh_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
+                }
+                break;
+            }
 
-        PushPass("Temporal accumulation");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_MV) );
-            PushInput( AsUint(Permanent::PREV_VIEWZ) );
-            PushInput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(Permanent::PREV_INTERNAL_DATA) );
-            PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : REBLUR_DUMMY );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : REBLUR_DUMMY );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : REBLUR_DUMMY );
-            PushInput( isAfterPrepass ? DIFF_TEMP1 : AsUint(ResourceType::IN_DIFF_SH0) );
-            PushInput( isAfterPrepass ? SPEC_TEMP1 : AsUint(ResourceType::IN_SPEC_SH0) );
-            PushInput( isTemporalStabilization ? AsUint(Permanent::DIFF_HISTORY) : AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushInput( isTemporalStabilization ? AsUint(Permanent::SPEC_HISTORY) : AsUint(ResourceType::OUT_SPEC_SH0) );
-            PushInput( AsUint(Permanent::DIFF_FAST_HISTORY) );
-            PushInput( AsUint(Permanent::SPEC_FAST_HISTORY) );
-            PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG) );
-            PushInput( AsUint(Transient::SPEC_HITDIST_FOR_TRACKING) );
-            PushInput( isAfterPrepass ? DIFF_SH_TEMP1 : AsUint(ResourceType::IN_DIFF_SH1) );
-            PushInput( isAfterPrepass ? SPEC_SH_TEMP1 : AsUint(ResourceType::IN_SPEC_SH1) );
-            PushInput( isTemporalStabilization ? AsUint(Permanent::DIFF_SH_HISTORY) : AsUint(ResourceType::OUT_DIFF_SH1) );
-            PushInput( isTemporalStabilization ? AsUint(Permanent::SPEC_SH_HISTORY) : AsUint(ResourceType::OUT_SPEC_SH1) );
-
-            // Outputs
-            PushOutput( DIFF_TEMP2 );
-            PushOutput( SPEC_TEMP2 );
-            PushOutput( AsUint(Transient::DIFF_FAST_HISTORY) );
-            PushOutput( AsUint(Transient::SPEC_FAST_HISTORY) );
-            PushOutput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
-            PushOutput( AsUint(Transient::DATA1) );
-            PushOutput( AsUint(Transient::DATA2) );
-            PushOutput( DIFF_SH_TEMP2 );
-            PushOutput( SPEC_SH_TEMP2 );
-
-            // Shaders
-            AddDispatch( REBLUR_DiffuseSpecularSh_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
-            AddDispatch( REBLUR_Perf_DiffuseSpecularSh_TemporalAccumulation, REBLUR_TemporalAccumulation, 1 );
-        }
-    }
+            case ReblurPass::HISTORY_FIX:
+            {
+                instance.PushPass("History fix");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( SPEC_TEMP2 );
+                    instance.PushInput( AsUint(Transient::DIFF_FAST_HISTORY) );
+                    instance.PushInput( AsUint(Transient::SPEC_FAST_HISTORY) );
+                    instance.PushInput( DIFF_SH_TEMP2 );
+                    instance.PushInput( SPEC_SH_TEMP2 );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP1 );
+                    instance.PushOutput( SPEC_TEMP1 );
+                    instance.PushOutput( AsUint(Permanent::DIFF_FAST_HISTORY) );
+                    instance.PushOutput( AsUint(Permanent::SPEC_FAST_HISTORY) );
+                    instance.PushOutput( DIFF_SH_TEMP1 );
+                    instance.PushOutput( SPEC_SH_TEMP1 );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecularSh_HistoryFix, REBLUR_HistoryFix, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecularSh_HistoryFix, REBLUR_HistoryFix, 1 );
+                }
+                break;
+            }
 
-    PushPass("History fix");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(Transient::DATA1) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( DIFF_TEMP2 );
-        PushInput( SPEC_TEMP2 );
-        PushInput( AsUint(Transient::DIFF_FAST_HISTORY) );
-        PushInput( AsUint(Transient::SPEC_FAST_HISTORY) );
-        PushInput( DIFF_SH_TEMP2 );
-        PushInput( SPEC_SH_TEMP2 );
-
-        // Outputs
-        PushOutput( DIFF_TEMP1 );
-        PushOutput( SPEC_TEMP1 );
-        PushOutput( AsUint(Permanent::DIFF_FAST_HISTORY) );
-        PushOutput( AsUint(Permanent::SPEC_FAST_HISTORY) );
-        PushOutput( DIFF_SH_TEMP1 );
-        PushOutput( SPEC_SH_TEMP1 );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecularSh_HistoryFix, REBLUR_HistoryFix, 1 );
-        AddDispatch( REBLUR_Perf_DiffuseSpecularSh_HistoryFix, REBLUR_HistoryFix, 1 );
-    }
-
-    PushPass("Blur");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(Transient::DATA1) );
-        PushInput( DIFF_TEMP1 );
-        PushInput( SPEC_TEMP1 );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( DIFF_SH_TEMP1 );
-        PushInput( SPEC_SH_TEMP1 );
-
-        // Outputs
-        PushOutput( DIFF_TEMP2 );
-        PushOutput( SPEC_TEMP2 );
-        PushOutput( AsUint(Permanent::PREV_VIEWZ) );
-        PushOutput( DIFF_SH_TEMP2 );
-        PushOutput( SPEC_SH_TEMP2 );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecularSh_Blur, REBLUR_Blur, 1 );
-        AddDispatch( REBLUR_Perf_DiffuseSpecularSh_Blur, REBLUR_Blur, 1 );
-    }
-
-    for (int i = 0; i < REBLUR_POST_BLUR_PERMUTATION_NUM; i++)
-    {
-        bool isTemporalStabilization = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case ReblurPass::BLUR:
+            {
+                instance.PushPass("Blur");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( DIFF_TEMP1 );
+                    instance.PushInput( SPEC_TEMP1 );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( DIFF_SH_TEMP1 );
+                    instance.PushInput( SPEC_SH_TEMP1 );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( SPEC_TEMP2 );
+                    instance.PushOutput( AsUint(Permanent::PREV_VIEWZ) );
+                    instance.PushOutput( DIFF_SH_TEMP2 );
+                    instance.PushOutput( SPEC_SH_TEMP2 );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecularSh_Blur, REBLUR_Blur, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecularSh_Blur, REBLUR_Blur, 1 );
+                }
+                break;
+            }
 
-        PushPass("Post-blur");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(Transient::DATA1) );
-            PushInput( DIFF_TEMP2 );
-            PushInput( SPEC_TEMP2 );
-            PushInput( AsUint(Permanent::PREV_VIEWZ) );
-            PushInput( DIFF_SH_TEMP2 );
-            PushInput( SPEC_SH_TEMP2 );
-
-            // Outputs
-            PushOutput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
-
-            if (isTemporalStabilization)
+            case ReblurPass::POST_BLUR:
             {
-                PushOutput( AsUint(Permanent::DIFF_HISTORY) );
-                PushOutput( AsUint(Permanent::SPEC_HISTORY) );
-                PushOutput( AsUint(Permanent::DIFF_SH_HISTORY) );
-                PushOutput( AsUint(Permanent::SPEC_SH_HISTORY) );
+                bool isTemporalStabilization = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Post-blur");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( SPEC_TEMP2 );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+                    instance.PushInput( DIFF_SH_TEMP2 );
+                    instance.PushInput( SPEC_SH_TEMP2 );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Permanent::PREV_NORMAL_ROUGHNESS) );
+
+                    if (isTemporalStabilization)
+                    {
+                        instance.PushOutput( AsUint(Permanent::DIFF_HISTORY) );
+                        instance.PushOutput( AsUint(Permanent::SPEC_HISTORY) );
+                        instance.PushOutput( AsUint(Permanent::DIFF_SH_HISTORY) );
+                        instance.PushOutput( AsUint(Permanent::SPEC_SH_HISTORY) );
+                    }
+                    else
+                    {
+                        instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                        instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                        instance.PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                        instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                        instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+                    }
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    if (isTemporalStabilization)
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecularSh_PostBlur, REBLUR_PostBlur, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecularSh_PostBlur, REBLUR_PostBlur, 1 );
+                    }
+                    else
+                    {
+                        instance.AddDispatch( REBLUR_DiffuseSpecularSh_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                        instance.AddDispatch( REBLUR_Perf_DiffuseSpecularSh_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                    }
+                }
+                break;
             }
-            else
+
+            case ReblurPass::COPY:
             {
-                PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-                PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
-                PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
-                PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-                PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+                instance.PushPass("Copy");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    instance.PushInput( AsUint(ResourceType::OUT_SPEC_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( DIFF_TEMP2 );
+                    instance.PushOutput( SPEC_TEMP2 );
+                    instance.PushOutput( DIFF_SH_TEMP2 );
+                    instance.PushOutput( SPEC_SH_TEMP2 );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecularSh_Copy, REBLUR_Copy, USE_MAX_DIMS );
+                }
+                break;
             }
 
-            // Shaders
-            if (isTemporalStabilization)
+            case ReblurPass::TEMPORAL_STABILIZATION:
             {
-                AddDispatch( REBLUR_DiffuseSpecularSh_PostBlur, REBLUR_PostBlur, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecularSh_PostBlur, REBLUR_PostBlur, 1 );
+                bool hasRf0AndMetalness = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Temporal stabilization");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILE_LIST) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( hasRf0AndMetalness ? AsUint(ResourceType::IN_BASECOLOR_METALNESS) : REBLUR_DUMMY );
+                    instance.PushInput( AsUint(Permanent::PREV_VIEWZ) );
+                    instance.PushInput( AsUint(Transient::DATA1) );
+                    instance.PushInput( AsUint(Transient::DATA2) );
+                    instance.PushInput( AsUint(Permanent::DIFF_HISTORY) );
+                    instance.PushInput( AsUint(Permanent::SPEC_HISTORY) );
+                    instance.PushInput( DIFF_TEMP2 );
+                    instance.PushInput( SPEC_TEMP2 );
+                    instance.PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
+                    instance.PushInput( AsUint(Permanent::DIFF_SH_HISTORY) );
+                    instance.PushInput( AsUint(Permanent::SPEC_SH_HISTORY) );
+                    instance.PushInput( DIFF_SH_TEMP2 );
+                    instance.PushInput( SPEC_SH_TEMP2 );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::IN_MV) );
+                    instance.PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+
+                    // Indirect arguments
+                    instance.PushIndirectArguments( AsUint(IndirectArguments::TILES) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecularSh_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
+                    instance.AddDispatch( REBLUR_Perf_DiffuseSpecularSh_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
+                }
+                break;
             }
-            else
+
+            case ReblurPass::SPLIT_SCREEN:
             {
-                AddDispatch( REBLUR_DiffuseSpecularSh_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
-                AddDispatch( REBLUR_Perf_DiffuseSpecularSh_PostBlur_NoTemporalStabilization, REBLUR_PostBlur, 1 );
+                instance.PushPass("Split screen");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( REBLUR_DiffuseSpecularSh_SplitScreen, REBLUR_SplitScreen, 1 );
+                }
+                break;
             }
-        }
-    }
 
-    PushPass("Copy");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::OUT_SPEC_SH0) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
-        PushInput( AsUint(ResourceType::OUT_SPEC_SH1) );
-
-        // Outputs
-        PushOutput( DIFF_TEMP2 );
-        PushOutput( SPEC_TEMP2 );
-        PushOutput( DIFF_SH_TEMP2 );
-        PushOutput( SPEC_SH_TEMP2 );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecularSh_Copy, REBLUR_Copy, USE_MAX_DIMS );
-    }
-
-    for (int i = 0; i < REBLUR_TEMPORAL_STABILIZATION_PERMUTATION_NUM; i++)
-    {
-        bool hasRf0AndMetalness = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case ReblurPass::VALIDATION:
+            {
+                REBLUR_ADD_VALIDATION_DISPATCH( Transient::DATA2, ResourceType::IN_DIFF_SH0, ResourceType::IN_SPEC_SH0 );
+                break;
+            }
 
-        PushPass("Temporal stabilization");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( hasRf0AndMetalness ? AsUint(ResourceType::IN_BASECOLOR_METALNESS) : REBLUR_DUMMY );
-            PushInput( AsUint(Permanent::PREV_VIEWZ) );
-            PushInput( AsUint(Transient::DATA1) );
-            PushInput( AsUint(Transient::DATA2) );
-            PushInput( AsUint(Permanent::DIFF_HISTORY) );
-            PushInput( AsUint(Permanent::SPEC_HISTORY) );
-            PushInput( DIFF_TEMP2 );
-            PushInput( SPEC_TEMP2 );
-            PushInput( AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PONG), AsUint(Permanent::SPEC_HITDIST_FOR_TRACKING_PING) );
-            PushInput( AsUint(Permanent::DIFF_SH_HISTORY) );
-            PushInput( AsUint(Permanent::SPEC_SH_HISTORY) );
-            PushInput( DIFF_SH_TEMP2 );
-            PushInput( SPEC_SH_TEMP2 );
-
-            // Outputs
-            PushOutput( AsUint(ResourceType::IN_MV) );
-            PushOutput( AsUint(Permanent::PREV_INTERNAL_DATA) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-            PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
-
-            // Shaders
-            AddDispatch( REBLUR_DiffuseSpecularSh_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
-            AddDispatch( REBLUR_Perf_DiffuseSpecularSh_TemporalStabilization, REBLUR_TemporalStabilization, 1 );
+            default:
+                break;
         }
-    }
-
-    PushPass("Split screen");
-    {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
-        PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
-
-        // Outputs
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-        PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
-
-        // Shaders
-        AddDispatch( REBLUR_DiffuseSpecularSh_SplitScreen, REBLUR_SplitScreen, 1 );
-    }
-
-    REBLUR_ADD_VALIDATION_DISPATCH( Transient::DATA2, ResourceType::IN_DIFF_SH0, ResourceType::IN_SPEC_SH0 );
+    };
 
     #undef DENOISER_NAME
     #undef DIFF_TEMP1
@@ -392,3 +444,44 @@ void nrd::InstanceImpl::Add_ReblurDiffuseSpecularSh(DenoiserData& denoiserData)
     #undef SPEC_SH_TEMP1
     #undef SPEC_SH_TEMP2
 }
+
+void nrd::InstanceImpl::Add_ReblurDiffuseSpecularSh(DenoiserData& denoiserData)
+{
+    denoiserData.settings.reblur = ReblurSettings();
+    denoiserData.settingsSize = sizeof(denoiserData.settings.reblur);
+
+    // In "ReblurDiffuseSpecularSh::Permanent" order
+    AddGuideToPermanentPool( {REBLUR_FORMAT_PREV_VIEWZ, 1}, ResourceType::IN_VIEWZ );
+    AddGuideToPermanentPool( {REBLUR_FORMAT_PREV_NORMAL_ROUGHNESS, 1}, ResourceType::IN_NORMAL_ROUGHNESS );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_PREV_INTERNAL_DATA, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
+    AddTextureToPermanentPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
+
+    // In "ReblurDiffuseSpecularSh::Transient" order
+    AddTextureToTransientPool( {Format::RG8_UNORM, 1} );
+    AddTextureToTransientPool( {Format::R32_UINT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_HITDIST_FOR_TRACKING, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT_FAST_HISTORY, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {REBLUR_FORMAT, 1} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
+    AddTextureToTransientPool( {Format::R32_UINT, 16} );
+
+    // In "ReblurDiffuseSpecularSh::IndirectArguments" order
+    AddBufferToIndirectArgumentsPool();
+
+    AddPasses<ReblurPass, g_ReblurPasses, ReblurDiffuseSpecularSh::AddPass>();
+}
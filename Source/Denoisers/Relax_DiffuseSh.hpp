@@ -8,13 +8,10 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData)
+namespace nrd::RelaxDiffuseSh
 {
     #define DENOISER_NAME RELAX_DiffuseSh
 
-    denoiserData.settings.relax = RelaxSettings();
-    denoiserData.settingsSize = sizeof(denoiserData.settings.relax);
-
     enum class Permanent
     {
         DIFF_ILLUM_PREV = PERMANENT_POOL_START,
@@ -27,15 +24,6 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData)
         VIEWZ_PREV
     };
 
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
-    AddTextureToPermanentPool( {Format::RGBA8_UNORM, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
-    AddTextureToPermanentPool( {Format::R32_SFLOAT, 1} );
-
     enum class Transient
     {
         DIFF_ILLUM_PING = TRANSIENT_POOL_START,
@@ -46,252 +34,311 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData)
         HISTORY_LENGTH
     };
 
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
-
-    PushPass("Classify tiles");
+    constexpr auto AddPass = [](auto& instance, RelaxPass pass, uint32_t i)
     {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( AsUint(Transient::TILES) );
+        switch (pass)
+        {
+            case RelaxPass::CLASSIFY_TILES:
+            {
+                instance.PushPass("Classify tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        // Shaders
-        AddDispatch( RELAX_ClassifyTiles, RELAX_ClassifyTiles, 1 );
-    }
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILES) );
 
-    for (int i = 0; i < RELAX_HITDIST_RECONSTRUCTION_PERMUTATION_NUM; i++)
-    {
-        bool is5x5 = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+                    // Shaders
+                    instance.AddDispatch( RELAX_ClassifyTiles, RELAX_ClassifyTiles, 1 );
+                }
+                break;
+            }
 
-        PushPass("Hit distance reconstruction");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-            // Outputs
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
-
-            // Shaders
-            if (is5x5)
-                AddDispatch( RELAX_Diffuse_HitDistReconstruction_5x5, RELAX_HitDistReconstruction, 1 );
-            else
-                AddDispatch( RELAX_Diffuse_HitDistReconstruction, RELAX_HitDistReconstruction, 1 );
-        }
-    }
+            case RelaxPass::HITDIST_RECONSTRUCTION:
+            {
+                bool is5x5 = ( ( ( i >> 0 ) & 0x1 ) != 0 );
 
-    for (int i = 0; i < RELAX_PREPASS_PERMUTATION_NUM; i++)
-    {
-        bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+                instance.PushPass("Hit distance reconstruction");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+
+                    // Shaders
+                    if (is5x5)
+                        instance.AddDispatch( RELAX_Diffuse_HitDistReconstruction_5x5, RELAX_HitDistReconstruction, 1 );
+                    else
+                        instance.AddDispatch( RELAX_Diffuse_HitDistReconstruction, RELAX_HitDistReconstruction, 1 );
+                }
+                break;
+            }
 
-        PushPass("Pre-pass");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( isAfterReconstruction ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(ResourceType::IN_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
-
-            // Outputs
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-
-            // Shaders
-            AddDispatch( RELAX_DiffuseSh_PrePass, RELAX_PrePass, 1 );
-        }
-    }
+            case RelaxPass::PREPASS:
+            {
+                bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
 
-    for (int i = 0; i < RELAX_TEMPORAL_ACCUMULATION_PERMUTATION_NUM; i++)
-    {
-        bool hasDisocclusionThresholdMix = ( ( ( i >> 1 ) & 0x1 ) != 0 );
-        bool hasConfidenceInputs = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+                instance.PushPass("Pre-pass");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( isAfterReconstruction ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSh_PrePass, RELAX_PrePass, 1 );
+                }
+                break;
+            }
 
-        PushPass("Temporal accumulation");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_MV) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-            PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-            PushInput( AsUint(Permanent::VIEWZ_PREV) );
-            PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
-            PushInput( AsUint(Permanent::MATERIAL_ID_PREV) );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
-            PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : RELAX_DUMMY );
-            PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-
-            // Outputs
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
-            PushOutput( AsUint(Transient::HISTORY_LENGTH) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-            // Shaders
-            AddDispatch( RELAX_DiffuseSh_TemporalAccumulation, RELAX_TemporalAccumulation, 1 );
-        }
-    }
+            case RelaxPass::TEMPORAL_ACCUMULATION:
+            {
+                bool hasDisocclusionThresholdMix = ( ( ( i >> 1 ) & 0x1 ) != 0 );
+                bool hasConfidenceInputs = ( ( ( i >> 0 ) & 0x1 ) != 0 );
 
-    PushPass("History fix");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-
-        // Outputs
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-        // Shaders
-        AddDispatch( RELAX_DiffuseSh_HistoryFix, RELAX_HistoryFix, 1 );
-    }
-
-    PushPass("History clamping");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-        // Outputs
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
-        PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
-
-        // Shaders
-        AddDispatch( RELAX_DiffuseSh_HistoryClamping, RELAX_HistoryClamping, 1 );
-    }
-    
-    PushPass("Copy");
-    {
-        // Inputs
-        PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                instance.PushPass("Temporal accumulation");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_MV) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    instance.PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
+                    instance.PushInput( AsUint(Permanent::VIEWZ_PREV) );
+                    instance.PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                    instance.PushInput( AsUint(Permanent::MATERIAL_ID_PREV) );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
+                    instance.PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : RELAX_DUMMY );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    instance.PushOutput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSh_TemporalAccumulation, RELAX_TemporalAccumulation, 1 );
+                }
+                break;
+            }
 
-        // Outputs
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+            case RelaxPass::HISTORY_FIX:
+            {
+                instance.PushPass("History fix");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    instance.PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSh_HistoryFix, RELAX_HistoryFix, 1 );
+                }
+                break;
+            }
 
-        // Shaders
-        AddDispatch( RELAX_DiffuseSh_Copy, RELAX_Copy, 1 );
-    }
+            case RelaxPass::HISTORY_CLAMPING:
+            {
+                instance.PushPass("History clamping");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    instance.PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
+                    instance.PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSh_HistoryClamping, RELAX_HistoryClamping, 1 );
+                }
+                break;
+            }
 
-    PushPass("Anti-firefly");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
+            case RelaxPass::COPY:
+            {
+                instance.PushPass("Copy");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
 
-        // Outputs
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
 
-        // Shaders
-        AddDispatch( RELAX_DiffuseSh_AntiFirefly, RELAX_AntiFirefly, 1 );
-    }
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSh_Copy, RELAX_Copy, 1 );
+                }
+                break;
+            }
 
-    for (int i = 0; i < RELAX_ATROUS_PERMUTATION_NUM; i++)
-    {
-        bool hasConfidenceInputs = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case RelaxPass::ANTI_FIREFLY:
+            {
+                instance.PushPass("Anti-firefly");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        for (int j = 0; j < RELAX_ATROUS_BINDING_VARIANT_NUM; j++)
-        {
-            bool isSmem = j == 0;
-            bool isEven = j % 2 == 0;
-            bool isLast = j > 2;
+                    // Outputs
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
 
-            if (isSmem)
-                PushPass("A-trous (SMEM)");
-            else
-                PushPass("A-trous");
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSh_AntiFirefly, RELAX_AntiFirefly, 1 );
+                }
+                break;
+            }
 
+            case RelaxPass::ATROUS:
             {
-                // Inputs
-                PushInput( AsUint(Transient::TILES) );
-                
-                if (isSmem)
-                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-                else
-                    PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG) : AsUint(Transient::DIFF_ILLUM_PING) );
+                // Binding variants are permutations too (each is a separate pass)
+                bool hasConfidenceInputs = i >= RELAX_ATROUS_BINDING_VARIANT_NUM;
+                uint32_t j = i % RELAX_ATROUS_BINDING_VARIANT_NUM;
 
-                PushInput( AsUint(Transient::HISTORY_LENGTH) );
-                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-                PushInput( AsUint(ResourceType::IN_VIEWZ) );
-                PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
+                bool isSmem = j == 0;
+                bool isEven = j % 2 == 0;
+                bool isLast = j > 2;
 
                 if (isSmem)
-                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-                else
-                    PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG_SH1) : AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-
-                // Outputs
-                if (isLast)
-                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushPass("A-trous (SMEM)");
                 else
-                    PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(Transient::DIFF_ILLUM_PONG) );
+                    instance.PushPass("A-trous");
 
-                if (isSmem)
                 {
-                    PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-                    PushOutput( AsUint(Permanent::MATERIAL_ID_PREV) );
-                    PushOutput( AsUint(Permanent::VIEWZ_PREV) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+
+                    if (isSmem)
+                        instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    else
+                        instance.PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG) : AsUint(Transient::DIFF_ILLUM_PING) );
+
+                    instance.PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
+
+                    if (isSmem)
+                        instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+                    else
+                        instance.PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG_SH1) : AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+
+                    // Outputs
+                    if (isLast)
+                        instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    else
+                        instance.PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(Transient::DIFF_ILLUM_PONG) );
+
+                    if (isSmem)
+                    {
+                        instance.PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
+                        instance.PushOutput( AsUint(Permanent::MATERIAL_ID_PREV) );
+                        instance.PushOutput( AsUint(Permanent::VIEWZ_PREV) );
+                    }
+
+                    if (isLast)
+                        instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    else
+                        instance.PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING_SH1) : AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    // Shaders
+                    uint32_t repeatNum = isLast ? 1 : (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
+                    if (isSmem)
+                        instance.AddDispatch( RELAX_DiffuseSh_AtrousSmem, RELAX_AtrousSmem, 1 );
+                    else
+                        instance.AddDispatchRepeated( RELAX_DiffuseSh_Atrous, RELAX_Atrous, 1, repeatNum );
                 }
+                break;
+            }
 
-                if (isLast)
-                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-                else
-                    PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING_SH1) : AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+            case RelaxPass::SPLIT_SCREEN:
+            {
+                instance.PushPass("Split screen");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
 
-                // Shaders
-                uint32_t repeatNum = isLast ? 1 : (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
-                if (isSmem)
-                    AddDispatch( RELAX_DiffuseSh_AtrousSmem, RELAX_AtrousSmem, 1 );
-                else
-                    AddDispatchRepeated( RELAX_DiffuseSh_Atrous, RELAX_Atrous, 1, repeatNum );
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSh_SplitScreen, RELAX_SplitScreen, 1 );
+                }
+                break;
             }
+
+            case RelaxPass::VALIDATION:
+            {
+                RELAX_ADD_VALIDATION_DISPATCH;
+                break;
+            }
+
+            default:
+                break;
         }
-    }
+    };
 
-    PushPass("Split screen");
-    {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+    #undef DENOISER_NAME
+}
 
-        // Outputs
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+void nrd::InstanceImpl::Add_RelaxDiffuseSh(DenoiserData& denoiserData)
+{
+    denoiserData.settings.relax = RelaxSettings();
+    denoiserData.settingsSize = sizeof(denoiserData.settings.relax);
 
-        // Shaders
-        AddDispatch( RELAX_DiffuseSh_SplitScreen, RELAX_SplitScreen, 1 );
-    }
+    // In "RelaxDiffuseSh::Permanent" order
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
+    AddTextureToPermanentPool( {Format::RGBA8_UNORM, 1} );
+    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
+    AddTextureToPermanentPool( {Format::R32_SFLOAT, 1} );
 
-    RELAX_ADD_VALIDATION_DISPATCH;
+    // In "RelaxDiffuseSh::Transient" order
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
 
-    #undef DENOISER_NAME
+    AddPasses<RelaxPass, g_RelaxPasses, RelaxDiffuseSh::AddPass>();
 }
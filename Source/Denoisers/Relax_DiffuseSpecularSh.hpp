@@ -8,13 +8,10 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData)
+namespace nrd::RelaxDiffuseSpecularSh
 {
     #define DENOISER_NAME RELAX_DiffuseSpecularSh
 
-    denoiserData.settings.relax = RelaxSettings();
-    denoiserData.settingsSize = sizeof(denoiserData.settings.relax);
-
     enum class Permanent
     {
         SPEC_ILLUM_PREV = PERMANENT_POOL_START,
@@ -33,21 +30,6 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData)
         VIEWZ_PREV,
     };
 
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::R16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::R16_SFLOAT, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
-    AddTextureToPermanentPool( {Format::RGBA8_UNORM, 1} );
-    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
-    AddTextureToPermanentPool( {Format::R32_SFLOAT, 1} );
-
     enum class Transient
     {
         SPEC_ILLUM_PING = TRANSIENT_POOL_START,
@@ -63,324 +45,389 @@ void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData)
         HISTORY_LENGTH
     };
 
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
-    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
-
-    PushPass("Classify tiles");
-    {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( AsUint(Transient::TILES) );
-
-        // Shaders
-        AddDispatch( RELAX_ClassifyTiles, RELAX_ClassifyTiles, 1 );
-    }
-
-    for (int i = 0; i < RELAX_HITDIST_RECONSTRUCTION_PERMUTATION_NUM; i++)
+    constexpr auto AddPass = [](auto& instance, RelaxPass pass, uint32_t i)
     {
-        bool is5x5 = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Hit distance reconstruction");
+        switch (pass)
         {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
-            PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-            // Outputs
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
-
-            // Shaders
-            if (is5x5)
-                AddDispatch( RELAX_DiffuseSpecular_HitDistReconstruction_5x5, RELAX_HitDistReconstruction, 1 );
-            else
-                AddDispatch( RELAX_DiffuseSpecular_HitDistReconstruction, RELAX_HitDistReconstruction, 1 );
-        }
-    }
-
-    for (int i = 0; i < RELAX_PREPASS_PERMUTATION_NUM; i++)
-    {
-        bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Pre-pass");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( isAfterReconstruction ? AsUint(Transient::SPEC_ILLUM_PING) : AsUint(ResourceType::IN_SPEC_SH0) );
-            PushInput( isAfterReconstruction ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(ResourceType::IN_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
-            PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
-
-            // Outputs
-            PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
-            PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-
-            // Shaders
-            AddDispatch( RELAX_DiffuseSpecularSh_PrePass, RELAX_PrePass, 1 );
-        }
-    }
-
-    for (int i = 0; i < RELAX_TEMPORAL_ACCUMULATION_PERMUTATION_NUM; i++)
-    {
-        bool hasDisocclusionThresholdMix = ( ( ( i >> 1 ) & 0x1 ) != 0 );
-        bool hasConfidenceInputs = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Temporal accumulation");
-        {
-            // Inputs
-            PushInput( AsUint(Transient::TILES) );
-            PushInput( AsUint(ResourceType::OUT_SPEC_SH0) );
-            PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-            PushInput( AsUint(ResourceType::IN_MV) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
-            PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-            PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-            PushInput( AsUint(Permanent::VIEWZ_PREV) );
-            PushInput( AsUint(Permanent::REFLECTION_HIT_T_PREV), AsUint(Permanent::REFLECTION_HIT_T_CURR) );
-            PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
-            PushInput( AsUint(Permanent::MATERIAL_ID_PREV) );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : RELAX_DUMMY );
-            PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
-            PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : RELAX_DUMMY );
-            PushInput( AsUint(ResourceType::OUT_SPEC_SH1) );
-            PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
-            PushInput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV_SH1) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
-            PushInput( AsUint(Permanent::SPEC_ILLUM_PREV_SH1) );
-            PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-
-            // Outputs
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
-            PushOutput( AsUint(Permanent::REFLECTION_HIT_T_CURR), AsUint(Permanent::REFLECTION_HIT_T_PREV) );
-            PushOutput( AsUint(Transient::HISTORY_LENGTH) );
-            PushOutput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PING_SH1) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-            PushOutput( AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
-            PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-            // Shaders
-            AddDispatch(RELAX_DiffuseSpecularSh_TemporalAccumulation, RELAX_TemporalAccumulation, 1 );
-        }
-    }
-
-    PushPass("History fix");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PING) ); // Normal history
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PING_SH1) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-
-        // Outputs
-        PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) ); // Responsive history
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
-        PushOutput( AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
-        PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-        // Shaders
-        AddDispatch( RELAX_DiffuseSpecularSh_HistoryFix, RELAX_HistoryFix, 1 );
-    }
-
-    PushPass("History clamping");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_SPEC_SH0) ); // Noisy input with preblur applied
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PING) ); // Normal history
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PONG) ); // Responsive history
-        PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
-        PushInput( AsUint(Transient::HISTORY_LENGTH) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PING_SH1) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
-        PushInput( AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
-        PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
-
-        // Outputs
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
-        PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV_SH1) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV_SH1) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
-
-        // Shaders
-        AddDispatch( RELAX_DiffuseSpecularSh_HistoryClamping, RELAX_HistoryClamping, 1 );
-    }
-
-    PushPass("Copy");
-    {
-        // Inputs
-        PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-        PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-
-        // Outputs
-        PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-
-        // Shaders
-        AddDispatch( RELAX_DiffuseSpecularSh_Copy, RELAX_Copy, 1 );
-    }
-
-    PushPass("Anti-firefly");
-    {
-        // Inputs
-        PushInput( AsUint(Transient::TILES) );
-        PushInput( AsUint(ResourceType::OUT_SPEC_SH0) );
-        PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-
-        // Outputs
-        PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-        PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
-
-        // Shaders
-        AddDispatch( RELAX_DiffuseSpecularSh_AntiFirefly, RELAX_AntiFirefly, 1 );
-    }
-
-    for (int i = 0; i < RELAX_ATROUS_PERMUTATION_NUM; i++)
-    {
-        bool hasConfidenceInputs = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+            case RelaxPass::CLASSIFY_TILES:
+            {
+                instance.PushPass("Classify tiles");
+                {
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
 
-        for (int j = 0; j < RELAX_ATROUS_BINDING_VARIANT_NUM; j++)
-        {
-            bool isSmem = j == 0;
-            bool isEven = j % 2 == 0;
-            bool isLast = j > 2;
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::TILES) );
 
-            if (isSmem)
-                PushPass("A-trous (SMEM)");
-            else
-                PushPass("A-trous");
+                    // Shaders
+                    instance.AddDispatch( RELAX_ClassifyTiles, RELAX_ClassifyTiles, 1 );
+                }
+                break;
+            }
 
+            case RelaxPass::HITDIST_RECONSTRUCTION:
             {
-                // Inputs
-                PushInput( AsUint(Transient::TILES) );
-                
-                if (isSmem)
+                bool is5x5 = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Hit distance reconstruction");
                 {
-                    PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
-                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+
+                    // Shaders
+                    if (is5x5)
+                        instance.AddDispatch( RELAX_DiffuseSpecular_HitDistReconstruction_5x5, RELAX_HitDistReconstruction, 1 );
+                    else
+                        instance.AddDispatch( RELAX_DiffuseSpecular_HitDistReconstruction, RELAX_HitDistReconstruction, 1 );
                 }
-                else
+                break;
+            }
+
+            case RelaxPass::PREPASS:
+            {
+                bool isAfterReconstruction = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Pre-pass");
                 {
-                    PushInput( isEven ? AsUint(Transient::SPEC_ILLUM_PONG) : AsUint(Transient::SPEC_ILLUM_PING) );
-                    PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG) : AsUint(Transient::DIFF_ILLUM_PING) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( isAfterReconstruction ? AsUint(Transient::SPEC_ILLUM_PING) : AsUint(ResourceType::IN_SPEC_SH0) );
+                    instance.PushInput( isAfterReconstruction ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSpecularSh_PrePass, RELAX_PrePass, 1 );
                 }
+                break;
+            }
 
-                PushInput( AsUint(Transient::HISTORY_LENGTH) );
-                PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
-                PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-                PushInput( AsUint(ResourceType::IN_VIEWZ) );
-                PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : RELAX_DUMMY );
-                PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
+            case RelaxPass::TEMPORAL_ACCUMULATION:
+            {
+                bool hasDisocclusionThresholdMix = ( ( ( i >> 1 ) & 0x1 ) != 0 );
+                bool hasConfidenceInputs = ( ( ( i >> 0 ) & 0x1 ) != 0 );
 
-                if (isSmem)
+                instance.PushPass("Temporal accumulation");
                 {
-                    PushInput( AsUint(Permanent::SPEC_ILLUM_PREV_SH1) );
-                    PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_MV) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
+                    instance.PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    instance.PushInput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
+                    instance.PushInput( AsUint(Permanent::VIEWZ_PREV) );
+                    instance.PushInput( AsUint(Permanent::REFLECTION_HIT_T_PREV), AsUint(Permanent::REFLECTION_HIT_T_CURR) );
+                    instance.PushInput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                    instance.PushInput( AsUint(Permanent::MATERIAL_ID_PREV) );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : RELAX_DUMMY );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
+                    instance.PushInput( hasDisocclusionThresholdMix ? AsUint(ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX) : RELAX_DUMMY );
+                    instance.PushInput( AsUint(ResourceType::OUT_SPEC_SH1) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    instance.PushInput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV_SH1) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
+                    instance.PushInput( AsUint(Permanent::SPEC_ILLUM_PREV_SH1) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::SPEC_ILLUM_PING) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    instance.PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    instance.PushOutput( AsUint(Permanent::REFLECTION_HIT_T_CURR), AsUint(Permanent::REFLECTION_HIT_T_PREV) );
+                    instance.PushOutput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushOutput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                    instance.PushOutput( AsUint(Transient::SPEC_ILLUM_PING_SH1) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                    instance.PushOutput( AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch(RELAX_DiffuseSpecularSh_TemporalAccumulation, RELAX_TemporalAccumulation, 1 );
                 }
-                else
+                break;
+            }
+
+            case RelaxPass::HISTORY_FIX:
+            {
+                instance.PushPass("History fix");
                 {
-                    PushInput( isEven ? AsUint(Transient::SPEC_ILLUM_PONG_SH1) : AsUint(Transient::SPEC_ILLUM_PING_SH1) );
-                    PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG_SH1) : AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(Transient::SPEC_ILLUM_PING) ); // Normal history
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    instance.PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(Transient::SPEC_ILLUM_PING_SH1) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Transient::SPEC_ILLUM_PONG) ); // Responsive history
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    instance.PushOutput( AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
+                    instance.PushOutput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSpecularSh_HistoryFix, RELAX_HistoryFix, 1 );
                 }
+                break;
+            }
 
-                // Outputs
-                if (isLast)
+            case RelaxPass::HISTORY_CLAMPING:
+            {
+                instance.PushPass("History clamping");
                 {
-                    PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
-                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_SPEC_SH0) ); // Noisy input with preblur applied
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( AsUint(Transient::SPEC_ILLUM_PING) ); // Normal history
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING) );
+                    instance.PushInput( AsUint(Transient::SPEC_ILLUM_PONG) ); // Responsive history
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PONG) );
+                    instance.PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushInput( AsUint(Transient::SPEC_ILLUM_PING_SH1) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                    instance.PushInput( AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
+                    instance.PushInput( AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    instance.PushOutput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV) );
+                    instance.PushOutput( AsUint(Permanent::HISTORY_LENGTH_PREV) );
+                    instance.PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV_SH1) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+                    instance.PushOutput( AsUint(Permanent::SPEC_ILLUM_RESPONSIVE_PREV_SH1) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_RESPONSIVE_PREV_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSpecularSh_HistoryClamping, RELAX_HistoryClamping, 1 );
                 }
-                else
+                break;
+            }
+
+            case RelaxPass::COPY:
+            {
+                instance.PushPass("Copy");
                 {
-                    PushOutput( isEven ? AsUint(Transient::SPEC_ILLUM_PING) : AsUint(Transient::SPEC_ILLUM_PONG) );
-                    PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(Transient::DIFF_ILLUM_PONG) );
+                    // Inputs
+                    instance.PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                    instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSpecularSh_Copy, RELAX_Copy, 1 );
                 }
+                break;
+            }
 
-                if (isSmem)
+            case RelaxPass::ANTI_FIREFLY:
+            {
+                instance.PushPass("Anti-firefly");
                 {
-                    PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
-                    PushOutput( AsUint(Permanent::MATERIAL_ID_PREV) );
-                    PushOutput( AsUint(Permanent::VIEWZ_PREV) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushInput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                    instance.PushOutput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSpecularSh_AntiFirefly, RELAX_AntiFirefly, 1 );
                 }
+                break;
+            }
+
+            case RelaxPass::ATROUS:
+            {
+                // Binding variants are permutations too (each is a separate pass)
+                bool hasConfidenceInputs = i >= RELAX_ATROUS_BINDING_VARIANT_NUM;
+                uint32_t j = i % RELAX_ATROUS_BINDING_VARIANT_NUM;
+
+                bool isSmem = j == 0;
+                bool isEven = j % 2 == 0;
+                bool isLast = j > 2;
+
+                if (isSmem)
+                    instance.PushPass("A-trous (SMEM)");
+                else
+                    instance.PushPass("A-trous");
 
-                if (isLast)
                 {
-                    PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
-                    PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    // Inputs
+                    instance.PushInput( AsUint(Transient::TILES) );
+
+                    if (isSmem)
+                    {
+                        instance.PushInput( AsUint(Permanent::SPEC_ILLUM_PREV) );
+                        instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV) );
+                    }
+                    else
+                    {
+                        instance.PushInput( isEven ? AsUint(Transient::SPEC_ILLUM_PONG) : AsUint(Transient::SPEC_ILLUM_PING) );
+                        instance.PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG) : AsUint(Transient::DIFF_ILLUM_PING) );
+                    }
+
+                    instance.PushInput( AsUint(Transient::HISTORY_LENGTH) );
+                    instance.PushInput( AsUint(Transient::SPEC_REPROJECTION_CONFIDENCE) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_SPEC_CONFIDENCE) : RELAX_DUMMY );
+                    instance.PushInput( hasConfidenceInputs ? AsUint(ResourceType::IN_DIFF_CONFIDENCE) : RELAX_DUMMY );
+
+                    if (isSmem)
+                    {
+                        instance.PushInput( AsUint(Permanent::SPEC_ILLUM_PREV_SH1) );
+                        instance.PushInput( AsUint(Permanent::DIFF_ILLUM_PREV_SH1) );
+                    }
+                    else
+                    {
+                        instance.PushInput( isEven ? AsUint(Transient::SPEC_ILLUM_PONG_SH1) : AsUint(Transient::SPEC_ILLUM_PING_SH1) );
+                        instance.PushInput( isEven ? AsUint(Transient::DIFF_ILLUM_PONG_SH1) : AsUint(Transient::DIFF_ILLUM_PING_SH1) );
+                    }
+
+                    // Outputs
+                    if (isLast)
+                    {
+                        instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                        instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    }
+                    else
+                    {
+                        instance.PushOutput( isEven ? AsUint(Transient::SPEC_ILLUM_PING) : AsUint(Transient::SPEC_ILLUM_PONG) );
+                        instance.PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING) : AsUint(Transient::DIFF_ILLUM_PONG) );
+                    }
+
+                    if (isSmem)
+                    {
+                        instance.PushOutput( AsUint(Permanent::NORMAL_ROUGHNESS_PREV) );
+                        instance.PushOutput( AsUint(Permanent::MATERIAL_ID_PREV) );
+                        instance.PushOutput( AsUint(Permanent::VIEWZ_PREV) );
+                    }
+
+                    if (isLast)
+                    {
+                        instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+                        instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    }
+                    else
+                    {
+                        instance.PushOutput( isEven ? AsUint(Transient::SPEC_ILLUM_PING_SH1) : AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
+                        instance.PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING_SH1) : AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+                    }
+
+                    // Shaders
+                    uint32_t repeatNum = isLast ? 1 : (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
+                    if (isSmem)
+                        instance.AddDispatch( RELAX_DiffuseSpecularSh_AtrousSmem, RELAX_AtrousSmem, 1 );
+                    else
+                        instance.AddDispatchRepeated( RELAX_DiffuseSpecularSh_Atrous, RELAX_Atrous, 1, repeatNum );
                 }
-                else
+                break;
+            }
+
+            case RelaxPass::SPLIT_SCREEN:
+            {
+                instance.PushPass("Split screen");
                 {
-                    PushOutput( isEven ? AsUint(Transient::SPEC_ILLUM_PING_SH1) : AsUint(Transient::SPEC_ILLUM_PONG_SH1) );
-                    PushOutput( isEven ? AsUint(Transient::DIFF_ILLUM_PING_SH1) : AsUint(Transient::DIFF_ILLUM_PONG_SH1) );
+                    // Inputs
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
+                    instance.PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
+                    instance.PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
+
+                    // Outputs
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
+                    instance.PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+
+                    // Shaders
+                    instance.AddDispatch( RELAX_DiffuseSpecularSh_SplitScreen, RELAX_SplitScreen, 1 );
                 }
+                break;
+            }
 
-                // Shaders
-                uint32_t repeatNum = isLast ? 1 : (RELAX_MAX_ATROUS_PASS_NUM - 2 + 1) / 2;
-                if (isSmem)
-                    AddDispatch( RELAX_DiffuseSpecularSh_AtrousSmem, RELAX_AtrousSmem, 1 );
-                else
-                    AddDispatchRepeated( RELAX_DiffuseSpecularSh_Atrous, RELAX_Atrous, 1, repeatNum );
+            case RelaxPass::VALIDATION:
+            {
+                RELAX_ADD_VALIDATION_DISPATCH;
+                break;
             }
+
+            default:
+                break;
         }
-    }
+    };
 
-    PushPass("Split screen");
-    {
-        // Inputs
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH0) );
-        PushInput( AsUint(ResourceType::IN_SPEC_SH0) );
-        PushInput( AsUint(ResourceType::IN_DIFF_SH1) );
-        PushInput( AsUint(ResourceType::IN_SPEC_SH1) );
+    #undef DENOISER_NAME
+}
 
-        // Outputs
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_SPEC_SH0) );
-        PushOutput( AsUint(ResourceType::OUT_DIFF_SH1) );
-        PushOutput( AsUint(ResourceType::OUT_SPEC_SH1) );
+void nrd::InstanceImpl::Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData)
+{
+    denoiserData.settings.relax = RelaxSettings();
+    denoiserData.settingsSize = sizeof(denoiserData.settings.relax);
 
-        // Shaders
-        AddDispatch( RELAX_DiffuseSpecularSh_SplitScreen, RELAX_SplitScreen, 1 );
-    }
+    // In "RelaxDiffuseSpecularSh::Permanent" order
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::R16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::R16_SFLOAT, 1} );
+    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
+    AddTextureToPermanentPool( {Format::RGBA8_UNORM, 1} );
+    AddTextureToPermanentPool( {Format::R8_UNORM, 1} );
+    AddTextureToPermanentPool( {Format::R32_SFLOAT, 1} );
 
-    RELAX_ADD_VALIDATION_DISPATCH;
+    // In "RelaxDiffuseSpecularSh::Transient" order
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::RGBA16_SFLOAT, 1} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 16} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 1} );
 
-    #undef DENOISER_NAME
+    AddPasses<RelaxPass, g_RelaxPasses, RelaxDiffuseSpecularSh::AddPass>();
 }
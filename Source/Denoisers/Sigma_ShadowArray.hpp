@@ -0,0 +1,154 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+namespace nrd::SigmaShadowArray
+{
+    #define DENOISER_NAME SIGMA_ShadowArray
+
+    enum class Transient
+    {
+        DATA_1 = TRANSIENT_POOL_START,
+        DATA_2,
+        TEMP_1,
+        TEMP_2,
+        HISTORY,
+        TILES,
+        SMOOTHED_TILES,
+    };
+
+    constexpr auto AddPass = [](auto& instance, SigmaPass pass, uint32_t i)
+    {
+        switch (pass)
+        {
+            case SigmaPass::CLASSIFY_TILES:
+            {
+                instance.PushPass("Classify tiles");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushArrayInput( AsUint(ResourceType::IN_PENUMBRA) );
+
+                    instance.PushArrayOutput( AsUint(Transient::TILES) );
+
+                    instance.AddArrayDispatch( SIGMA_ShadowArray_ClassifyTiles, SIGMA_ClassifyTiles, 1 );
+                }
+                break;
+            }
+
+            case SigmaPass::SMOOTH_TILES:
+            {
+                instance.PushPass("Smooth tiles");
+                {
+                    instance.PushArrayInput( AsUint(Transient::TILES) );
+
+                    instance.PushArrayOutput( AsUint(Transient::SMOOTHED_TILES) );
+
+                    instance.AddArrayDispatch( SIGMA_ShadowArray_SmoothTiles, SIGMA_SmoothTiles, 16 );
+                }
+                break;
+            }
+
+            case SigmaPass::BLUR:
+            {
+                instance.PushPass("Blur");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushArrayInput( AsUint(ResourceType::IN_PENUMBRA) );
+                    instance.PushArrayInput( AsUint(Transient::SMOOTHED_TILES) );
+                    instance.PushArrayInput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+
+                    instance.PushArrayOutput( AsUint(Transient::DATA_1) );
+                    instance.PushArrayOutput( AsUint(Transient::TEMP_1) );
+                    instance.PushArrayOutput( AsUint(Transient::HISTORY) );
+
+                    instance.AddArrayDispatch( SIGMA_ShadowArray_Blur, SIGMA_Blur, USE_MAX_DIMS );
+                }
+                break;
+            }
+
+            case SigmaPass::POST_BLUR:
+            {
+                bool isStabilizationEnabled = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Post-blur");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushArrayInput( AsUint(Transient::DATA_1) );
+                    instance.PushArrayInput( AsUint(Transient::SMOOTHED_TILES) );
+                    instance.PushArrayInput( AsUint(Transient::TEMP_1) );
+
+                    instance.PushArrayOutput( AsUint(Transient::DATA_2) );
+                    instance.PushArrayOutput( isStabilizationEnabled ? AsUint(Transient::TEMP_2) : AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+
+                    instance.AddArrayDispatch( SIGMA_ShadowArray_PostBlur, SIGMA_Blur, 1 );
+                }
+                break;
+            }
+
+            case SigmaPass::TEMPORAL_STABILIZATION:
+            {
+                instance.PushPass("Temporal stabilization");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_MV) );
+                    instance.PushArrayInput( AsUint(Transient::DATA_2) );
+                    instance.PushArrayInput( AsUint(Transient::TEMP_2) );
+                    instance.PushArrayInput( AsUint(Transient::HISTORY) );
+                    instance.PushArrayInput( AsUint(Transient::SMOOTHED_TILES) );
+
+                    instance.PushArrayOutput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+
+                    instance.AddArrayDispatch( SIGMA_ShadowArray_TemporalStabilization, SIGMA_TemporalStabilization, 1 );
+                }
+                break;
+            }
+
+            case SigmaPass::SPLIT_SCREEN:
+            {
+                instance.PushPass("Split screen");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushArrayInput( AsUint(ResourceType::IN_PENUMBRA) );
+
+                    instance.PushArrayOutput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+
+                    instance.AddArrayDispatch( SIGMA_ShadowArray_SplitScreen, SIGMA_SplitScreen, 1 );
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    };
+
+    #undef DENOISER_NAME
+}
+
+void nrd::InstanceImpl::Add_SigmaShadowArray(DenoiserData& denoiserData)
+{
+    denoiserData.settings.sigmaArray = SigmaArraySettings();
+    denoiserData.settingsSize = sizeof(denoiserData.settings.sigmaArray);
+
+    // A light per layer
+    uint16_t layersNum = denoiserData.desc.layersNum;
+
+    // In "SigmaShadowArray::Transient" order
+    AddTextureToTransientPool( {Format::R16_SFLOAT, 1, layersNum} );
+    AddTextureToTransientPool( {Format::R16_SFLOAT, 1, layersNum} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 1, layersNum} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 1, layersNum} );
+    AddTextureToTransientPool( {Format::R8_UNORM, 1, layersNum} );
+    AddTextureToTransientPool( {Format::RGBA8_UNORM, 16, layersNum} );
+    AddTextureToTransientPool( {Format::RG8_UNORM, 16, layersNum} );
+
+    AddPasses<SigmaPass, g_SigmaPasses, SigmaShadowArray::AddPass>();
+}
@@ -8,13 +8,10 @@ distribution of this software and related documentation without an express
 license agreement from NVIDIA CORPORATION is strictly prohibited.
 */
 
-void nrd::InstanceImpl::Add_SigmaShadowTranslucency(nrd::DenoiserData& denoiserData)
+namespace nrd::SigmaShadowTranslucency
 {
     #define DENOISER_NAME SIGMA_ShadowTranslucency
 
-    denoiserData.settings.sigma = SigmaSettings();
-    denoiserData.settingsSize = sizeof(denoiserData.settings.sigma);
-
     enum class Transient
     {
         DATA_1 = TRANSIENT_POOL_START,
@@ -26,6 +23,125 @@ void nrd::InstanceImpl::Add_SigmaShadowTranslucency(nrd::DenoiserData& denoiserD
         SMOOTHED_TILES,
     };
 
+    constexpr auto AddPass = [](auto& instance, SigmaPass pass, uint32_t i)
+    {
+        switch (pass)
+        {
+            case SigmaPass::CLASSIFY_TILES:
+            {
+                instance.PushPass("Classify tiles");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_PENUMBRA) );
+                    instance.PushInput( AsUint(ResourceType::IN_TRANSLUCENCY) );
+
+                    instance.PushOutput( AsUint(Transient::TILES) );
+
+                    instance.AddDispatch( SIGMA_ShadowTranslucency_ClassifyTiles, SIGMA_ClassifyTiles, 1 );
+                }
+                break;
+            }
+
+            case SigmaPass::SMOOTH_TILES:
+            {
+                instance.PushPass("Smooth tiles");
+                {
+                    instance.PushInput( AsUint(Transient::TILES) );
+
+                    instance.PushOutput( AsUint(Transient::SMOOTHED_TILES) );
+
+                    instance.AddDispatch( SIGMA_Shadow_SmoothTiles, SIGMA_SmoothTiles, 16 );
+                }
+                break;
+            }
+
+            case SigmaPass::BLUR:
+            {
+                instance.PushPass("Blur");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(ResourceType::IN_PENUMBRA) );
+                    instance.PushInput( AsUint(Transient::SMOOTHED_TILES) );
+                    instance.PushInput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+                    instance.PushInput( AsUint(ResourceType::IN_TRANSLUCENCY) );
+
+                    instance.PushOutput( AsUint(Transient::DATA_1) );
+                    instance.PushOutput( AsUint(Transient::TEMP_1) );
+                    instance.PushOutput( AsUint(Transient::HISTORY) );
+
+                    instance.AddDispatch( SIGMA_ShadowTranslucency_Blur, SIGMA_Blur, USE_MAX_DIMS );
+                }
+                break;
+            }
+
+            case SigmaPass::POST_BLUR:
+            {
+                bool isStabilizationEnabled = ( ( ( i >> 0 ) & 0x1 ) != 0 );
+
+                instance.PushPass("Post-blur");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
+                    instance.PushInput( AsUint(Transient::DATA_1) );
+                    instance.PushInput( AsUint(Transient::SMOOTHED_TILES) );
+                    instance.PushInput( AsUint(Transient::TEMP_1) );
+
+                    instance.PushOutput( AsUint(Transient::DATA_2) );
+                    instance.PushOutput( isStabilizationEnabled ? AsUint(Transient::TEMP_2) : AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+
+                    instance.AddDispatch( SIGMA_ShadowTranslucency_PostBlur, SIGMA_Blur, 1 );
+                }
+                break;
+            }
+
+            case SigmaPass::TEMPORAL_STABILIZATION:
+            {
+                instance.PushPass("Temporal stabilization");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_MV) );
+                    instance.PushInput( AsUint(Transient::DATA_2) );
+                    instance.PushInput( AsUint(Transient::TEMP_2) );
+                    instance.PushInput( AsUint(Transient::HISTORY) );
+                    instance.PushInput( AsUint(Transient::SMOOTHED_TILES) );
+
+                    instance.PushOutput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+
+                    instance.AddDispatch( SIGMA_ShadowTranslucency_TemporalStabilization, SIGMA_TemporalStabilization, 1 );
+                }
+                break;
+            }
+
+            case SigmaPass::SPLIT_SCREEN:
+            {
+                instance.PushPass("Split screen");
+                {
+                    instance.PushInput( AsUint(ResourceType::IN_VIEWZ) );
+                    instance.PushInput( AsUint(ResourceType::IN_PENUMBRA) );
+                    instance.PushInput( AsUint(ResourceType::IN_TRANSLUCENCY) );
+
+                    instance.PushOutput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
+
+                    instance.AddDispatch( SIGMA_ShadowTranslucency_SplitScreen, SIGMA_SplitScreen, 1 );
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    };
+
+    #undef DENOISER_NAME
+}
+
+void nrd::InstanceImpl::Add_SigmaShadowTranslucency(nrd::DenoiserData& denoiserData)
+{
+    denoiserData.settings.sigma = SigmaSettings();
+    denoiserData.settingsSize = sizeof(denoiserData.settings.sigma);
+
+    // In "SigmaShadowTranslucency::Transient" order
     AddTextureToTransientPool( {Format::R16_SFLOAT, 1} );
     AddTextureToTransientPool( {Format::R16_SFLOAT, 1} );
     AddTextureToTransientPool( {Format::RGBA8_UNORM, 1} );
@@ -34,85 +150,5 @@ void nrd::InstanceImpl::Add_SigmaShadowTranslucency(nrd::DenoiserData& denoiserD
     AddTextureToTransientPool( {Format::RGBA8_UNORM, 16} );
     AddTextureToTransientPool( {Format::RG8_UNORM, 16} );
 
-    PushPass("Classify tiles");
-    {
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_PENUMBRA) );
-        PushInput( AsUint(ResourceType::IN_TRANSLUCENCY) );
-
-        PushOutput( AsUint(Transient::TILES) );
-
-        AddDispatch( SIGMA_ShadowTranslucency_ClassifyTiles, SIGMA_ClassifyTiles, 1 );
-    }
-
-    PushPass("Smooth tiles");
-    {
-        PushInput( AsUint(Transient::TILES) );
-
-        PushOutput( AsUint(Transient::SMOOTHED_TILES) );
-
-        AddDispatch( SIGMA_Shadow_SmoothTiles, SIGMA_SmoothTiles, 16 );
-    }
-
-    PushPass("Blur");
-    {
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-        PushInput( AsUint(ResourceType::IN_PENUMBRA) );
-        PushInput( AsUint(Transient::SMOOTHED_TILES) );
-        PushInput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
-        PushInput( AsUint(ResourceType::IN_TRANSLUCENCY) );
-
-        PushOutput( AsUint(Transient::DATA_1) );
-        PushOutput( AsUint(Transient::TEMP_1) );
-        PushOutput( AsUint(Transient::HISTORY) );
-
-        AddDispatch( SIGMA_ShadowTranslucency_Blur, SIGMA_Blur, USE_MAX_DIMS );
-    }
-
-    for (int i = 0; i < SIGMA_POST_BLUR_PERMUTATION_NUM; i++)
-    {
-        bool isStabilizationEnabled = ( ( ( i >> 0 ) & 0x1 ) != 0 );
-
-        PushPass("Post-blur");
-        {
-            PushInput( AsUint(ResourceType::IN_VIEWZ) );
-            PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) );
-            PushInput( AsUint(Transient::DATA_1) );
-            PushInput( AsUint(Transient::SMOOTHED_TILES) );
-            PushInput( AsUint(Transient::TEMP_1) );
-
-            PushOutput( AsUint(Transient::DATA_2) );
-            PushOutput( isStabilizationEnabled ? AsUint(Transient::TEMP_2) : AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
-
-            AddDispatch( SIGMA_ShadowTranslucency_PostBlur, SIGMA_Blur, 1 );
-        }
-    }
-
-    PushPass("Temporal stabilization");
-    {
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_MV) );
-        PushInput( AsUint(Transient::DATA_2) );
-        PushInput( AsUint(Transient::TEMP_2) );
-        PushInput( AsUint(Transient::HISTORY) );
-        PushInput( AsUint(Transient::SMOOTHED_TILES) );
-
-        PushOutput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
-
-        AddDispatch( SIGMA_ShadowTranslucency_TemporalStabilization, SIGMA_TemporalStabilization, 1 );
-    }
-
-    PushPass("Split screen");
-    {
-        PushInput( AsUint(ResourceType::IN_VIEWZ) );
-        PushInput( AsUint(ResourceType::IN_PENUMBRA) );
-        PushInput( AsUint(ResourceType::IN_TRANSLUCENCY) );
-
-        PushOutput( AsUint(ResourceType::OUT_SHADOW_TRANSLUCENCY) );
-
-        AddDispatch( SIGMA_ShadowTranslucency_SplitScreen, SIGMA_SplitScreen, 1 );
-    }
-
-    #undef DENOISER_NAME
+    AddPasses<SigmaPass, g_SigmaPasses, SigmaShadowTranslucency::AddPass>();
 }
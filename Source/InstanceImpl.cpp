@@ -10,8 +10,10 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "../Shaders/Include/NRD.hlsli"
 #include "InstanceImpl.h"
+#include "TileCompaction.h"
 
 #include <assert.h> // assert
+#include <algorithm> // rotate, lower_bound
 #include <array>
 
 constexpr std::array<nrd::Sampler, (size_t)nrd::Sampler::MAX_NUM> g_Samplers =
@@ -86,21 +88,24 @@ constexpr std::array<bool, (size_t)nrd::Format::MAX_NUM> g_IsIntegerFormat =
     #include "Clear_Uint.cs.spirv.h"
 #endif
 
-inline bool IsInList(nrd::Identifier identifier, const nrd::Identifier* identifiers, uint32_t identifiersNum)
-{
-    for (uint32_t i = 0; i < identifiersNum; i++)
-    {
-        if (identifiers[i] == identifier)
-            return true;
-    }
-
-    return false;
-}
-
 nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreationDesc)
 {
     const LibraryDesc& libraryDesc = GetLibraryDesc();
 
+    m_ResourceDescriptorHeapOffset = instanceCreationDesc.resourceDescriptorHeapOffset;
+    m_SamplerDescriptorHeapOffset = instanceCreationDesc.samplerDescriptorHeapOffset;
+    m_IsGuideSharingEnabled = instanceCreationDesc.enableGuideSharing;
+
+    // Identifier to denoiser index map (load factor <= 0.5)
+    size_t identifierSlotsNum = 1;
+    while (identifierSlotsNum < instanceCreationDesc.denoisersNum * 2)
+        identifierSlotsNum <<= 1;
+
+    m_IdentifierSlots.resize(identifierSlotsNum, {0, INVALID_INDEX});
+    m_PipelineSlots.resize(64, INVALID_INDEX);
+    m_ClearResourceSlots.resize(64, INVALID_INDEX);
+    m_ActiveDenoisers.resize((instanceCreationDesc.denoisersNum + 63) / 64, 0);
+
     // Collect dispatches from all denoisers
     for (uint32_t i = 0; i < instanceCreationDesc.denoisersNum; i++)
     {
@@ -116,23 +121,35 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
         if (j == libraryDesc.supportedDenoisersNum)
             return Result::UNSUPPORTED;
 
+        // Check number of layers (layered REBLUR / RELAX, for example for stereo, is not implemented)
+        if (denoiserDesc.denoiser == Denoiser::SIGMA_SHADOW_ARRAY && (denoiserDesc.layersNum == 0 || denoiserDesc.layersNum > SIGMA_MAX_LAYERS_NUM))
+            return Result::INVALID_ARGUMENT;
+        if (denoiserDesc.denoiser != Denoiser::SIGMA_SHADOW_ARRAY && denoiserDesc.layersNum != 0)
+            return Result::UNSUPPORTED;
+
         // Check that identifier is unique
-        for (j = 0; j < instanceCreationDesc.denoisersNum; j++)
+        uint32_t mask = (uint32_t)identifierSlotsNum - 1;
+        for (j = (denoiserDesc.identifier * 2654435761u) & mask; m_IdentifierSlots[j].denoiserIndex != INVALID_INDEX; j = (j + 1) & mask)
         {
-            if (i != j && instanceCreationDesc.denoisers[j].identifier == denoiserDesc.identifier)
+            if (m_IdentifierSlots[j].identifier == denoiserDesc.identifier)
                 return Result::NON_UNIQUE_IDENTIFIER;
         }
 
+        m_IdentifierSlots[j] = {denoiserDesc.identifier, i};
+
         // Append dispatches for the current denoiser
         m_PermanentPoolOffset = (uint16_t)m_PermanentPool.size();
         m_TransientPoolOffset = (uint16_t)m_TransientPool.size();
+        m_IndirectArgumentsPoolOffset = m_IndirectArgumentsPoolSize;
 
         m_IndexRemap.clear();
+        m_DisabledFeatures = denoiserDesc.disabledFeatures;
 
         DenoiserData denoiserData = {};
         denoiserData.desc = denoiserDesc;
         denoiserData.dispatchOffset = m_Dispatches.size();
         denoiserData.pingPongOffset = m_PingPongs.size();
+        denoiserData.clearResourceOffset = m_ClearResources.size();
 
         size_t resourceOffset = m_Resources.size();
 
@@ -172,6 +189,8 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
             Add_SigmaShadow(denoiserData);
         else if (denoiserDesc.denoiser == Denoiser::SIGMA_SHADOW_TRANSLUCENCY)
             Add_SigmaShadowTranslucency(denoiserData);
+        else if (denoiserDesc.denoiser == Denoiser::SIGMA_SHADOW_ARRAY)
+            Add_SigmaShadowArray(denoiserData);
         else if (denoiserDesc.denoiser == Denoiser::REFERENCE)
             Add_Reference(denoiserData);
         else // Should not be here
@@ -179,6 +198,9 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
 
         denoiserData.pingPongNum = m_PingPongs.size() - denoiserData.pingPongOffset;
 
+        // Transient textures with non-overlapping lifetimes share memory
+        AliasTransientPool(denoiserData, resourceOffset);
+
         // Patch identifiers
         for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < m_Dispatches.size(); dispatchIndex++)
         {
@@ -199,20 +221,12 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
             if (resource.type == ResourceType::OUT_VALIDATION)
                 continue;
 
-            // Keep only unique instances
-            bool isFound = false;
-            for (const ClearResource& temp : m_ClearResources)
-            {
-                if (temp.resource.descriptorType == resource.descriptorType &&
-                    temp.resource.type == resource.type &&
-                    temp.resource.indexInPool == resource.indexInPool)
-                {
-                    isFound = true;
-                    break;
-                }
-            }
+            // Skip texture arrays, "Clear" shaders are not layered (SIGMA_SHADOW_ARRAY history is not read after a reset anyway)
+            if (resource.isArray)
+                continue;
 
-            if (!isFound)
+            // Keep only unique instances
+            if (!HasClearResource(resource))
             {
                 // Is integer?
                 bool isInteger = false;
@@ -225,7 +239,7 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
                 }
 
                 // Add PING resource
-                m_ClearResources.push_back( {denoiserDesc.identifier, resource, downsampleFactor, isInteger} );
+                AddClearResource( {denoiserDesc.identifier, resource, downsampleFactor, isInteger} );
 
                 // Add PONG resource
                 for (uint32_t p = 0; p < denoiserData.pingPongNum; p++)
@@ -234,39 +248,120 @@ nrd::Result nrd::InstanceImpl::Create(const InstanceCreationDesc& instanceCreati
                     if (pingPong.resourceIndex == (uint32_t)resourceIndex)
                     {
                         ResourceDesc resourcePong = {resource.descriptorType, resource.type, pingPong.indexInPoolToSwapWith};
-                        m_ClearResources.push_back( {denoiserDesc.identifier, resourcePong, downsampleFactor, isInteger} );
+                        AddClearResource( {denoiserDesc.identifier, resourcePong, downsampleFactor, isInteger} );
                         break;
                     }
                 }
             }
         }
 
+        denoiserData.clearResourceNum = m_ClearResources.size() - denoiserData.clearResourceOffset;
+
         m_DenoiserData.push_back(denoiserData);
     }
 
+    // Identical previous-frame guides of different denoisers become shared
+    if (m_IsGuideSharingEnabled)
+        SharePrevGuides();
+
     // Add "clear" dispatches
+    m_DisabledFeatures = 0;
+
     m_DispatchClearIndex[0] = m_Dispatches.size();
     _PushPass("Clear (f)");
     {
-        PushOutput(0);
-        AddDispatchNoConstants( Clear_Float, Clear_Float, 1 );
+        for (uint32_t i = 0; i < Clear_FloatOutputNum; i++)
+            PushOutput(0);
+
+        AddDispatch( Clear_Float, Clear_Float, 1 );
     }
 
     m_DispatchClearIndex[1] = m_Dispatches.size();
     _PushPass("Clear (ui)");
     {
-        PushOutput(0);
-        AddDispatchNoConstants( Clear_Uint, Clear_Uint, 1 );
+        for (uint32_t i = 0; i < Clear_UintOutputNum; i++)
+            PushOutput(0);
+
+        AddDispatch( Clear_Uint, Clear_Uint, 1 );
     }
 
+    m_ClearBatchResources.reserve(m_ClearResources.size());
+
     PrepareDesc();
 
+    // Worst case constant footprint: each dispatch can be emitted up to "maxRepeatsNum" times per frame,
+    // plus a block for shared constants per denoiser
+    size_t constantDataSize = m_DenoiserData.size() * m_Desc.constantBufferMaxDataSize;
+    for (const InternalDispatchDesc& internalDispatchDesc : m_Dispatches)
+        constantDataSize += internalDispatchDesc.constantBufferDataSize * internalDispatchDesc.maxRepeatsNum;
+
+    // Each clear batch is a dispatch. Worst case: each denoiser gets a partially filled batch per format class
+    size_t clearBatchMaxNum = m_ClearResources.size() / Clear_FloatOutputNum + m_DenoiserData.size() * 2;
+    for (size_t dispatchClearIndex : m_DispatchClearIndex)
+        constantDataSize += m_Dispatches[dispatchClearIndex].constantBufferDataSize * clearBatchMaxNum;
+
+    AllocateConstantData(constantDataSize);
+    InitFrameSlots(instanceCreationDesc.framesInFlightNum);
+
     // IMPORTANT: since now all std::vectors become "locked" (no reallocations)
 
     return Result::SUCCESS;
 }
 
+nrd::Result nrd::InstanceImpl::CreateFrameContext(const InstanceImpl& instanceImpl)
+{
+    // Immutable state (resources, pipelines and dispatches)
+    m_DenoiserData.assign(instanceImpl.m_DenoiserData.begin(), instanceImpl.m_DenoiserData.end());
+    m_PermanentPool.assign(instanceImpl.m_PermanentPool.begin(), instanceImpl.m_PermanentPool.end());
+    m_TransientPool.assign(instanceImpl.m_TransientPool.begin(), instanceImpl.m_TransientPool.end());
+    m_TransientPoolKinds.assign(instanceImpl.m_TransientPoolKinds.begin(), instanceImpl.m_TransientPoolKinds.end());
+    m_Resources.assign(instanceImpl.m_Resources.begin(), instanceImpl.m_Resources.end());
+    m_ClearResources.assign(instanceImpl.m_ClearResources.begin(), instanceImpl.m_ClearResources.end());
+    m_PingPongs.assign(instanceImpl.m_PingPongs.begin(), instanceImpl.m_PingPongs.end());
+    m_PrevGuideGroups.assign(instanceImpl.m_PrevGuideGroups.begin(), instanceImpl.m_PrevGuideGroups.end());
+    m_PrevGuideResources.assign(instanceImpl.m_PrevGuideResources.begin(), instanceImpl.m_PrevGuideResources.end());
+    m_ResourceRanges.assign(instanceImpl.m_ResourceRanges.begin(), instanceImpl.m_ResourceRanges.end());
+    m_Pipelines.assign(instanceImpl.m_Pipelines.begin(), instanceImpl.m_Pipelines.end());
+    m_Dispatches.assign(instanceImpl.m_Dispatches.begin(), instanceImpl.m_Dispatches.end());
+    m_IdentifierSlots.assign(instanceImpl.m_IdentifierSlots.begin(), instanceImpl.m_IdentifierSlots.end());
+    m_ActiveDenoisers.assign(instanceImpl.m_ActiveDenoisers.begin(), instanceImpl.m_ActiveDenoisers.end());
+    m_ClearBatchResources.reserve(instanceImpl.m_ClearBatchResources.capacity());
+
+    memcpy(m_DispatchClearIndex, instanceImpl.m_DispatchClearIndex, sizeof(m_DispatchClearIndex));
+    m_IndirectArgumentsPoolSize = instanceImpl.m_IndirectArgumentsPoolSize;
+    m_ResourceDescriptorHeapOffset = instanceImpl.m_ResourceDescriptorHeapOffset;
+    m_SamplerDescriptorHeapOffset = instanceImpl.m_SamplerDescriptorHeapOffset;
+    m_IsGuideSharingEnabled = instanceImpl.m_IsGuideSharingEnabled;
+
+    // Mutable state, which must survive (derived state gets recomputed in "SetCommonSettings")
+    m_CommonSettings = instanceImpl.m_CommonSettings;
+    m_PrevGuideParity = instanceImpl.m_PrevGuideParity;
+    m_AccumulatedFrameNum = instanceImpl.m_AccumulatedFrameNum;
+    m_IsFirstUse = instanceImpl.m_IsFirstUse;
+
+    // Pointers must be turned back into offsets, "PrepareDesc" will patch them
+    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
+        dispatchDesc.resources = (ResourceDesc*)(dispatchDesc.resources - instanceImpl.m_Resources.data());
+
+    for (PipelineDesc& pipelineDesc : m_Pipelines)
+        pipelineDesc.resourceRanges = (ResourceRangeDesc*)(pipelineDesc.resourceRanges - instanceImpl.m_ResourceRanges.data());
+
+    PrepareDesc();
+    AllocateConstantData(instanceImpl.m_ConstantDataSize);
+    InitFrameSlots(instanceImpl.m_FrameSlots.size());
+
+    return Result::SUCCESS;
+}
+
 nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSettings)
+{
+    m_ViewIndex = 0;
+    UpdateCommonSettings(commonSettings, true);
+
+    return Result::SUCCESS;
+}
+
+void nrd::InstanceImpl::UpdateCommonSettings(const CommonSettings& commonSettings, bool isNewFrame)
 {
     // TODO: matrix verifications? return INVALID_ARGUMENT?
     assert("'viewZScale' can't be <= 0" && commonSettings.viewZScale > 0.0f);
@@ -281,6 +376,15 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     assert("'disocclusionThreshold' must be > 0" && commonSettings.disocclusionThreshold > 0.0f);
     assert("'disocclusionThresholdAlternate' must be > 0" && commonSettings.disocclusionThresholdAlternate > 0.0f);
 
+    // Projections usually don't change from frame to frame, derived state gets recomputed only if needed (tracked per view)
+    if (m_ViewIndex >= m_ViewProjections.size())
+        m_ViewProjections.resize(m_ViewIndex + 1, {});
+
+    ViewProjection& viewProjection = m_ViewProjections[m_ViewIndex];
+    bool isProjectionChanged = !viewProjection.isValid
+        || memcmp(viewProjection.viewToClipMatrix, commonSettings.viewToClipMatrix, sizeof(commonSettings.viewToClipMatrix)) != 0
+        || memcmp(viewProjection.viewToClipMatrixPrev, commonSettings.viewToClipMatrixPrev, sizeof(commonSettings.viewToClipMatrixPrev)) != 0;
+
     memcpy(&m_CommonSettings, &commonSettings, sizeof(commonSettings));
 
     // Rotators (respecting sample patterns symmetry)
@@ -292,21 +396,36 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     m_Rotator_PostBlur = Geometry::GetRotator(angle2 + radians(45.0f));
 
     // Main matrices
-    m_ViewToClip = float4x4
-    (
-        float4(m_CommonSettings.viewToClipMatrix),
-        float4(m_CommonSettings.viewToClipMatrix + 4),
-        float4(m_CommonSettings.viewToClipMatrix + 8),
-        float4(m_CommonSettings.viewToClipMatrix + 12)
-    );
-
-    m_ViewToClipPrev = float4x4
-    (
-        float4(m_CommonSettings.viewToClipMatrixPrev),
-        float4(m_CommonSettings.viewToClipMatrixPrev + 4),
-        float4(m_CommonSettings.viewToClipMatrixPrev + 8),
-        float4(m_CommonSettings.viewToClipMatrixPrev + 12)
-    );
+    if (isProjectionChanged)
+    {
+        m_ViewToClip = float4x4
+        (
+            float4(m_CommonSettings.viewToClipMatrix),
+            float4(m_CommonSettings.viewToClipMatrix + 4),
+            float4(m_CommonSettings.viewToClipMatrix + 8),
+            float4(m_CommonSettings.viewToClipMatrix + 12)
+        );
+
+        m_ViewToClipPrev = float4x4
+        (
+            float4(m_CommonSettings.viewToClipMatrixPrev),
+            float4(m_CommonSettings.viewToClipMatrixPrev + 4),
+            float4(m_CommonSettings.viewToClipMatrixPrev + 8),
+            float4(m_CommonSettings.viewToClipMatrixPrev + 12)
+        );
+    }
+    else
+    {
+        m_ViewToClip = viewProjection.viewToClip;
+        m_ViewToClipPrev = viewProjection.viewToClipPrev;
+        m_ClipToView = viewProjection.clipToView;
+        m_ClipToViewPrev = viewProjection.clipToViewPrev;
+        m_Frustum = viewProjection.frustum;
+        m_FrustumPrev = viewProjection.frustumPrev;
+        m_ProjectY = viewProjection.projectY;
+        m_OrthoMode = viewProjection.orthoMode;
+        m_IsLeftHanded = viewProjection.isLeftHanded;
+    }
 
     m_WorldToView = float4x4
     (
@@ -333,6 +452,7 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     );
 
     // There are many cases, where history buffers contain garbage - handle at least one of them internally
+    bool isFirstUse = m_IsFirstUse;
     if (m_IsFirstUse)
     {
         m_CommonSettings.accumulationMode = AccumulationMode::CLEAR_AND_RESTART;
@@ -341,15 +461,51 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
         m_IsFirstUse = false;
     }
 
-    // Convert to LH
-    uint32_t flags = 0;
-    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.a, nullptr, nullptr);
-
-    if ( !(flags & PROJ_LEFT_HANDED) )
+    if (isProjectionChanged)
     {
-        m_ViewToClip.col2 = -m_ViewToClip[2];
-        m_ViewToClipPrev.col2 = -m_ViewToClipPrev[2];
+        // Convert to LH
+        uint32_t flags = 0;
+        DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, nullptr, nullptr, m_Frustum.a, nullptr, nullptr);
+
+        m_IsLeftHanded = (flags & PROJ_LEFT_HANDED) != 0;
+        if (!m_IsLeftHanded)
+        {
+            m_ViewToClip.col2 = -m_ViewToClip[2];
+            m_ViewToClipPrev.col2 = -m_ViewToClipPrev[2];
+        }
+
+        m_ClipToView = m_ViewToClip;
+        m_ClipToView.Invert();
+
+        m_ClipToViewPrev = m_ViewToClipPrev;
+        m_ClipToViewPrev.Invert();
+
+        float project[3];
+        float settings[PROJ_NUM];
+        DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, settings, nullptr, m_Frustum.a, project, nullptr);
+        m_ProjectY = project[1];
+        m_OrthoMode = (flags & PROJ_ORTHO) ? -1.0f : 0.0f;
+
+        DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClipPrev, &flags, nullptr, nullptr, m_FrustumPrev.a, nullptr, nullptr);
+
+        memcpy(viewProjection.viewToClipMatrix, commonSettings.viewToClipMatrix, sizeof(commonSettings.viewToClipMatrix));
+        memcpy(viewProjection.viewToClipMatrixPrev, commonSettings.viewToClipMatrixPrev, sizeof(commonSettings.viewToClipMatrixPrev));
+        viewProjection.viewToClip = m_ViewToClip;
+        viewProjection.viewToClipPrev = m_ViewToClipPrev;
+        viewProjection.clipToView = m_ClipToView;
+        viewProjection.clipToViewPrev = m_ClipToViewPrev;
+        viewProjection.frustum = m_Frustum;
+        viewProjection.frustumPrev = m_FrustumPrev;
+        viewProjection.projectY = m_ProjectY;
+        viewProjection.orthoMode = m_OrthoMode;
+        viewProjection.isLeftHanded = m_IsLeftHanded;
+
+        // The previous projection was replaced by the current one on the first use
+        viewProjection.isValid = !isFirstUse;
+    }
 
+    if (!m_IsLeftHanded)
+    {
         m_WorldToView.Transpose();
         m_WorldToView.col2 = -m_WorldToView[2];
         m_WorldToView.Transpose();
@@ -382,33 +538,20 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     m_WorldToClip = m_ViewToClip * m_WorldToView;
     m_WorldToClipPrev = m_ViewToClipPrev * m_WorldToViewPrev;
 
-    m_ClipToWorldPrev = m_WorldToClipPrev;
-    m_ClipToWorldPrev.Invert();
-
-    m_ClipToView = m_ViewToClip;
-    m_ClipToView.Invert();
-
-    m_ClipToViewPrev = m_ViewToClipPrev;
-    m_ClipToViewPrev.Invert();
-
-    m_ClipToWorld = m_WorldToClip;
-    m_ClipToWorld.Invert();
-
-    float project[3];
-    float settings[PROJ_NUM];
-    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClip, &flags, settings, nullptr, m_Frustum.a, project, nullptr);
-    m_ProjectY = project[1];
-    m_OrthoMode = (flags & PROJ_ORTHO) ? -1.0f : 0.0f;
-
-    DecomposeProjection(STYLE_D3D, STYLE_D3D, m_ViewToClipPrev, &flags, nullptr, nullptr, m_FrustumPrev.a, nullptr, nullptr);
+    // Inverses of products come from already known inverses (view matrices are orthogonal)
+    m_ClipToWorld = m_ViewToWorld * m_ClipToView;
+    m_ClipToWorldPrev = m_ViewToWorldPrev * m_ClipToViewPrev;
 
     m_ViewDirection = -float3(m_ViewToWorld[2]);
     m_ViewDirectionPrev = -float3(m_ViewToWorldPrev[2]);
 
     m_CameraDelta = float3(translationDelta.x, translationDelta.y, translationDelta.z);
 
-    m_Timer.UpdateElapsedTimeSinceLastSave();
-    m_Timer.SaveCurrentTime();
+    if (isNewFrame)
+    {
+        m_Timer.UpdateElapsedTimeSinceLastSave();
+        m_Timer.SaveCurrentTime();
+    }
 
     m_TimeDelta = m_CommonSettings.timeDeltaBetweenFrames > 0.0f ? m_CommonSettings.timeDeltaBetweenFrames : m_Timer.GetSmoothedElapsedTime();
     m_FrameRateScale = max(33.333f / m_TimeDelta, 1.0f);
@@ -420,277 +563,1488 @@ nrd::Result nrd::InstanceImpl::SetCommonSettings(const CommonSettings& commonSet
     float FPS = m_FrameRateScale * 30.0f;
     float nonLinearAccumSpeed = FPS * 0.25f / (1.0f + FPS * 0.25f);
     m_CheckerboardResolveAccumSpeed = lerp(nonLinearAccumSpeed, 0.5f, m_JitterDelta);
-
-    return Result::SUCCESS;
 }
 
 nrd::Result nrd::InstanceImpl::SetDenoiserSettings(Identifier identifier, const void* denoiserSettings)
 {
-    for (DenoiserData& denoiserData : m_DenoiserData)
-    {
-        if (denoiserData.desc.identifier == identifier)
-        {
-            memcpy(&denoiserData.settings, denoiserSettings, denoiserData.settingsSize);
+    uint32_t denoiserIndex = GetDenoiserIndex(identifier);
+    if (denoiserIndex == INVALID_INDEX)
+        return Result::INVALID_ARGUMENT;
 
-            return Result::SUCCESS;
-        }
-    }
+    DenoiserData& denoiserData = m_DenoiserData[denoiserIndex];
+    memcpy(&denoiserData.settings, denoiserSettings, denoiserData.settingsSize);
 
-    return Result::INVALID_ARGUMENT;
+    return Result::SUCCESS;
 }
 
 nrd::Result nrd::InstanceImpl::GetComputeDispatches(const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
 {
-    m_ConstantDataOffset = 0;
-    m_ActiveDispatches.clear();
-
     // Trivial checks
     if (!identifiers || !identifiersNum)
     {
+        m_ConstantDataOffset = 0;
+        m_ActiveDispatches.clear();
+        m_IsFramePlanValid = false;
+        m_FramePlanParity = 0;
+        m_BarrierPlanMask = 0;
+        m_DependencyPlanMask = 0;
+
         dispatchDescs = nullptr;
         dispatchDescsNum = 0;
 
         return !identifiersNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
     }
 
-    // Inject "clear" calls if needed
-    if (m_CommonSettings.accumulationMode == AccumulationMode::CLEAR_AND_RESTART)
-    {
-        for (const ClearResource& clearResource : m_ClearResources)
-        {
-            // If current denoiser is in list
-            if (!IsInList(clearResource.identifier, identifiers, identifiersNum))
-                continue;
-
-            // Add a clear dispatch
-            const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[ m_DispatchClearIndex[clearResource.isInteger ? 1 : 0] ];
+    // Reuse the frame plan if nothing affecting permutations, dispatch sizes or settings has changed. Calls with the same key swap
+    // the same ping-pong resources, so a plan (of any frame slot) stays valid only while the key doesn't change
+    bool isCacheable = m_CommonSettings.accumulationMode == AccumulationMode::CONTINUE;
+    if (isCacheable)
+        GetFramePlanKey(identifiers, identifiersNum);
+    else
+        m_FramePlanKey.clear();
 
-            uint16_t w = DivideUp(m_CommonSettings.resourceSize[0], clearResource.downsampleFactor);
-            uint16_t h = DivideUp(m_CommonSettings.resourceSize[1], clearResource.downsampleFactor);
+    bool isSameKey = m_FramePlanKey.size() == m_FramePlanKeyPrev.size() && !memcmp(m_FramePlanKey.data(), m_FramePlanKeyPrev.data(), m_FramePlanKey.size());
 
-            DispatchDesc dispatchDesc = {};
-            dispatchDesc.name = internalDispatchDesc.name;
-            dispatchDesc.identifier = clearResource.identifier;
-            dispatchDesc.resources = &clearResource.resource;
-            dispatchDesc.resourcesNum = 1;
-            dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
-            dispatchDesc.gridWidth = DivideUp(w, internalDispatchDesc.numThreads.width);
-            dispatchDesc.gridHeight = DivideUp(h, internalDispatchDesc.numThreads.height);
+    // Validation happens before any state change. The key of the previous call has already been validated (rejected calls don't store keys)
+    if (!isCacheable || !isSameKey)
+    {
+        ViewDesc viewDesc = {&m_CommonSettings, identifiers, identifiersNum};
+        if (!ValidateViews(&viewDesc, 1))
+        {
+            dispatchDescs = nullptr;
+            dispatchDescsNum = 0;
 
-            m_ActiveDispatches.push_back(dispatchDesc);
+            return Result::INVALID_ARGUMENT;
         }
     }
 
-    // Collect dispatches for requested denoisers
-    for (const DenoiserData& denoiserData : m_DenoiserData)
+    // All frames are in flight
+    if (!AcquireFrameSlot())
     {
-        // If current denoiser is in list
-        if (!IsInList(denoiserData.desc.identifier, identifiers, identifiersNum))
-            continue;
-
-        // Update denoiser and gather dispatches
-        UpdatePingPong(denoiserData);
+        dispatchDescs = nullptr;
+        dispatchDescsNum = 0;
 
-        if (denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SH ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR_SH ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_SH ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
-            Update_Reblur(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_OCCLUSION ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR_OCCLUSION ||
-            denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_OCCLUSION)
-            Update_ReblurOcclusion(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE || denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SH ||
-            denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR || denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR_SH ||
-            denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR || denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
-            Update_Relax(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW || denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW_TRANSLUCENCY)
-            Update_SigmaShadow(denoiserData);
-        else if (denoiserData.desc.denoiser == Denoiser::REFERENCE)
-            Update_Reference(denoiserData);
+        return Result::FAILURE;
     }
 
-    dispatchDescs = m_ActiveDispatches.data();
-    dispatchDescsNum = (uint32_t)m_ActiveDispatches.size();
+    UpdatePrevGuides();
 
-    return dispatchDescsNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
-}
+    if (!isCacheable || !isSameKey)
+        m_FramePlanRunStart = m_CallIndex;
 
-void nrd::InstanceImpl::AddComputeDispatchDesc
-(
-    NumThreads numThreads,
-    uint16_t downsampleFactor,
-    uint32_t constantBufferDataSize,
-    uint32_t maxRepeatNum,
-    const char* shaderFileName,
-    const ComputeShaderDesc& dxbc,
-    const ComputeShaderDesc& dxil,
-    const ComputeShaderDesc& spirv
-)
-{
-    // Pipeline (unique only)
-    size_t pipelineIndex = 0;
-    for (; pipelineIndex < m_Pipelines.size(); pipelineIndex++)
+    m_FramePlanKey.swap(m_FramePlanKeyPrev);
+
+    bool isFramePlanReused = isCacheable && m_IsFramePlanValid && m_FramePlanCallIndex >= m_FramePlanRunStart;
+    if (isFramePlanReused)
     {
-        const PipelineDesc& pipeline = m_Pipelines[pipelineIndex];
+        ReplayFramePlan();
 
-        if (!strcmp(pipeline.shaderFileName, shaderFileName))
-            break;
+        // Ping-pong resources have been swapped by each call since the plan was used
+        m_FramePlanParity ^= uint32_t(m_CallIndex - m_FramePlanCallIndex) & 1;
     }
-
-    if (pipelineIndex == m_Pipelines.size())
+    else
     {
-        PipelineDesc pipelineDesc = {};
-        pipelineDesc.shaderFileName = shaderFileName;
-        pipelineDesc.shaderEntryPointName = NRD_STRINGIFY(NRD_CS_MAIN);
-        pipelineDesc.computeShaderDXBC = dxbc;
-        pipelineDesc.computeShaderDXIL = dxil;
-        pipelineDesc.computeShaderSPIRV = spirv;
-        pipelineDesc.resourceRanges = (ResourceRangeDesc*)m_ResourceRanges.size();
-        pipelineDesc.hasConstantData = constantBufferDataSize != 0;
+        ResetFramePlan();
+        AddViewDispatches(identifiers, identifiersNum, isCacheable);
 
-        for (size_t r = 0; r < 2; r++)
-        {
-            ResourceRangeDesc descriptorRange = {};
-            descriptorRange.descriptorType = r == 0 ? DescriptorType::TEXTURE : DescriptorType::STORAGE_TEXTURE;
-
-            for (size_t i = m_ResourceOffset; i < m_Resources.size(); i++ )
-            {
-                const ResourceDesc& resource = m_Resources[i];
-                if (descriptorRange.descriptorType == resource.descriptorType)
-                    descriptorRange.descriptorsNum++;
-            }
+        m_IsFramePlanValid = isCacheable;
+    }
 
-            if (descriptorRange.descriptorsNum != 0)
-            {
-                m_ResourceRanges.push_back(descriptorRange);
-                pipelineDesc.resourceRangesNum++;
-            }
-        }
+    m_FramePlanCallIndex = m_CallIndex++;
 
-        m_Pipelines.push_back( pipelineDesc );
-    }
+    // Shared previous-frame guides get swapped
+    m_PrevGuideParity ^= 1;
 
-    // Dispatch
-    InternalDispatchDesc computeDispatchDesc = {};
-    computeDispatchDesc.name = m_PassName;
-    computeDispatchDesc.pipelineIndex = (uint16_t)pipelineIndex;
-    computeDispatchDesc.downsampleFactor = downsampleFactor;
-    computeDispatchDesc.maxRepeatsNum = (uint16_t)maxRepeatNum;
-    computeDispatchDesc.constantBufferDataSize = constantBufferDataSize;
-    computeDispatchDesc.resourcesNum = uint32_t(m_Resources.size() - m_ResourceOffset);
-    computeDispatchDesc.resources = (ResourceDesc*)m_ResourceOffset;
-    computeDispatchDesc.numThreads = numThreads;
+    FinalizeDispatches(isFramePlanReused);
+    PublishDispatches(dispatchDescs, dispatchDescsNum);
 
-    m_Dispatches.push_back(computeDispatchDesc);
+    return dispatchDescsNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
 }
 
-void nrd::InstanceImpl::PrepareDesc()
+nrd::Result nrd::InstanceImpl::GetComputeDispatchesMultiView(const ViewDesc* viewDescs, uint32_t viewDescsNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
 {
-    m_Desc = {};
+    dispatchDescs = nullptr;
+    dispatchDescsNum = 0;
 
-    m_Desc.constantBufferRegisterIndex = NRD_CONSTANT_BUFFER_REGISTER_INDEX;
-    m_Desc.constantBufferSpaceIndex = NRD_CONSTANT_BUFFER_SPACE_INDEX;
+    // Validation happens before any state change
+    if (!viewDescs || !viewDescsNum || !ValidateViews(viewDescs, viewDescsNum))
+        return Result::INVALID_ARGUMENT;
 
-    m_Desc.samplers = g_Samplers.data();
-    m_Desc.samplersNum = (uint32_t)g_Samplers.size();
-    m_Desc.samplersSpaceIndex = NRD_SAMPLERS_SPACE_INDEX;
-    m_Desc.samplersBaseRegisterIndex = 0;
+    // All frames are in flight
+    if (!AcquireFrameSlot())
+        return Result::FAILURE;
 
-    m_Desc.pipelines = m_Pipelines.data();
-    m_Desc.pipelinesNum = (uint32_t)m_Pipelines.size();
-    m_Desc.resourcesSpaceIndex = NRD_RESOURCES_SPACE_INDEX;
+    // Views get interleaved, so the frame plan can't be replayed (and plans of other frame slots become invalid)
+    ResetFramePlan();
+    UpdatePrevGuides();
 
-    m_Desc.permanentPool = m_PermanentPool.data();
-    m_Desc.permanentPoolSize = (uint32_t)m_PermanentPool.size();
+    m_FramePlanKeyPrev.clear();
+    m_FramePlanCallIndex = m_CallIndex++;
 
-    m_Desc.transientPool = m_TransientPool.data();
-    m_Desc.transientPoolSize = (uint32_t)m_TransientPool.size();
+    m_TransientPoolViews.assign(m_TransientPool.size(), INVALID_INDEX);
+    m_ViewDispatchOffsets.clear();
+    m_ViewDispatchOffsets.push_back(0);
 
-    const bool samplersAreInSeparateSet = NRD_SAMPLERS_SPACE_INDEX != NRD_CONSTANT_BUFFER_SPACE_INDEX && NRD_SAMPLERS_SPACE_INDEX != NRD_RESOURCES_SPACE_INDEX;
-    if (samplersAreInSeparateSet)
-        m_Desc.descriptorPoolDesc.samplersMaxNum += m_Desc.samplersNum;
+    bool isFirstUse = m_IsFirstUse;
+    bool isCacheable = false;
+    bool isInterleavable = true;
 
-    // Calculate descriptor heap (sets) requirements
-    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
+    m_ViewsNum = viewDescsNum;
+
+    for (uint32_t i = 0; i < viewDescsNum; i++)
     {
-        size_t textureOffset = (size_t)dispatchDesc.resources;
-        dispatchDesc.resources = &m_Resources[textureOffset];
+        const ViewDesc& viewDesc = viewDescs[i];
+        m_ViewIndex = i;
 
-        for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++)
+        // Per frame state (timer, first use) is advanced once for all views. Views sharing common settings (for example, several lights) reuse them
+        if (i == 0 || viewDesc.commonSettings != viewDescs[i - 1].commonSettings)
         {
-            const ResourceDesc& resource = dispatchDesc.resources[i];
-            if (resource.descriptorType == DescriptorType::TEXTURE)
-                m_Desc.descriptorPoolDesc.texturesMaxNum += dispatchDesc.maxRepeatsNum;
-            else if (resource.descriptorType == DescriptorType::STORAGE_TEXTURE)
-                m_Desc.descriptorPoolDesc.storageTexturesMaxNum += dispatchDesc.maxRepeatsNum;
+            m_IsFirstUse = isFirstUse;
+            UpdateCommonSettings(*viewDesc.commonSettings, i == 0);
         }
 
-        m_Desc.descriptorPoolDesc.setsMaxNum += dispatchDesc.maxRepeatsNum;
-
-        if (!samplersAreInSeparateSet)
-            m_Desc.descriptorPoolDesc.samplersMaxNum += dispatchDesc.maxRepeatsNum * m_Desc.samplersNum;
+        AddViewDispatches(viewDesc.identifiers, viewDesc.identifiersNum, isCacheable);
 
-        if (dispatchDesc.constantBufferDataSize != 0)
+        // Transient textures can be shared by denoisers of different views
+        for (size_t j = m_ViewDispatchOffsets.back(); j < m_ActiveDispatches.size(); j++)
         {
-            m_Desc.descriptorPoolDesc.constantBuffersMaxNum += dispatchDesc.maxRepeatsNum;
-            m_Desc.constantBufferMaxDataSize = max(dispatchDesc.constantBufferDataSize, m_Desc.constantBufferMaxDataSize);
-        }
-    }
+            const DispatchDesc& dispatchDesc = m_ActiveDispatches[j];
+            for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+            {
+                const ResourceDesc& resource = dispatchDesc.resources[r];
+                if (resource.type != ResourceType::TRANSIENT_POOL)
+                    continue;
 
-    // For potential clears
-    uint32_t clearNum = (uint32_t)m_ClearResources.size();
-    m_Desc.descriptorPoolDesc.storageTexturesMaxNum += clearNum;
-    m_Desc.descriptorPoolDesc.setsMaxNum += clearNum;
+                uint32_t& view = m_TransientPoolViews[resource.indexInPool];
+                if (view != INVALID_INDEX && view != i)
+                    isInterleavable = false;
 
-    if (!samplersAreInSeparateSet)
-        m_Desc.descriptorPoolDesc.samplersMaxNum += clearNum * m_Desc.samplersNum;
+                view = i;
+            }
+        }
 
-    // Assign resources
-    for (PipelineDesc& pipelineDesc : m_Pipelines)
+        m_ViewDispatchOffsets.push_back((uint32_t)m_ActiveDispatches.size());
+    }
+
+    // Views without shared resources get interleaved dispatch by dispatch: views with the same denoisers and settings produce the same
+    // sequence of passes, so dispatches using the same pipeline become adjacent. Otherwise views are processed one after another
+    if (isInterleavable)
     {
-        size_t descriptorRangeffset = (size_t)pipelineDesc.resourceRanges;
-        pipelineDesc.resourceRanges = &m_ResourceRanges[descriptorRangeffset];
+        m_ViewDispatches.clear();
+        for (size_t i = 0; m_ViewDispatches.size() != m_ActiveDispatches.size(); i++)
+        {
+            for (uint32_t j = 0; j < viewDescsNum; j++)
+            {
+                size_t dispatchIndex = m_ViewDispatchOffsets[j] + i;
+                if (dispatchIndex < m_ViewDispatchOffsets[j + 1])
+                    m_ViewDispatches.push_back(m_ActiveDispatches[dispatchIndex]);
+            }
+        }
+
+        m_ActiveDispatches.assign(m_ViewDispatches.begin(), m_ViewDispatches.end());
     }
 
-    // *= number of "spaces"
-    uint32_t descriptorSetNum = 1;
-    if (m_Desc.constantBufferSpaceIndex != m_Desc.samplersSpaceIndex)
-        descriptorSetNum++;
-    if (m_Desc.samplersSpaceIndex != m_Desc.resourcesSpaceIndex)
-        descriptorSetNum++;
+    // Shared previous-frame guides get swapped
+    m_PrevGuideParity ^= 1;
 
-    m_Desc.descriptorPoolDesc.setsMaxNum *= descriptorSetNum;
+    FinalizeDispatches(false);
+    PublishDispatches(dispatchDescs, dispatchDescsNum);
+
+    return dispatchDescsNum ? Result::SUCCESS : Result::INVALID_ARGUMENT;
 }
 
-void nrd::InstanceImpl::UpdatePingPong(const DenoiserData& denoiserData)
+nrd::Result nrd::InstanceImpl::ReleaseFrame(const DispatchDesc* dispatchDescs)
 {
-    for (uint32_t i = 0; i < denoiserData.pingPongNum; i++)
+    // Nothing to release
+    if (m_FrameSlots.empty() || !dispatchDescs)
+        return Result::SUCCESS;
+
+    for (uint32_t i = 0; i < (uint32_t)m_FrameSlots.size(); i++)
     {
-        PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
-        ResourceDesc& resource = m_Resources[pingPong.resourceIndex];
+        // Memory of the last used slot is held by the instance
+        FrameSlot& frameSlot = m_FrameSlots[i];
+        const DispatchDesc* frameSlotDispatchDescs = i == m_FrameSlotIndex ? m_ActiveDispatches.data() : frameSlot.dispatches.data();
 
-        Swap(resource.indexInPool, pingPong.indexInPoolToSwapWith);
+        if (frameSlot.isInFlight && frameSlotDispatchDescs == dispatchDescs)
+        {
+            frameSlot.isInFlight = false;
+            return Result::SUCCESS;
+        }
     }
+
+    return Result::INVALID_ARGUMENT;
 }
 
-void nrd::InstanceImpl::PushTexture(DescriptorType descriptorType, uint16_t localIndex, uint16_t indexToSwapWith)
+void nrd::InstanceImpl::InitFrameSlots(size_t frameSlotsNum)
 {
-    ResourceType resourceType = (ResourceType)localIndex;
-    uint16_t globalIndex = 0;
+    m_FrameSlots.clear();
+    m_FrameSlots.reserve(frameSlotsNum);
 
-    if (localIndex >= TRANSIENT_POOL_START)
+    // The first slot takes memory of the instance, others get their own (while swapped in, a slot holds memory of the instance)
+    for (size_t i = 0; i < frameSlotsNum; i++)
     {
-        resourceType = ResourceType::TRANSIENT_POOL;
-        globalIndex = m_IndexRemap[localIndex - TRANSIENT_POOL_START];
+        m_FrameSlots.push_back( FrameSlot(GetStdAllocator()) );
+        if (!i)
+            continue;
 
-        if (indexToSwapWith != uint16_t(-1))
-        {
-            assert(indexToSwapWith >= TRANSIENT_POOL_START && indexToSwapWith < PERMANENT_POOL_START);
+        FrameSlot& frameSlot = m_FrameSlots.back();
+        SwapFrameSlot(frameSlot);
 
-            indexToSwapWith = m_IndexRemap[indexToSwapWith - TRANSIENT_POOL_START];
-            m_PingPongs.push_back( {m_Resources.size(), indexToSwapWith} );
-        }
+        m_ActiveDispatches.reserve(32);
+        m_ClearBatchResources.reserve(m_ClearResources.size()); // "DispatchDesc::resources" of clears point here
+        m_FramePlanDenoisers.reserve(8);
+        m_FramePlanPatches.reserve(32);
+        m_Barriers.reserve(256);
+        m_BarrierOffsets.reserve(64);
+        AllocateConstantData(frameSlot.constantDataSize);
+
+        SwapFrameSlot(frameSlot);
+    }
+
+    m_FrameSlotIndex = 0;
+}
+
+void nrd::InstanceImpl::SwapFrameSlot(FrameSlot& frameSlot)
+{
+    m_ActiveDispatches.swap(frameSlot.dispatches);
+    m_DispatchResources.swap(frameSlot.dispatchResources);
+    m_FrameResources.swap(frameSlot.resources);
+    m_ClearBatchResources.swap(frameSlot.clearBatchResources);
+    m_FramePlanDenoisers.swap(frameSlot.framePlanDenoisers);
+    m_FramePlanPatches.swap(frameSlot.framePlanPatches);
+    m_Barriers.swap(frameSlot.barriers);
+    m_BarrierOffsets.swap(frameSlot.barrierOffsets);
+    m_Dependencies.swap(frameSlot.dependencies);
+
+    std::swap(m_ConstantDataUnaligned, frameSlot.constantDataUnaligned);
+    std::swap(m_ConstantData, frameSlot.constantData);
+    std::swap(m_ConstantDataOffset, frameSlot.constantDataOffset);
+    std::swap(m_ConstantDataSize, frameSlot.constantDataSize);
+    std::swap(m_DependencyOffsets, frameSlot.dependencyOffsets);
+    std::swap(m_DependencyNums, frameSlot.dependencyNums);
+    std::swap(m_FramePlanCallIndex, frameSlot.framePlanCallIndex);
+    std::swap(m_FramePlanParity, frameSlot.framePlanParity);
+    std::swap(m_BarrierPlanMask, frameSlot.barrierPlanMask);
+    std::swap(m_DependencyPlanMask, frameSlot.dependencyPlanMask);
+    std::swap(m_ViewsNum, frameSlot.viewsNum);
+    std::swap(m_IsFramePlanValid, frameSlot.isFramePlanValid);
+}
+
+bool nrd::InstanceImpl::AcquireFrameSlot()
+{
+    if (m_FrameSlots.empty())
+        return true;
+
+    // Round robin, starting from the slot after the last used one
+    uint32_t frameSlotsNum = (uint32_t)m_FrameSlots.size();
+    for (uint32_t i = 1; i <= frameSlotsNum; i++)
+    {
+        uint32_t frameSlotIndex = (m_FrameSlotIndex + i) % frameSlotsNum;
+        if (m_FrameSlots[frameSlotIndex].isInFlight)
+            continue;
+
+        // Give memory back to the last used slot and take memory of the free one
+        SwapFrameSlot(m_FrameSlots[m_FrameSlotIndex]);
+        SwapFrameSlot(m_FrameSlots[frameSlotIndex]);
+        m_FrameSlotIndex = frameSlotIndex;
+
+        return true;
+    }
+
+    return false;
+}
+
+void nrd::InstanceImpl::PublishDispatches(const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
+{
+    dispatchDescs = m_ActiveDispatches.data();
+    dispatchDescsNum = (uint32_t)m_ActiveDispatches.size();
+
+    // Recorded in place, the slot just keeps its memory until "ReleaseFrame"
+    if (!m_FrameSlots.empty() && dispatchDescsNum)
+        m_FrameSlots[m_FrameSlotIndex].isInFlight = true;
+}
+
+void nrd::InstanceImpl::ResetFramePlan()
+{
+    m_IsFramePlanValid = false;
+    m_FramePlanParity = 0;
+    m_BarrierPlanMask = 0;
+    m_DependencyPlanMask = 0;
+
+    m_ConstantDataOffset = 0;
+    m_ViewIndex = 0;
+    m_ViewsNum = 1;
+    m_ActiveDispatches.clear();
+    m_DispatchResources.clear();
+    m_FramePlanDenoisers.clear();
+    m_FramePlanPatches.clear();
+    m_ClearBatchResources.clear();
+}
+
+bool nrd::InstanceImpl::ValidateViews(const ViewDesc* viewDescs, uint32_t viewDescsNum)
+{
+    // Only scratch memory is used, a rejected call leaves the instance untouched
+    m_DenoiserViews.assign(m_DenoiserData.size(), INVALID_INDEX);
+    m_PrevGuideGroupViews.assign(m_PrevGuideGroups.size(), INVALID_INDEX);
+
+    bool hasDenoisers = false;
+    for (uint32_t i = 0; i < viewDescsNum; i++)
+    {
+        const ViewDesc& viewDesc = viewDescs[i];
+        if (!viewDesc.commonSettings || !viewDesc.identifiers || !viewDesc.identifiersNum)
+            return false;
+
+        // Unknown identifiers are ignored, a denoiser can't belong to several views
+        for (uint32_t j = 0; j < viewDesc.identifiersNum; j++)
+        {
+            uint32_t denoiserIndex = GetDenoiserIndex(viewDesc.identifiers[j]);
+            if (denoiserIndex == INVALID_INDEX)
+                continue;
+
+            uint32_t& view = m_DenoiserViews[denoiserIndex];
+            if (view != INVALID_INDEX && view != i)
+                return false;
+
+            // Permutations for features declared as never used don't exist
+            const DenoiserData& denoiserData = m_DenoiserData[denoiserIndex];
+            if (GetRequestedFeatures(denoiserData, *viewDesc.commonSettings) & denoiserData.desc.disabledFeatures)
+                return false;
+
+            view = i;
+            hasDenoisers = true;
+        }
+    }
+
+    // Shared previous-frame guides are swapped once per call, so they can't be written by several views
+    for (const PrevGuideResource& prevGuideResource : m_PrevGuideResources)
+    {
+        uint32_t denoiserView = m_DenoiserViews[prevGuideResource.denoiserIndex];
+        if (denoiserView == INVALID_INDEX)
+            continue;
+
+        uint32_t& view = m_PrevGuideGroupViews[prevGuideResource.group];
+        if (view != INVALID_INDEX && view != denoiserView)
+            return false;
+
+        view = denoiserView;
+    }
+
+    return hasDenoisers;
+}
+
+void nrd::InstanceImpl::AddViewDispatches(const Identifier* identifiers, uint32_t identifiersNum, bool& isCacheable)
+{
+    SetActiveDenoisers(identifiers, identifiersNum);
+
+    // Guides can differ between views
+    m_TransientPoolWriters.assign(m_TransientPool.size(), INVALID_INDEX);
+
+    size_t viewDispatchOffset = m_ActiveDispatches.size();
+    size_t viewDenoiserOffset = m_FramePlanDenoisers.size();
+
+    // Collect dispatches for requested denoisers
+    for (size_t denoiserIndex = 0; denoiserIndex < m_DenoiserData.size(); denoiserIndex++)
+    {
+        // If current denoiser is in list
+        if (!IsDenoiserActive(denoiserIndex))
+            continue;
+
+        const DenoiserData& denoiserData = m_DenoiserData[denoiserIndex];
+
+        // REFERENCE has internal state changing every frame
+        if (denoiserData.desc.denoiser == Denoiser::REFERENCE)
+            isCacheable = false;
+
+        // Update denoiser and gather dispatches
+        size_t dispatchOffset = m_ActiveDispatches.size();
+
+        UpdatePingPong(denoiserData);
+        UpdateDenoiser(denoiserData);
+
+        if (m_IsGuideSharingEnabled)
+            SkipSharedDispatches(dispatchOffset);
+
+        m_FramePlanDenoisers.push_back( {&denoiserData, dispatchOffset, m_ActiveDispatches.size() - dispatchOffset, m_SharedConstantsOffset} );
+    }
+
+    // Inject "clear" calls if needed
+    if (m_CommonSettings.accumulationMode == AccumulationMode::CLEAR_AND_RESTART)
+        AddClearDispatches(viewDispatchOffset, viewDenoiserOffset);
+}
+
+void nrd::InstanceImpl::AddClearDispatches(size_t viewDispatchOffset, size_t viewDenoiserOffset)
+{
+    size_t dispatchNum = m_ActiveDispatches.size();
+
+    for (size_t i = viewDenoiserOffset; i < m_FramePlanDenoisers.size(); i++)
+    {
+        const FramePlanDenoiser& framePlanDenoiser = m_FramePlanDenoisers[i];
+        const DenoiserData& denoiserData = *framePlanDenoiser.denoiserData;
+
+        // Resources of a denoiser are batched per format class (up to "Clear_*OutputNum" textures per dispatch)
+        for (uint32_t isInteger = 0; isInteger < 2; isInteger++)
+        {
+            size_t batchOffset = m_ClearBatchResources.size();
+            uint16_t downsampleFactor = USE_MAX_DIMS;
+
+            for (size_t j = 0; j <= denoiserData.clearResourceNum; j++)
+            {
+                bool isLast = j == denoiserData.clearResourceNum;
+                if (!isLast)
+                {
+                    const ClearResource& clearResource = m_ClearResources[denoiserData.clearResourceOffset + j];
+                    if (clearResource.isInteger != (isInteger != 0) || !IsClearNeeded(framePlanDenoiser, clearResource.resource))
+                        continue;
+
+                    m_ClearBatchResources.push_back(clearResource.resource);
+                    downsampleFactor = min(downsampleFactor, clearResource.downsampleFactor);
+                }
+
+                size_t batchSize = m_ClearBatchResources.size() - batchOffset;
+                if (batchSize == 0 || (batchSize != Clear_FloatOutputNum && !isLast))
+                    continue;
+
+                // Add a clear dispatch
+                const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[ m_DispatchClearIndex[isInteger] ];
+
+                uint16_t w = DivideUp(m_CommonSettings.resourceSize[0], downsampleFactor);
+                uint16_t h = DivideUp(m_CommonSettings.resourceSize[1], downsampleFactor);
+
+                DispatchDesc dispatchDesc = {};
+                dispatchDesc.name = internalDispatchDesc.name;
+                dispatchDesc.identifier = denoiserData.desc.identifier;
+                dispatchDesc.resources = &m_ClearBatchResources[batchOffset];
+                dispatchDesc.resourcesNum = (uint32_t)batchSize;
+                dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
+                dispatchDesc.gridWidth = DivideUp(w, internalDispatchDesc.numThreads.width);
+                dispatchDesc.gridHeight = DivideUp(h, internalDispatchDesc.numThreads.height);
+                dispatchDesc.gridDepth = 1;
+                dispatchDesc.viewIndex = (uint16_t)m_ViewIndex;
+
+                // Unused outputs get skipped in the shader ("Clear_Float" and "Clear_Uint" constants are identical)
+                uint8_t* constantBufferData = PushConstantData(internalDispatchDesc.constantBufferDataSize);
+                memset(constantBufferData, 0, internalDispatchDesc.constantBufferDataSize);
+
+                Clear_FloatConstants* consts = (Clear_FloatConstants*)constantBufferData;
+                consts->gClearOutputNum = (uint32_t)batchSize;
+
+                dispatchDesc.constantBufferData = constantBufferData;
+                dispatchDesc.constantBufferDataSize = internalDispatchDesc.constantBufferDataSize;
+
+                m_ActiveDispatches.push_back(dispatchDesc);
+
+                batchOffset = m_ClearBatchResources.size();
+                downsampleFactor = USE_MAX_DIMS;
+            }
+        }
+    }
+
+    // Clears go first, because shared transient textures can be read by denoisers, which don't write them
+    size_t clearNum = m_ActiveDispatches.size() - dispatchNum;
+    std::rotate(m_ActiveDispatches.begin() + viewDispatchOffset, m_ActiveDispatches.begin() + dispatchNum, m_ActiveDispatches.end());
+
+    for (size_t i = viewDenoiserOffset; i < m_FramePlanDenoisers.size(); i++)
+        m_FramePlanDenoisers[i].dispatchOffset += clearNum;
+}
+
+bool nrd::InstanceImpl::IsClearNeeded(const FramePlanDenoiser& framePlanDenoiser, const ResourceDesc& resource) const
+{
+    const DenoiserData& denoiserData = *framePlanDenoiser.denoiserData;
+
+    // Ping-pong resources hold history: after swapping, pixels not written in this frame can be reprojected
+    for (size_t i = 0; i < denoiserData.pingPongNum; i++)
+    {
+        const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
+        const ResourceDesc& ping = m_Resources[pingPong.resourceIndex];
+        if (resource.type == ping.type && (resource.indexInPool == ping.indexInPool || resource.indexInPool == pingPong.indexInPoolToSwapWith))
+            return true;
+    }
+
+    // Permanent and user provided resources keep pixels outside of the rect
+    bool isFullRect = m_CommonSettings.rectSize[0] == m_CommonSettings.resourceSize[0] && m_CommonSettings.rectSize[1] == m_CommonSettings.resourceSize[1];
+    if (resource.type != ResourceType::TRANSIENT_POOL && !isFullRect)
+        return true;
+
+    // A clear is not needed if the first access in this frame is a write
+    for (size_t i = 0; i < framePlanDenoiser.dispatchNum; i++)
+    {
+        const DispatchDesc& dispatchDesc = m_ActiveDispatches[framePlanDenoiser.dispatchOffset + i];
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            const ResourceDesc& temp = dispatchDesc.resources[r];
+            bool isSame = temp.type == resource.type;
+            if (resource.type == ResourceType::PERMANENT_POOL || resource.type == ResourceType::TRANSIENT_POOL)
+                isSame = isSame && temp.indexInPool == resource.indexInPool;
+
+            if (isSame)
+                return temp.descriptorType != DescriptorType::STORAGE_TEXTURE;
+        }
+    }
+
+    return true;
+}
+
+void nrd::InstanceImpl::SkipSharedDispatches(size_t dispatchOffset)
+{
+    // A pass is skipped if shared textures already hold the output of an identical pass
+    size_t dispatchNum = dispatchOffset;
+    for (size_t i = dispatchOffset; i < m_ActiveDispatches.size(); i++)
+    {
+        const DispatchDesc& dispatchDesc = m_ActiveDispatches[i];
+
+        bool isShared = false;
+        bool isWritten = true;
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+        {
+            const ResourceDesc& resource = dispatchDesc.resources[r];
+            if (resource.type != ResourceType::TRANSIENT_POOL || resource.descriptorType != DescriptorType::STORAGE_TEXTURE || m_TransientPoolKinds[resource.indexInPool] != TransientKind::SHARED)
+                continue;
+
+            uint32_t writer = m_TransientPoolWriters[resource.indexInPool];
+
+            isShared = true;
+            isWritten = isWritten && writer != INVALID_INDEX && IsSameDispatch(m_ActiveDispatches[writer], dispatchDesc);
+        }
+
+        if (isShared && isWritten)
+            continue;
+
+        if (isShared)
+        {
+            for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+            {
+                const ResourceDesc& resource = dispatchDesc.resources[r];
+                if (resource.type == ResourceType::TRANSIENT_POOL && resource.descriptorType == DescriptorType::STORAGE_TEXTURE)
+                    m_TransientPoolWriters[resource.indexInPool] = (uint32_t)dispatchNum;
+            }
+        }
+
+        m_ActiveDispatches[dispatchNum++] = dispatchDesc;
+    }
+
+    m_ActiveDispatches.resize(dispatchNum);
+}
+
+void nrd::InstanceImpl::FinalizeDispatches(bool isFramePlanReused)
+{
+    // Ping-pong state changes every frame, frames in flight need a copy
+    if (!m_FrameSlots.empty())
+        ResolveResources();
+
+#ifdef NRD_BINDLESS
+    // Ping-pong resources are resolved only here
+    UpdateBindlessIndices();
+#endif
+
+    // Constants are final only after all denoisers have been updated. A reused plan keeps its indices: per-frame changes (shared constants,
+    // per-frame patches and bindless indices) are the same for dispatches, which had identical constants when the plan was built
+    if (!isFramePlanReused)
+        DeduplicateConstants();
+
+    // Barriers depend only on the dispatch sequence and ping-pong parity
+    if (!(m_BarrierPlanMask & (1 << m_FramePlanParity)))
+        AddBarriers(m_FramePlanParity);
+
+    const uint32_t* barrierOffsets = m_BarrierOffsets.data() + m_FramePlanParity * (m_ActiveDispatches.size() + 1);
+    for (size_t i = 0; i < m_ActiveDispatches.size(); i++)
+    {
+        DispatchDesc& dispatchDesc = m_ActiveDispatches[i];
+        dispatchDesc.barriers = m_Barriers.data() + barrierOffsets[i];
+        dispatchDesc.barriersNum = barrierOffsets[i + 1] - barrierOffsets[i];
+    }
+}
+
+void nrd::InstanceImpl::ResolveResources()
+{
+    // Live resources are gathered once per frame plan
+    if (m_DispatchResources.empty())
+    {
+        for (const DispatchDesc& dispatchDesc : m_ActiveDispatches)
+            m_DispatchResources.push_back(dispatchDesc.resources);
+    }
+
+    size_t resourcesNum = 0;
+    for (const DispatchDesc& dispatchDesc : m_ActiveDispatches)
+        resourcesNum += dispatchDesc.resourcesNum;
+
+    m_FrameResources.resize(resourcesNum);
+
+    resourcesNum = 0;
+    for (size_t i = 0; i < m_ActiveDispatches.size(); i++)
+    {
+        DispatchDesc& dispatchDesc = m_ActiveDispatches[i];
+        memcpy(&m_FrameResources[resourcesNum], m_DispatchResources[i], dispatchDesc.resourcesNum * sizeof(ResourceDesc));
+
+        dispatchDesc.resources = &m_FrameResources[resourcesNum];
+        resourcesNum += dispatchDesc.resourcesNum;
+    }
+}
+
+void nrd::InstanceImpl::UpdateBindlessIndices()
+{
+    assert("Samplers don't fit into bindless slots" && NRD_BINDLESS_OFFSET_s + m_Desc.samplersNum <= NRD_BINDLESS_INDICES_NUM);
+
+    // Indices follow all other constants (see "NRD_CONSTANTS_END")
+    for (DispatchDesc& dispatchDesc : m_ActiveDispatches)
+    {
+        uint32_t* indices = (uint32_t*)(dispatchDesc.constantBufferData + dispatchDesc.constantBufferDataSize) - NRD_BINDLESS_INDICES_NUM;
+        const PipelineDesc& pipelineDesc = m_Pipelines[dispatchDesc.pipelineIndex];
+
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < pipelineDesc.resourceRangesNum; i++)
+        {
+            const ResourceRangeDesc& resourceRange = pipelineDesc.resourceRanges[i];
+            bool isStorage = resourceRange.descriptorType != DescriptorType::TEXTURE;
+            uint32_t slot = (isStorage ? NRD_BINDLESS_OFFSET_u : NRD_BINDLESS_OFFSET_t) + resourceRange.baseRegisterIndex;
+            uint32_t heapOffset = m_ResourceDescriptorHeapOffset + (isStorage ? m_Desc.bindlessTexturesNum : 0);
+
+            assert("Resources don't fit into bindless slots" && slot + resourceRange.descriptorsNum <= (isStorage ? NRD_BINDLESS_OFFSET_s : NRD_BINDLESS_OFFSET_u));
+
+            // Partially filled clear batches don't provide resources for all slots (unused slots are not accessed)
+            for (uint32_t j = 0; j < resourceRange.descriptorsNum && n < dispatchDesc.resourcesNum; j++)
+            {
+                const ResourceDesc& resource = dispatchDesc.resources[n++];
+
+                uint32_t descriptorIndex = m_Desc.permanentPoolSize + m_Desc.transientPoolSize + (uint32_t)resource.type;
+                if (resource.type == ResourceType::PERMANENT_POOL)
+                    descriptorIndex = resource.indexInPool;
+                else if (resource.type == ResourceType::TRANSIENT_POOL)
+                    descriptorIndex = m_Desc.permanentPoolSize + resource.indexInPool;
+                else if (resource.type == ResourceType::INDIRECT_ARGUMENTS_POOL)
+                    descriptorIndex = m_Desc.bindlessTexturesNum + resource.indexInPool; // after all UAVs of textures
+
+                // Textures are within "bindlessTexturesNum", buffers are past all UAVs of textures
+                if (resource.type == ResourceType::INDIRECT_ARGUMENTS_POOL)
+                    assert("Bindless buffer index is out of range" && isStorage && resource.indexInPool < m_Desc.indirectArgumentsPoolSize);
+                else
+                    assert("Bindless texture index is out of range" && descriptorIndex < m_Desc.bindlessTexturesNum);
+
+                indices[slot + j] = heapOffset + descriptorIndex;
+            }
+        }
+
+        for (uint32_t i = 0; i < m_Desc.samplersNum; i++)
+            indices[NRD_BINDLESS_OFFSET_s + i] = m_SamplerDescriptorHeapOffset + i;
+    }
+}
+
+nrd::Result nrd::InstanceImpl::GetDispatchDependencies(const DispatchDependencyDesc*& dependencyDescs, uint32_t& dependencyDescsNum)
+{
+    // The graph depends only on the dispatch sequence and ping-pong parity
+    if (!(m_DependencyPlanMask & (1 << m_FramePlanParity)))
+        AddDependencies(m_FramePlanParity);
+
+    dependencyDescs = m_Dependencies.data() + m_DependencyOffsets[m_FramePlanParity];
+    dependencyDescsNum = (uint32_t)m_DependencyNums[m_FramePlanParity];
+
+    return Result::SUCCESS;
+}
+
+void nrd::InstanceImpl::SetActiveDenoisers(const Identifier* identifiers, uint32_t identifiersNum)
+{
+    memset(m_ActiveDenoisers.data(), 0, m_ActiveDenoisers.size() * sizeof(uint64_t));
+
+    // Unknown identifiers are ignored
+    for (uint32_t i = 0; i < identifiersNum; i++)
+    {
+        uint32_t denoiserIndex = GetDenoiserIndex(identifiers[i]);
+        if (denoiserIndex != INVALID_INDEX)
+            m_ActiveDenoisers[denoiserIndex >> 6] |= 1ull << (denoiserIndex & 63);
+    }
+}
+
+void nrd::InstanceImpl::UpdateDenoiser(const DenoiserData& denoiserData)
+{
+    // Shared constants are computed once per denoiser per frame, dispatches reference them ("DispatchDesc::sharedConstantBufferData")
+    uint8_t* sharedConstants = PushConstantData(m_Desc.constantBufferMaxDataSize);
+    m_SharedConstantsOffset = size_t(sharedConstants - m_ConstantData);
+    m_SharedConstantsSize = AddSharedConstants(denoiserData, sharedConstants);
+    m_ConstantDataOffset = m_SharedConstantsOffset + GetAlignedSize(m_SharedConstantsSize, sizeof(float4));
+
+    if (denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SH ||
+        denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR_SH ||
+        denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR || denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_SH ||
+        denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
+        Update_Reblur(denoiserData);
+    else if (denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_OCCLUSION ||
+        denoiserData.desc.denoiser == Denoiser::REBLUR_SPECULAR_OCCLUSION ||
+        denoiserData.desc.denoiser == Denoiser::REBLUR_DIFFUSE_SPECULAR_OCCLUSION)
+        Update_ReblurOcclusion(denoiserData);
+    else if (denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE || denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SH ||
+        denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR || denoiserData.desc.denoiser == Denoiser::RELAX_SPECULAR_SH ||
+        denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR || denoiserData.desc.denoiser == Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
+        Update_Relax(denoiserData);
+    else if (denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW || denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW_TRANSLUCENCY)
+        Update_SigmaShadow(denoiserData);
+    else if (denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW_ARRAY)
+        Update_SigmaShadowArray(denoiserData);
+    else if (denoiserData.desc.denoiser == Denoiser::REFERENCE)
+        Update_Reference(denoiserData);
+}
+
+size_t nrd::InstanceImpl::AddSharedConstants(const DenoiserData& denoiserData, void* data)
+{
+    if (denoiserData.desc.denoiser >= Denoiser::REBLUR_DIFFUSE && denoiserData.desc.denoiser <= Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
+        return AddSharedConstants_Reblur(denoiserData.settings.reblur, data);
+    else if (denoiserData.desc.denoiser >= Denoiser::RELAX_DIFFUSE && denoiserData.desc.denoiser <= Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
+        return AddSharedConstants_Relax(denoiserData.settings.relax, data);
+    else if (denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW || denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW_TRANSLUCENCY)
+        return AddSharedConstants_Sigma(denoiserData.settings.sigma, data);
+    else if (denoiserData.desc.denoiser == Denoiser::SIGMA_SHADOW_ARRAY)
+        return AddSharedConstants_SigmaArray(denoiserData.settings.sigmaArray, denoiserData.desc.layersNum, data);
+
+    return 0;
+}
+
+uint32_t nrd::InstanceImpl::GetRequestedFeatures(const DenoiserData& denoiserData, const CommonSettings& commonSettings) const
+{
+    uint32_t features = 0;
+    if (commonSettings.isHistoryConfidenceAvailable)
+        features |= (uint32_t)DenoiserFeatureBits::HISTORY_CONFIDENCE;
+    if (commonSettings.isDisocclusionThresholdMixAvailable)
+        features |= (uint32_t)DenoiserFeatureBits::DISOCCLUSION_THRESHOLD_MIX;
+    if (commonSettings.isBaseColorMetalnessAvailable)
+        features |= (uint32_t)DenoiserFeatureBits::BASECOLOR_METALNESS;
+    if (commonSettings.enableValidation)
+        features |= (uint32_t)DenoiserFeatureBits::VALIDATION;
+    if (commonSettings.splitScreen > 0.0f)
+        features |= (uint32_t)DenoiserFeatureBits::SPLIT_SCREEN;
+
+    if (denoiserData.desc.denoiser >= Denoiser::REBLUR_DIFFUSE && denoiserData.desc.denoiser <= Denoiser::REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION)
+    {
+        const ReblurSettings& settings = denoiserData.settings.reblur;
+        if (settings.enablePerformanceMode)
+            features |= (uint32_t)DenoiserFeatureBits::PERFORMANCE_MODE;
+        if (settings.hitDistanceReconstructionMode != HitDistanceReconstructionMode::OFF && settings.checkerboardMode == CheckerboardMode::OFF)
+            features |= (uint32_t)DenoiserFeatureBits::HIT_DISTANCE_RECONSTRUCTION;
+    }
+    else if (denoiserData.desc.denoiser >= Denoiser::RELAX_DIFFUSE && denoiserData.desc.denoiser <= Denoiser::RELAX_DIFFUSE_SPECULAR_SH)
+    {
+        const RelaxSettings& settings = denoiserData.settings.relax;
+        if (settings.hitDistanceReconstructionMode != HitDistanceReconstructionMode::OFF && settings.checkerboardMode == CheckerboardMode::OFF)
+            features |= (uint32_t)DenoiserFeatureBits::HIT_DISTANCE_RECONSTRUCTION;
+    }
+
+    return features;
+}
+
+void nrd::InstanceImpl::GetFramePlanKey(const Identifier* identifiers, uint32_t identifiersNum)
+{
+    // The key is compared byte by byte (not only hashed), different settings must never reuse a plan
+    m_FramePlanKey.clear();
+
+    auto Append = [this](const void* data, size_t size)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        m_FramePlanKey.insert(m_FramePlanKey.end(), bytes, bytes + size);
+    };
+
+    // Requested denoisers and their settings
+    Append(&identifiersNum, sizeof(identifiersNum));
+    Append(identifiers, identifiersNum * sizeof(Identifier));
+    for (const DenoiserData& denoiserData : m_DenoiserData)
+        Append(&denoiserData.settings, denoiserData.settingsSize);
+
+    // Common settings affecting permutations and dispatch sizes
+    uint8_t splitScreenMode = m_CommonSettings.splitScreen >= 1.0f ? 2 : (m_CommonSettings.splitScreen > 0.0f ? 1 : 0);
+
+    Append(m_CommonSettings.resourceSize, sizeof(m_CommonSettings.resourceSize));
+    Append(m_CommonSettings.rectSize, sizeof(m_CommonSettings.rectSize));
+    Append(m_CommonSettings.rectSizePrev, sizeof(m_CommonSettings.rectSizePrev));
+    Append(&splitScreenMode, sizeof(splitScreenMode));
+    Append(&m_CommonSettings.isHistoryConfidenceAvailable, sizeof(bool));
+    Append(&m_CommonSettings.isDisocclusionThresholdMixAvailable, sizeof(bool));
+    Append(&m_CommonSettings.isBaseColorMetalnessAvailable, sizeof(bool));
+    Append(&m_CommonSettings.enableValidation, sizeof(bool));
+}
+
+void nrd::InstanceImpl::ReplayFramePlan()
+{
+    // Dispatches, resources and pass specific constants are already in place. Only ping-pong state and per-frame
+    // constants need to be refreshed (shared constants are referenced by dispatches, not copied)
+    for (const FramePlanDenoiser& framePlanDenoiser : m_FramePlanDenoisers)
+    {
+        UpdatePingPong(*framePlanDenoiser.denoiserData);
+
+        if (framePlanDenoiser.dispatchNum)
+            AddSharedConstants(*framePlanDenoiser.denoiserData, m_ConstantData + framePlanDenoiser.sharedConstantsOffset);
+    }
+
+    for (const FramePlanPatch& framePlanPatch : m_FramePlanPatches)
+        memcpy(m_ConstantData + framePlanPatch.constantDataOffset, framePlanPatch.source, sizeof(float4));
+}
+
+void nrd::InstanceImpl::DeduplicateConstants()
+{
+    // Load factor <= 0.5
+    size_t constantBlockSlotsNum = 1;
+    while (constantBlockSlotsNum < m_ActiveDispatches.size() * 2)
+        constantBlockSlotsNum <<= 1;
+
+    m_ConstantBlockSlots.resize(constantBlockSlotsNum);
+    for (ConstantBlockSlot& constantBlockSlot : m_ConstantBlockSlots)
+        constantBlockSlot.dispatchIndex = INVALID_INDEX;
+
+    uint32_t mask = (uint32_t)constantBlockSlotsNum - 1;
+    uint32_t constantBlockNum = 0;
+
+    // Shared constants are identified by their block (one per denoiser), pass specific constants by content and per-frame patches
+    // (a patched constant can match a non-patched one in this frame, but not in the next frame). Patches are recorded in constant data order
+    const FramePlanPatch* patches = m_FramePlanPatches.data();
+    const FramePlanPatch* patchesEnd = patches + m_FramePlanPatches.size();
+    auto IsBefore = [](const FramePlanPatch& framePlanPatch, size_t offset) { return framePlanPatch.constantDataOffset < offset; };
+
+    for (size_t i = 0; i < m_ActiveDispatches.size(); i++)
+    {
+        DispatchDesc& dispatchDesc = m_ActiveDispatches[i];
+        if (!dispatchDesc.sharedConstantBufferDataSize && !dispatchDesc.constantBufferDataSize)
+            continue;
+
+        size_t constantDataOffset = size_t(dispatchDesc.constantBufferData - m_ConstantData);
+        const FramePlanPatch* blockPatches = std::lower_bound(patches, patchesEnd, constantDataOffset, IsBefore);
+        const FramePlanPatch* blockPatchesEnd = std::lower_bound(blockPatches, patchesEnd, constantDataOffset + dispatchDesc.constantBufferDataSize, IsBefore);
+        uint32_t patchesOffset = uint32_t(blockPatches - patches);
+        uint32_t patchesNum = uint32_t(blockPatchesEnd - blockPatches);
+
+        uint64_t hash = HashBytes(&dispatchDesc.sharedConstantBufferData, sizeof(dispatchDesc.sharedConstantBufferData));
+        hash = HashBytes(dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize, hash);
+        for (const FramePlanPatch* framePlanPatch = blockPatches; framePlanPatch != blockPatchesEnd; framePlanPatch++)
+            hash = HashBytes(&framePlanPatch->source, sizeof(framePlanPatch->source), hash);
+
+        for (uint32_t j = uint32_t(hash) & mask; ; j = (j + 1) & mask)
+        {
+            ConstantBlockSlot& constantBlockSlot = m_ConstantBlockSlots[j];
+
+            // A new unique block
+            if (constantBlockSlot.dispatchIndex == INVALID_INDEX)
+            {
+                constantBlockSlot = {hash, (uint32_t)i, patchesOffset, patchesNum};
+                dispatchDesc.constantBufferIndex = constantBlockNum++;
+                break;
+            }
+
+            if (constantBlockSlot.hash != hash || constantBlockSlot.patchesNum != patchesNum)
+                continue;
+
+            // Identical to an already seen block
+            const DispatchDesc& dispatchDescUnique = m_ActiveDispatches[constantBlockSlot.dispatchIndex];
+            bool isSame = dispatchDescUnique.sharedConstantBufferData == dispatchDesc.sharedConstantBufferData
+                && dispatchDescUnique.sharedConstantBufferDataSize == dispatchDesc.sharedConstantBufferDataSize
+                && dispatchDescUnique.constantBufferDataSize == dispatchDesc.constantBufferDataSize
+                && !memcmp(dispatchDescUnique.constantBufferData, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
+
+            size_t constantDataOffsetUnique = size_t(dispatchDescUnique.constantBufferData - m_ConstantData);
+            const FramePlanPatch* blockPatchesUnique = patches + constantBlockSlot.patchesOffset;
+            for (uint32_t k = 0; k < patchesNum && isSame; k++)
+            {
+                isSame = blockPatches[k].source == blockPatchesUnique[k].source
+                    && blockPatches[k].constantDataOffset - constantDataOffset == blockPatchesUnique[k].constantDataOffset - constantDataOffsetUnique;
+            }
+
+            if (isSame)
+            {
+                dispatchDesc.constantBufferIndex = dispatchDescUnique.constantBufferIndex;
+                break;
+            }
+        }
+
+        const DispatchDesc* dispatchDescPrev = i ? &m_ActiveDispatches[i - 1] : nullptr;
+        bool hasConstantsPrev = dispatchDescPrev && (dispatchDescPrev->sharedConstantBufferDataSize || dispatchDescPrev->constantBufferDataSize);
+        dispatchDesc.constantBufferDataMatchesPreviousDispatch = hasConstantsPrev && dispatchDescPrev->constantBufferIndex == dispatchDesc.constantBufferIndex;
+    }
+}
+
+void nrd::InstanceImpl::AddBarriers(uint32_t parity)
+{
+    size_t dispatchNum = m_ActiveDispatches.size();
+    if (parity == 0)
+    {
+        m_Barriers.clear();
+        m_BarrierOffsets.resize((dispatchNum + 1) * 2);
+    }
+
+    m_ResourceStates.clear();
+    m_ResourceStates.resize(GetResourceStateNum(), DescriptorType::MAX_NUM);
+
+    uint32_t* barrierOffsets = m_BarrierOffsets.data() + parity * (dispatchNum + 1);
+    for (size_t i = 0; i < dispatchNum; i++)
+    {
+        const DispatchDesc& dispatchDesc = m_ActiveDispatches[i];
+        barrierOffsets[i] = (uint32_t)m_Barriers.size();
+
+        for (uint32_t j = 0; j < dispatchDesc.resourcesNum; j++)
+        {
+            const ResourceDesc& resource = dispatchDesc.resources[j];
+
+            // "Read -> read" (in the same state) is the only case not needing a barrier
+            DescriptorType& state = m_ResourceStates[GetResourceStateIndex(resource, dispatchDesc.viewIndex)];
+            if (state != resource.descriptorType || !IsReadOnly(state))
+                m_Barriers.push_back( {j, state, resource.descriptorType} );
+
+            state = resource.descriptorType;
+        }
+    }
+
+    barrierOffsets[dispatchNum] = (uint32_t)m_Barriers.size();
+    m_BarrierPlanMask |= 1 << parity;
+}
+
+void nrd::InstanceImpl::AddDependencies(uint32_t parity)
+{
+    // Keep the graph of the other parity if it's still valid
+    if (!(m_DependencyPlanMask & (1 << (parity ^ 1))))
+        m_Dependencies.clear();
+
+    m_DependencyOffsets[parity] = m_Dependencies.size();
+
+    m_ResourceHazards.clear();
+    m_ResourceHazards.resize(GetResourceStateNum(), {INVALID_INDEX, INVALID_INDEX});
+    m_HazardReaders.clear();
+    m_DependencyMarks.clear();
+    m_DependencyMarks.resize(m_ActiveDispatches.size(), INVALID_INDEX);
+
+    for (uint32_t i = 0; i < (uint32_t)m_ActiveDispatches.size(); i++)
+    {
+        const DispatchDesc& dispatchDesc = m_ActiveDispatches[i];
+
+        for (uint32_t j = 0; j < dispatchDesc.resourcesNum; j++)
+        {
+            const ResourceDesc& resource = dispatchDesc.resources[j];
+            ResourceHazard& resourceHazard = m_ResourceHazards[GetResourceStateIndex(resource, dispatchDesc.viewIndex)];
+
+            // RAW
+            uint32_t before = resourceHazard.writer;
+            if (IsReadOnly(resource.descriptorType))
+            {
+                m_HazardReaders.push_back( {i, resourceHazard.readers} );
+                resourceHazard.readers = uint32_t(m_HazardReaders.size() - 1);
+            }
+            else
+            {
+                // WAR (WAW is implied if there are readers since the last write)
+                for (uint32_t r = resourceHazard.readers; r != INVALID_INDEX; r = m_HazardReaders[r].next)
+                {
+                    uint32_t reader = m_HazardReaders[r].dispatchIndex;
+                    if (reader != i && m_DependencyMarks[reader] != i)
+                    {
+                        m_DependencyMarks[reader] = i;
+                        m_Dependencies.push_back( {reader, i} );
+                    }
+                }
+
+                // WAW
+                if (resourceHazard.readers != INVALID_INDEX)
+                    before = INVALID_INDEX;
+
+                resourceHazard.writer = i;
+                resourceHazard.readers = INVALID_INDEX;
+            }
+
+            if (before != INVALID_INDEX && before != i && m_DependencyMarks[before] != i)
+            {
+                m_DependencyMarks[before] = i;
+                m_Dependencies.push_back( {before, i} );
+            }
+        }
+    }
+
+    m_DependencyNums[parity] = m_Dependencies.size() - m_DependencyOffsets[parity];
+    m_DependencyPlanMask |= 1 << parity;
+}
+
+void nrd::InstanceImpl::AddComputeDispatchDesc
+(
+    NumThreads numThreads,
+    uint16_t downsampleFactor,
+    uint32_t constantBufferDataSize,
+    uint32_t maxRepeatNum,
+    const char* shaderFileName,
+    const ComputeShaderDesc& dxbc,
+    const ComputeShaderDesc& dxil,
+    const ComputeShaderDesc& spirv
+)
+{
+    // Permutations needed only for disabled features don't get a pipeline (and can't be dispatched)
+    size_t variant = m_Dispatches.size() - m_PassDispatchOffset;
+    assert("Features of a variant are unknown" && variant < g_VariantFeatures.size());
+
+    if (!IsPermutationUsed(m_PassFeatures | (uint32_t)g_VariantFeatures[variant]))
+    {
+        InternalDispatchDesc computeDispatchDesc = {};
+        computeDispatchDesc.name = m_PassName;
+        computeDispatchDesc.pipelineIndex = UNUSED_PIPELINE_INDEX;
+        computeDispatchDesc.resources = (ResourceDesc*)m_ResourceOffset;
+
+        m_Dispatches.push_back(computeDispatchDesc);
+
+        return;
+    }
+
+    // Pipeline (unique only, a shader is bound with the same layout in all passes using it, see "PassChecker")
+    uint32_t mask = (uint32_t)m_PipelineSlots.size() - 1;
+    uint32_t slot = HashString(shaderFileName) & mask;
+    for (; m_PipelineSlots[slot] != INVALID_INDEX; slot = (slot + 1) & mask)
+    {
+        const PipelineDesc& pipeline = m_Pipelines[m_PipelineSlots[slot]];
+
+        if (!strcmp(pipeline.shaderFileName, shaderFileName))
+            break;
+    }
+
+    uint32_t pipelineIndex = m_PipelineSlots[slot];
+    if (pipelineIndex == INVALID_INDEX)
+    {
+        pipelineIndex = (uint32_t)m_Pipelines.size();
+        m_PipelineSlots[slot] = pipelineIndex;
+
+        PipelineDesc pipelineDesc = {};
+        pipelineDesc.shaderFileName = shaderFileName;
+        pipelineDesc.shaderEntryPointName = NRD_STRINGIFY(NRD_CS_MAIN);
+        pipelineDesc.computeShaderDXBC = dxbc;
+        pipelineDesc.computeShaderDXIL = dxil;
+        pipelineDesc.computeShaderSPIRV = spirv;
+        pipelineDesc.resourceRanges = (ResourceRangeDesc*)m_ResourceRanges.size();
+        pipelineDesc.hasConstantData = constantBufferDataSize != 0;
+
+        // Storage buffers follow storage textures in "u" registers, indirect arguments are not bound
+        uint32_t storageTexturesNum = 0;
+        for (size_t r = 0; r < 3; r++)
+        {
+            ResourceRangeDesc descriptorRange = {};
+            descriptorRange.descriptorType = (DescriptorType)r;
+            descriptorRange.baseRegisterIndex = descriptorRange.descriptorType == DescriptorType::STORAGE_BUFFER ? storageTexturesNum : 0;
+
+            for (size_t i = m_ResourceOffset; i < m_Resources.size(); i++ )
+            {
+                const ResourceDesc& resource = m_Resources[i];
+                if (descriptorRange.descriptorType == resource.descriptorType)
+                    descriptorRange.descriptorsNum++;
+            }
+
+            if (descriptorRange.descriptorType == DescriptorType::STORAGE_TEXTURE)
+                storageTexturesNum = descriptorRange.descriptorsNum;
+
+            if (descriptorRange.descriptorsNum != 0)
+            {
+                m_ResourceRanges.push_back(descriptorRange);
+                pipelineDesc.resourceRangesNum++;
+            }
+        }
+
+        m_Pipelines.push_back( pipelineDesc );
+
+        // Keep load factor <= 0.5
+        if (m_Pipelines.size() * 2 > m_PipelineSlots.size())
+        {
+            m_PipelineSlots.assign(m_PipelineSlots.size() * 2, INVALID_INDEX);
+            mask = (uint32_t)m_PipelineSlots.size() - 1;
+
+            for (uint32_t i = 0; i < (uint32_t)m_Pipelines.size(); i++)
+            {
+                slot = HashString(m_Pipelines[i].shaderFileName) & mask;
+                while (m_PipelineSlots[slot] != INVALID_INDEX)
+                    slot = (slot + 1) & mask;
+
+                m_PipelineSlots[slot] = i;
+            }
+        }
+    }
+
+    // Dispatch
+    InternalDispatchDesc computeDispatchDesc = {};
+    computeDispatchDesc.name = m_PassName;
+    computeDispatchDesc.pipelineIndex = (uint16_t)pipelineIndex;
+    computeDispatchDesc.downsampleFactor = downsampleFactor;
+    computeDispatchDesc.maxRepeatsNum = (uint16_t)maxRepeatNum;
+    computeDispatchDesc.constantBufferDataSize = constantBufferDataSize;
+    computeDispatchDesc.resourcesNum = uint32_t(m_Resources.size() - m_ResourceOffset);
+    computeDispatchDesc.resources = (ResourceDesc*)m_ResourceOffset;
+    computeDispatchDesc.numThreads = numThreads;
+    computeDispatchDesc.isIndirect = computeDispatchDesc.resourcesNum && m_Resources.back().descriptorType == DescriptorType::INDIRECT_ARGUMENTS;
+
+    m_Dispatches.push_back(computeDispatchDesc);
+}
+
+bool nrd::InstanceImpl::IsPermutationUsed(uint32_t features) const
+{
+    if (!m_DisabledFeatures)
+        return true;
+
+    // Features needed by a permutation follow from its pass and variant (see "PassDesc") and bound inputs
+    for (size_t i = m_ResourceOffset; i < m_Resources.size(); i++)
+    {
+        ResourceType type = m_Resources[i].type;
+        if (type == ResourceType::IN_DIFF_CONFIDENCE || type == ResourceType::IN_SPEC_CONFIDENCE)
+            features |= (uint32_t)DenoiserFeatureBits::HISTORY_CONFIDENCE;
+        else if (type == ResourceType::IN_DISOCCLUSION_THRESHOLD_MIX)
+            features |= (uint32_t)DenoiserFeatureBits::DISOCCLUSION_THRESHOLD_MIX;
+        else if (type == ResourceType::IN_BASECOLOR_METALNESS)
+            features |= (uint32_t)DenoiserFeatureBits::BASECOLOR_METALNESS;
+    }
+
+    return (features & m_DisabledFeatures) == 0;
+}
+
+void nrd::InstanceImpl::PrepareDesc()
+{
+    m_Desc = {};
+
+    m_Desc.constantBufferRegisterIndex = NRD_CONSTANT_BUFFER_REGISTER_INDEX;
+    m_Desc.constantBufferSpaceIndex = NRD_CONSTANT_BUFFER_SPACE_INDEX;
+
+    m_Desc.samplers = g_Samplers.data();
+    m_Desc.samplersNum = (uint32_t)g_Samplers.size();
+    m_Desc.samplersSpaceIndex = NRD_SAMPLERS_SPACE_INDEX;
+    m_Desc.samplersBaseRegisterIndex = 0;
+
+    m_Desc.pipelines = m_Pipelines.data();
+    m_Desc.pipelinesNum = (uint32_t)m_Pipelines.size();
+    m_Desc.resourcesSpaceIndex = NRD_RESOURCES_SPACE_INDEX;
+
+    m_Desc.permanentPool = m_PermanentPool.data();
+    m_Desc.permanentPoolSize = (uint32_t)m_PermanentPool.size();
+
+    m_Desc.transientPool = m_TransientPool.data();
+    m_Desc.transientPoolSize = (uint32_t)m_TransientPool.size();
+
+    m_Desc.indirectArgumentsPoolSize = m_IndirectArgumentsPoolSize;
+    m_Desc.indirectArgumentsBufferSize = INDIRECT_ARGUMENTS_SIZE;
+
+    m_Desc.bindlessTexturesNum = m_Desc.permanentPoolSize + m_Desc.transientPoolSize + (uint32_t)ResourceType::TRANSIENT_POOL;
+
+    const bool samplersAreInSeparateSet = NRD_SAMPLERS_SPACE_INDEX != NRD_CONSTANT_BUFFER_SPACE_INDEX && NRD_SAMPLERS_SPACE_INDEX != NRD_RESOURCES_SPACE_INDEX;
+    if (samplersAreInSeparateSet)
+        m_Desc.descriptorPoolDesc.samplersMaxNum += m_Desc.samplersNum;
+
+    // Calculate descriptor heap (sets) requirements
+    for (InternalDispatchDesc& dispatchDesc : m_Dispatches)
+    {
+        size_t textureOffset = (size_t)dispatchDesc.resources;
+        dispatchDesc.resources = &m_Resources[textureOffset];
+
+        for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++)
+        {
+            const ResourceDesc& resource = dispatchDesc.resources[i];
+            if (resource.descriptorType == DescriptorType::TEXTURE)
+                m_Desc.descriptorPoolDesc.texturesMaxNum += dispatchDesc.maxRepeatsNum;
+            else if (resource.descriptorType == DescriptorType::STORAGE_TEXTURE)
+                m_Desc.descriptorPoolDesc.storageTexturesMaxNum += dispatchDesc.maxRepeatsNum;
+            else if (resource.descriptorType == DescriptorType::STORAGE_BUFFER)
+                m_Desc.descriptorPoolDesc.storageBuffersMaxNum += dispatchDesc.maxRepeatsNum;
+        }
+
+        m_Desc.descriptorPoolDesc.setsMaxNum += dispatchDesc.maxRepeatsNum;
+
+        if (!samplersAreInSeparateSet)
+            m_Desc.descriptorPoolDesc.samplersMaxNum += dispatchDesc.maxRepeatsNum * m_Desc.samplersNum;
+
+        if (dispatchDesc.constantBufferDataSize != 0)
+        {
+            m_Desc.descriptorPoolDesc.constantBuffersMaxNum += dispatchDesc.maxRepeatsNum;
+            m_Desc.constantBufferMaxDataSize = max(dispatchDesc.constantBufferDataSize, m_Desc.constantBufferMaxDataSize);
+        }
+    }
+
+    // For potential clears
+    uint32_t clearNum = (uint32_t)m_ClearResources.size();
+    m_Desc.descriptorPoolDesc.storageTexturesMaxNum += clearNum;
+    m_Desc.descriptorPoolDesc.setsMaxNum += clearNum;
+
+    if (!samplersAreInSeparateSet)
+        m_Desc.descriptorPoolDesc.samplersMaxNum += clearNum * m_Desc.samplersNum;
+
+    // Assign resources
+    for (PipelineDesc& pipelineDesc : m_Pipelines)
+    {
+        size_t descriptorRangeffset = (size_t)pipelineDesc.resourceRanges;
+        pipelineDesc.resourceRanges = &m_ResourceRanges[descriptorRangeffset];
+    }
+
+    // *= number of "spaces"
+    uint32_t descriptorSetNum = 1;
+    if (m_Desc.constantBufferSpaceIndex != m_Desc.samplersSpaceIndex)
+        descriptorSetNum++;
+    if (m_Desc.samplersSpaceIndex != m_Desc.resourcesSpaceIndex)
+        descriptorSetNum++;
+
+    m_Desc.descriptorPoolDesc.setsMaxNum *= descriptorSetNum;
+
+#ifdef NRD_BINDLESS
+    // Only constants get bound
+    uint32_t constantBuffersMaxNum = m_Desc.descriptorPoolDesc.constantBuffersMaxNum + clearNum;
+    m_Desc.descriptorPoolDesc = {};
+    m_Desc.descriptorPoolDesc.setsMaxNum = constantBuffersMaxNum;
+    m_Desc.descriptorPoolDesc.constantBuffersMaxNum = constantBuffersMaxNum;
+#endif
+}
+
+void nrd::InstanceImpl::AllocateConstantData(size_t constantDataSize)
+{
+    uint8_t* constantDataUnaligned = m_StdAllocator.allocate(constantDataSize + sizeof(float4));
+
+    // IMPORTANT: underlying memory for constants must be aligned, as well as any individual SSE-type containing member,
+    // because a compiler can generate dangerous "movaps" instruction!
+    uint8_t* constantData = Align(constantDataUnaligned, sizeof(float4));
+    memset(constantData, 0, constantDataSize);
+
+    // Growing: move already pushed constants and rebase dispatches pointing to them (frame plan patches are offsets)
+    if (m_ConstantDataUnaligned)
+    {
+        memcpy(constantData, m_ConstantData, m_ConstantDataOffset);
+
+        for (DispatchDesc& dispatchDesc : m_ActiveDispatches)
+        {
+            if (dispatchDesc.sharedConstantBufferData)
+                dispatchDesc.sharedConstantBufferData = constantData + (dispatchDesc.sharedConstantBufferData - m_ConstantData);
+
+            if (dispatchDesc.constantBufferData)
+                dispatchDesc.constantBufferData = constantData + (dispatchDesc.constantBufferData - m_ConstantData);
+        }
+
+        m_StdAllocator.deallocate(m_ConstantDataUnaligned, 0);
+    }
+
+    m_ConstantDataUnaligned = constantDataUnaligned;
+    m_ConstantData = constantData;
+    m_ConstantDataSize = constantDataSize;
+}
+
+void nrd::InstanceImpl::UpdatePingPong(const DenoiserData& denoiserData)
+{
+    for (uint32_t i = 0; i < denoiserData.pingPongNum; i++)
+    {
+        PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
+        ResourceDesc& resource = m_Resources[pingPong.resourceIndex];
+
+        Swap(resource.indexInPool, pingPong.indexInPoolToSwapWith);
+    }
+}
+
+void nrd::InstanceImpl::SharePrevGuides()
+{
+    // Previous-frame guides hold identical data in all denoisers. A shared guide needs two textures, since a denoiser can't overwrite
+    // the previous frame still to be read by next denoisers: all denoisers read the texture written in the previous frame and write
+    // the other one. It saves memory only starting from three denoisers
+    const uint16_t NOT_SHARED = uint16_t(-1);
+    const uint16_t REMOVED = uint16_t(-1);
+
+    Vector<uint16_t> groups(m_PrevGuides.size(), NOT_SHARED, GetStdAllocator());
+    Vector<uint32_t> groupSizes(GetStdAllocator());
+
+    for (size_t i = 0; i < m_PrevGuides.size(); i++)
+    {
+        const PrevGuide& prevGuide = m_PrevGuides[i];
+        const TextureDesc& textureDesc = m_PermanentPool[prevGuide.indexInPool];
+
+        size_t j = 0;
+        for (; j < i; j++)
+        {
+            const PrevGuide& otherPrevGuide = m_PrevGuides[j];
+            const TextureDesc& t = m_PermanentPool[otherPrevGuide.indexInPool];
+            if (otherPrevGuide.guide == prevGuide.guide && t.format == textureDesc.format && t.downsampleFactor == textureDesc.downsampleFactor && t.layersNum == textureDesc.layersNum)
+                break;
+        }
+
+        if (j == i)
+        {
+            groups[i] = (uint16_t)groupSizes.size();
+            groupSizes.push_back(0);
+        }
+        else
+            groups[i] = groups[j];
+
+        groupSizes[groups[i]]++;
+    }
+
+    // The first two denoisers of a group keep their textures, textures of others are removed
+    Vector<uint16_t> sharedGroups(groupSizes.size(), NOT_SHARED, GetStdAllocator());
+    Vector<uint16_t> permanentRemap(m_PermanentPool.size(), 0, GetStdAllocator());
+
+    for (size_t i = 0; i < m_PrevGuides.size(); i++)
+    {
+        const PrevGuide& prevGuide = m_PrevGuides[i];
+        uint16_t group = groups[i];
+
+        if (groupSizes[group] < 3)
+        {
+            groups[i] = NOT_SHARED;
+            continue;
+        }
+
+        if (sharedGroups[group] == NOT_SHARED)
+        {
+            sharedGroups[group] = (uint16_t)m_PrevGuideGroups.size();
+            m_PrevGuideGroups.push_back( {{prevGuide.indexInPool, uint16_t(-1)}} ); // "-1" - not assigned yet
+        }
+        else
+        {
+            PrevGuideGroup& prevGuideGroup = m_PrevGuideGroups[sharedGroups[group]];
+            if (prevGuideGroup.indexInPool[1] == uint16_t(-1))
+                prevGuideGroup.indexInPool[1] = prevGuide.indexInPool;
+            else
+                permanentRemap[prevGuide.indexInPool] = REMOVED;
+        }
+
+        groups[i] = sharedGroups[group];
+    }
+
+    if (m_PrevGuideGroups.empty())
+        return;
+
+    // Compact the permanent pool, removed textures are replaced with the first texture of the group
+    uint16_t permanentPoolSize = 0;
+    for (size_t i = 0; i < m_PermanentPool.size(); i++)
+    {
+        if (permanentRemap[i] == REMOVED)
+            continue;
+
+        m_PermanentPool[permanentPoolSize] = m_PermanentPool[i];
+        permanentRemap[i] = permanentPoolSize++;
+    }
+    m_PermanentPool.resize(permanentPoolSize);
+
+    for (PrevGuideGroup& prevGuideGroup : m_PrevGuideGroups)
+    {
+        prevGuideGroup.indexInPool[0] = permanentRemap[prevGuideGroup.indexInPool[0]];
+        prevGuideGroup.indexInPool[1] = permanentRemap[prevGuideGroup.indexInPool[1]];
+    }
+
+    for (size_t i = 0; i < m_PrevGuides.size(); i++)
+    {
+        PrevGuide& prevGuide = m_PrevGuides[i];
+        if (groups[i] == NOT_SHARED)
+            continue;
+
+        if (permanentRemap[prevGuide.indexInPool] == REMOVED)
+            permanentRemap[prevGuide.indexInPool] = m_PrevGuideGroups[groups[i]].indexInPool[0];
+
+        prevGuide.indexInPool = permanentRemap[prevGuide.indexInPool];
+    }
+
+    // Patch indices
+    for (ResourceDesc& resource : m_Resources)
+    {
+        if (resource.type == ResourceType::PERMANENT_POOL)
+            resource.indexInPool = permanentRemap[resource.indexInPool];
+    }
+
+    for (PingPong& pingPong : m_PingPongs)
+    {
+        if (m_Resources[pingPong.resourceIndex].type == ResourceType::PERMANENT_POOL)
+            pingPong.indexInPoolToSwapWith = permanentRemap[pingPong.indexInPoolToSwapWith];
+    }
+
+    // Accesses to shared guides get patched every frame. Accesses preceding the first write (in the order of passes) read the previous frame
+    for (size_t i = 0; i < m_PrevGuides.size(); i++)
+    {
+        const PrevGuide& prevGuide = m_PrevGuides[i];
+        if (groups[i] == NOT_SHARED)
+            continue;
+
+        size_t dispatchBegin = m_DenoiserData[prevGuide.denoiserIndex].dispatchOffset;
+        size_t dispatchEnd = prevGuide.denoiserIndex + 1 < m_DenoiserData.size() ? m_DenoiserData[prevGuide.denoiserIndex + 1].dispatchOffset : m_Dispatches.size();
+
+        bool isCurrent = false;
+        for (size_t dispatchIndex = dispatchBegin; dispatchIndex < dispatchEnd; dispatchIndex++)
+        {
+            const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[dispatchIndex];
+            size_t resourceOffset = (size_t)internalDispatchDesc.resources;
+
+            for (uint32_t r = 0; r < internalDispatchDesc.resourcesNum; r++)
+            {
+                const ResourceDesc& resource = m_Resources[resourceOffset + r];
+                if (resource.type == ResourceType::PERMANENT_POOL && resource.indexInPool == prevGuide.indexInPool && resource.descriptorType == DescriptorType::STORAGE_TEXTURE)
+                    isCurrent = true;
+            }
+
+            for (uint32_t r = 0; r < internalDispatchDesc.resourcesNum; r++)
+            {
+                const ResourceDesc& resource = m_Resources[resourceOffset + r];
+                if (resource.type == ResourceType::PERMANENT_POOL && resource.indexInPool == prevGuide.indexInPool)
+                    m_PrevGuideResources.push_back( {resourceOffset + r, prevGuide.denoiserIndex, groups[i], isCurrent} );
+            }
+        }
+
+        assert("A previous-frame guide must be written" && isCurrent);
+    }
+
+    // Clears: each denoiser clears both textures of its shared guides
+    Vector<ClearResource> clearResources(m_ClearResources.begin(), m_ClearResources.end(), GetStdAllocator());
+    m_ClearResources.clear();
+    m_ClearResourceSlots.assign(m_ClearResourceSlots.size(), INVALID_INDEX);
+
+    for (size_t denoiserIndex = 0; denoiserIndex < m_DenoiserData.size(); denoiserIndex++)
+    {
+        DenoiserData& denoiserData = m_DenoiserData[denoiserIndex];
+        size_t clearResourceOffset = m_ClearResources.size();
+
+        for (size_t i = 0; i < denoiserData.clearResourceNum; i++)
+        {
+            ClearResource clearResource = clearResources[denoiserData.clearResourceOffset + i];
+            if (clearResource.resource.type == ResourceType::PERMANENT_POOL)
+            {
+                clearResource.resource.indexInPool = permanentRemap[clearResource.resource.indexInPool];
+
+                bool isShared = false;
+                for (const PrevGuideGroup& prevGuideGroup : m_PrevGuideGroups)
+                    isShared = isShared || clearResource.resource.indexInPool == prevGuideGroup.indexInPool[0] || clearResource.resource.indexInPool == prevGuideGroup.indexInPool[1];
+
+                if (isShared)
+                    continue;
+            }
+
+            AddClearResource(clearResource);
+        }
+
+        for (size_t i = 0; i < m_PrevGuides.size(); i++)
+        {
+            const PrevGuide& prevGuide = m_PrevGuides[i];
+            if (groups[i] == NOT_SHARED || prevGuide.denoiserIndex != denoiserIndex)
+                continue;
+
+            const PrevGuideGroup& prevGuideGroup = m_PrevGuideGroups[groups[i]];
+            for (uint16_t indexInPool : prevGuideGroup.indexInPool)
+            {
+                const TextureDesc& textureDesc = m_PermanentPool[indexInPool];
+                ResourceDesc resource = {DescriptorType::STORAGE_TEXTURE, ResourceType::PERMANENT_POOL, indexInPool};
+
+                AddClearResource( {denoiserData.desc.identifier, resource, textureDesc.downsampleFactor, g_IsIntegerFormat[(size_t)textureDesc.format]} );
+            }
+        }
+
+        denoiserData.clearResourceOffset = clearResourceOffset;
+        denoiserData.clearResourceNum = m_ClearResources.size() - clearResourceOffset;
+    }
+}
+
+void nrd::InstanceImpl::UpdatePrevGuides()
+{
+    // The texture written by the previous frame is read, the other one is written
+    uint32_t current = m_PrevGuideParity ^ 1;
+    for (const PrevGuideResource& prevGuideResource : m_PrevGuideResources)
+    {
+        const PrevGuideGroup& prevGuideGroup = m_PrevGuideGroups[prevGuideResource.group];
+        m_Resources[prevGuideResource.resourceIndex].indexInPool = prevGuideGroup.indexInPool[prevGuideResource.isCurrent ? current : m_PrevGuideParity];
+    }
+}
+
+void nrd::InstanceImpl::PushTexture(DescriptorType descriptorType, uint16_t localIndex, uint16_t indexToSwapWith, bool isArray)
+{
+    ResourceType resourceType = (ResourceType)localIndex;
+    uint16_t globalIndex = 0;
+
+    if (localIndex >= TRANSIENT_POOL_START)
+    {
+        resourceType = ResourceType::TRANSIENT_POOL;
+        globalIndex = m_IndexRemap[localIndex - TRANSIENT_POOL_START];
+
+        if (indexToSwapWith != uint16_t(-1))
+        {
+            assert(indexToSwapWith >= TRANSIENT_POOL_START && indexToSwapWith < PERMANENT_POOL_START);
+
+            indexToSwapWith = m_IndexRemap[indexToSwapWith - TRANSIENT_POOL_START];
+            m_PingPongs.push_back( {m_Resources.size(), indexToSwapWith} );
+        }
     }
     else if (localIndex >= PERMANENT_POOL_START)
     {
@@ -706,45 +2060,287 @@ void nrd::InstanceImpl::PushTexture(DescriptorType descriptorType, uint16_t loca
         }
     }
 
-    m_Resources.push_back( {descriptorType, resourceType, globalIndex} );
+    m_Resources.push_back( {descriptorType, resourceType, globalIndex, isArray} );
+}
+
+void nrd::InstanceImpl::PushBuffer(DescriptorType descriptorType, uint16_t localIndex)
+{
+    assert("Not an indirect arguments buffer" && localIndex >= INDIRECT_ARGUMENTS_POOL_START);
+
+    uint16_t globalIndex = m_IndirectArgumentsPoolOffset + localIndex - INDIRECT_ARGUMENTS_POOL_START;
+    m_Resources.push_back( {descriptorType, ResourceType::INDIRECT_ARGUMENTS_POOL, globalIndex} );
+}
+
+void nrd::InstanceImpl::AddClearResource(const ClearResource& clearResource)
+{
+    m_ClearResources.push_back(clearResource);
+
+    // Keep load factor <= 0.5
+    size_t clearResourceNum = m_ClearResources.size();
+    size_t begin = clearResourceNum - 1;
+    if (clearResourceNum * 2 > m_ClearResourceSlots.size())
+    {
+        m_ClearResourceSlots.assign(m_ClearResourceSlots.size() * 2, INVALID_INDEX);
+        begin = 0;
+    }
+
+    uint32_t mask = (uint32_t)m_ClearResourceSlots.size() - 1;
+    for (size_t i = begin; i < clearResourceNum; i++)
+    {
+        uint32_t slot = HashClearResource(m_ClearResources[i].resource) & mask;
+        while (m_ClearResourceSlots[slot] != INVALID_INDEX)
+            slot = (slot + 1) & mask;
+
+        m_ClearResourceSlots[slot] = (uint32_t)i;
+    }
 }
 
 void nrd::InstanceImpl::AddTextureToTransientPool(const TextureDesc& textureDesc)
 {
-    // Try to find a replacement from previous denoisers
-    for (uint16_t i = 0; i < m_TransientPoolOffset; i++)
+    // Memory gets assigned in "AliasTransientPool", when lifetimes are known
+    m_IndexRemap.push_back( (uint16_t)m_TransientPool.size() );
+    m_TransientPool.push_back(textureDesc);
+}
+
+void nrd::InstanceImpl::AliasTransientPool(const DenoiserData& denoiserData, size_t resourceOffset)
+{
+    size_t transientNum = m_TransientPool.size() - m_TransientPoolOffset;
+    if (!transientNum)
+        return;
+
+    // Lifetimes. A pass group (permutations and repeats of the same pass) is the smallest unit, because dispatches
+    // inside a group can be emitted in any order, while groups are always emitted in the order of addition
+    Vector<TransientLifetime> lifetimes(transientNum, {uint32_t(-1), 0}, GetStdAllocator());
+
+    uint32_t passGroup = 0;
+    for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < m_Dispatches.size(); dispatchIndex++)
+    {
+        const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[dispatchIndex];
+        if (dispatchIndex != denoiserData.dispatchOffset && strcmp(internalDispatchDesc.name, m_Dispatches[dispatchIndex - 1].name))
+            passGroup++;
+
+        const ResourceDesc* resources = m_Resources.data() + (size_t)internalDispatchDesc.resources;
+        for (uint32_t i = 0; i < internalDispatchDesc.resourcesNum; i++)
+        {
+            if (resources[i].type != ResourceType::TRANSIENT_POOL)
+                continue;
+
+            TransientLifetime& lifetime = lifetimes[resources[i].indexInPool - m_TransientPoolOffset];
+            lifetime.first = min(lifetime.first, passGroup);
+            lifetime.last = max(lifetime.last, passGroup);
+        }
+    }
+
+    // Ping-pong transients survive between frames
+    for (size_t i = 0; i < denoiserData.pingPongNum; i++)
+    {
+        const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
+        const ResourceDesc& resource = m_Resources[pingPong.resourceIndex];
+        if (resource.type == ResourceType::TRANSIENT_POOL)
+        {
+            lifetimes[resource.indexInPool - m_TransientPoolOffset] = {0, passGroup};
+            lifetimes[pingPong.indexInPoolToSwapWith - m_TransientPoolOffset] = {0, passGroup};
+        }
+    }
+
+    // Passes reading only guides produce identical textures in all denoisers, if guide sharing is enabled. Such textures are never aliased,
+    // and an identical pass of a next denoiser writes into the same textures, letting "GetComputeDispatches" skip it
+    const uint16_t NEW_SHARED_TEXTURE = uint16_t(-2);
+    Vector<uint16_t> sharedTextures(transientNum, uint16_t(-1), GetStdAllocator()); // "-1" - not shared
+
+    bool isPrivate = denoiserData.desc.isTransientPoolPrivate;
+    bool isShareable = m_IsGuideSharingEnabled && !isPrivate;
+    for (size_t dispatchIndex = denoiserData.dispatchOffset; dispatchIndex < m_Dispatches.size() && isShareable; dispatchIndex++)
     {
-        // Format and dimensions must match
-        const TextureDesc& t = m_TransientPool[i];
-        if (t.format == textureDesc.format && t.downsampleFactor == textureDesc.downsampleFactor)
+        const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[dispatchIndex];
+        const ResourceDesc* resources = m_Resources.data() + (size_t)internalDispatchDesc.resources;
+        if (!IsSharedPass(resources, internalDispatchDesc.resourcesNum))
+            continue;
+
+        // Outputs must not be written by other passes or swapped
+        bool isShared = true;
+        for (uint32_t r = 0; r < internalDispatchDesc.resourcesNum && isShared; r++)
         {
-            // The candidate must not be already in use in the current denoiser
-            size_t j = 0;
-            for (; j < m_IndexRemap.size(); j++)
+            if (resources[r].type != ResourceType::TRANSIENT_POOL)
+                continue;
+
+            uint16_t indexInPool = resources[r].indexInPool;
+
+            for (size_t i = denoiserData.dispatchOffset; i < m_Dispatches.size() && isShared; i++)
             {
-                if (m_IndexRemap[j] == i)
-                    break;
+                const InternalDispatchDesc& otherDispatchDesc = m_Dispatches[i];
+                if (otherDispatchDesc.pipelineIndex == internalDispatchDesc.pipelineIndex)
+                    continue;
+
+                const ResourceDesc* otherResources = m_Resources.data() + (size_t)otherDispatchDesc.resources;
+                for (uint32_t k = 0; k < otherDispatchDesc.resourcesNum && isShared; k++)
+                {
+                    const ResourceDesc& resource = otherResources[k];
+                    if (resource.type == ResourceType::TRANSIENT_POOL && resource.descriptorType == DescriptorType::STORAGE_TEXTURE && resource.indexInPool == indexInPool)
+                        isShared = false;
+                }
             }
 
-            // A replacement is found - reuse memory
-            if (j == m_IndexRemap.size())
+            for (size_t i = 0; i < denoiserData.pingPongNum && isShared; i++)
+            {
+                const PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
+                const ResourceDesc& resource = m_Resources[pingPong.resourceIndex];
+                if (resource.type == ResourceType::TRANSIENT_POOL && (resource.indexInPool == indexInPool || pingPong.indexInPoolToSwapWith == indexInPool))
+                    isShared = false;
+            }
+        }
+
+        if (!isShared)
+            continue;
+
+        // Find an identical pass in previous denoisers
+        const ResourceDesc* sharedResources = nullptr;
+        for (size_t i = 0; i < denoiserData.dispatchOffset && !sharedResources; i++)
+        {
+            const InternalDispatchDesc& otherDispatchDesc = m_Dispatches[i];
+            if (otherDispatchDesc.pipelineIndex != internalDispatchDesc.pipelineIndex || otherDispatchDesc.resourcesNum != internalDispatchDesc.resourcesNum)
+                continue;
+
+            const ResourceDesc* otherResources = m_Resources.data() + (size_t)otherDispatchDesc.resources;
+
+            uint32_t r = 0;
+            for (; r < internalDispatchDesc.resourcesNum; r++)
             {
-                m_IndexRemap.push_back(i);
+                const ResourceDesc& a = resources[r];
+                const ResourceDesc& b = otherResources[r];
+                if (a.descriptorType != b.descriptorType || a.type != b.type)
+                    break;
+
+                if (a.type == ResourceType::TRANSIENT_POOL)
+                {
+                    const TextureDesc& ta = m_TransientPool[a.indexInPool];
+                    const TextureDesc& tb = m_TransientPool[b.indexInPool];
+                    if (m_TransientPoolKinds[b.indexInPool] != TransientKind::SHARED || ta.format != tb.format || ta.downsampleFactor != tb.downsampleFactor || ta.layersNum != tb.layersNum)
+                        break;
+                }
+            }
+
+            if (r == internalDispatchDesc.resourcesNum)
+                sharedResources = otherResources;
+        }
+
+        for (uint32_t r = 0; r < internalDispatchDesc.resourcesNum; r++)
+        {
+            if (resources[r].type == ResourceType::TRANSIENT_POOL)
+                sharedTextures[resources[r].indexInPool - m_TransientPoolOffset] = sharedResources ? sharedResources[r].indexInPool : NEW_SHARED_TEXTURE;
+        }
+    }
+
+    // Order by the first use (greedy coloring of an interval graph is optimal in this order)
+    Vector<uint16_t> order(transientNum, 0, GetStdAllocator());
+    for (size_t i = 0; i < transientNum; i++)
+    {
+        size_t j = i;
+        for (; j > 0 && lifetimes[order[j - 1]].first > lifetimes[i].first; j--)
+            order[j] = order[j - 1];
+
+        order[j] = (uint16_t)i;
+    }
+
+    // Assign memory: textures from previous denoisers are free, own textures are free after the last use. Format and dimensions must match
+    Vector<TextureDesc> transientPool(m_TransientPool.begin() + m_TransientPoolOffset, m_TransientPool.end(), GetStdAllocator());
+    m_TransientPool.resize(m_TransientPoolOffset);
+    m_TransientPoolKinds.resize(m_TransientPoolOffset);
+
+    // Private and shared textures can't be reused
+    Vector<uint32_t> busyUntil(m_TransientPoolOffset, uint32_t(-1), GetStdAllocator()); // "-1" - not used in the current denoiser
+    for (size_t j = 0; j < busyUntil.size(); j++)
+    {
+        if (isPrivate || m_TransientPoolKinds[j] != TransientKind::ALIASABLE)
+            busyUntil[j] = uint32_t(-2); // "-2" - can't be reused
+    }
+    Vector<uint16_t> remap(transientNum, 0, GetStdAllocator());
+
+    for (uint16_t i : order)
+    {
+        const TextureDesc& textureDesc = transientPool[i];
+        const TransientLifetime& lifetime = lifetimes[i];
 
-                return;
+        uint16_t sharedTexture = sharedTextures[i];
+        if (sharedTexture != uint16_t(-1))
+        {
+            if (sharedTexture == NEW_SHARED_TEXTURE)
+            {
+                sharedTexture = (uint16_t)m_TransientPool.size();
+                m_TransientPool.push_back(textureDesc);
+                m_TransientPoolKinds.push_back(TransientKind::SHARED);
+                busyUntil.push_back(uint32_t(-2));
             }
+
+            remap[i] = sharedTexture;
+            continue;
+        }
+
+        size_t j = 0;
+        for (; j < m_TransientPool.size(); j++)
+        {
+            const TextureDesc& t = m_TransientPool[j];
+            if (t.format == textureDesc.format && t.downsampleFactor == textureDesc.downsampleFactor && t.layersNum == textureDesc.layersNum && (busyUntil[j] == uint32_t(-1) || busyUntil[j] < lifetime.first))
+                break;
+        }
+
+        // A replacement is not found - add memory
+        if (j == m_TransientPool.size())
+        {
+            m_TransientPool.push_back(textureDesc);
+            m_TransientPoolKinds.push_back(isPrivate ? TransientKind::PRIVATE : TransientKind::ALIASABLE);
+            busyUntil.push_back(uint32_t(-1));
+        }
+
+        // Unused textures don't occupy memory
+        if (lifetime.first <= lifetime.last)
+            busyUntil[j] = lifetime.last;
+
+        remap[i] = (uint16_t)j;
+    }
+
+    // Patch indices
+    for (size_t i = resourceOffset; i < m_Resources.size(); i++)
+    {
+        ResourceDesc& resource = m_Resources[i];
+        if (resource.type == ResourceType::TRANSIENT_POOL)
+            resource.indexInPool = remap[resource.indexInPool - m_TransientPoolOffset];
+    }
+
+    for (size_t i = 0; i < denoiserData.pingPongNum; i++)
+    {
+        PingPong& pingPong = m_PingPongs[denoiserData.pingPongOffset + i];
+        if (m_Resources[pingPong.resourceIndex].type == ResourceType::TRANSIENT_POOL)
+            pingPong.indexInPoolToSwapWith = remap[pingPong.indexInPoolToSwapWith - m_TransientPoolOffset];
+    }
+}
+
+bool nrd::InstanceImpl::IsSharedPass(const ResourceDesc* resources, uint32_t resourcesNum) const
+{
+    // Guides are the same for all denoisers in a "GetComputeDispatches" call
+    bool hasOutputs = false;
+    for (uint32_t i = 0; i < resourcesNum; i++)
+    {
+        const ResourceDesc& resource = resources[i];
+        if (resource.descriptorType == DescriptorType::STORAGE_TEXTURE)
+        {
+            if (resource.type != ResourceType::TRANSIENT_POOL)
+                return false;
+
+            hasOutputs = true;
         }
+        else if (resource.type != ResourceType::IN_MV && resource.type != ResourceType::IN_NORMAL_ROUGHNESS && resource.type != ResourceType::IN_VIEWZ)
+            return false;
     }
 
-    // A replacement is not found - add memory
-    m_IndexRemap.push_back( (uint16_t)m_TransientPool.size() );
-    m_TransientPool.push_back(textureDesc);
+    return hasOutputs;
 }
 
-void* nrd::InstanceImpl::PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex)
+void* nrd::InstanceImpl::PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex, uint16_t layersNum)
 {
     size_t dispatchIndex = denoiserData.dispatchOffset + localIndex;
     const InternalDispatchDesc& internalDispatchDesc = m_Dispatches[dispatchIndex];
+    assert("Permutation of a disabled feature" && internalDispatchDesc.pipelineIndex != UNUSED_PIPELINE_INDEX);
 
     // Copy data
     DispatchDesc dispatchDesc = {};
@@ -753,28 +2349,25 @@ void* nrd::InstanceImpl::PushDispatch(const DenoiserData& denoiserData, uint32_t
     dispatchDesc.resources = internalDispatchDesc.resources;
     dispatchDesc.resourcesNum = internalDispatchDesc.resourcesNum;
     dispatchDesc.pipelineIndex = internalDispatchDesc.pipelineIndex;
+    dispatchDesc.isIndirect = internalDispatchDesc.isIndirect;
 
-    // Update constant data
-    if (m_ConstantDataOffset + internalDispatchDesc.constantBufferDataSize > CONSTANT_DATA_SIZE)
+    // Update constant data. Shared constants are referenced, only pass specific constants get memory. The returned pointer addresses the whole
+    // constants structure (16-byte aligned), but only members past shared constants can be written. Memory before the tail belongs to previously
+    // pushed data (at least the shared constants block)
+    uint8_t* constants = nullptr;
+    if (internalDispatchDesc.constantBufferDataSize)
     {
-        assert("Constant data doesn't fit into the prealocated array!" && false);
-        dispatchDesc.constantBufferData = nullptr; // TODO: better crash
-    }
-    else
-        dispatchDesc.constantBufferData = m_ConstantData + m_ConstantDataOffset;
+        size_t sharedConstantsSize = m_SharedConstantsSize;
+        size_t sharedConstantsAlignedSize = sharedConstantsSize & ~(sizeof(float4) - 1);
+        constants = PushConstantData(internalDispatchDesc.constantBufferDataSize - sharedConstantsAlignedSize) - sharedConstantsAlignedSize;
 
-    dispatchDesc.constantBufferDataSize = internalDispatchDesc.constantBufferDataSize;
-    m_ConstantDataOffset += internalDispatchDesc.constantBufferDataSize;
+        // Padding must be deterministic, since constants get compared
+        memset(constants + sharedConstantsSize, 0, internalDispatchDesc.constantBufferDataSize - sharedConstantsSize);
 
-    dispatchDesc.constantBufferDataMatchesPreviousDispatch = false;
-    if (!m_ActiveDispatches.empty())
-    {
-        const DispatchDesc& dispatchDescPrev = m_ActiveDispatches.back();
-        if (dispatchDescPrev.constantBufferDataSize == dispatchDesc.constantBufferDataSize)
-        {
-            if (!memcmp(dispatchDescPrev.constantBufferData, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize))
-                dispatchDesc.constantBufferDataMatchesPreviousDispatch = true;
-        }
+        dispatchDesc.sharedConstantBufferData = sharedConstantsSize ? m_ConstantData + m_SharedConstantsOffset : nullptr;
+        dispatchDesc.sharedConstantBufferDataSize = (uint32_t)sharedConstantsSize;
+        dispatchDesc.constantBufferData = constants + sharedConstantsSize;
+        dispatchDesc.constantBufferDataSize = internalDispatchDesc.constantBufferDataSize - (uint32_t)sharedConstantsSize;
     }
 
     // Update grid size
@@ -794,15 +2387,42 @@ void* nrd::InstanceImpl::PushDispatch(const DenoiserData& denoiserData, uint32_t
         h = m_CommonSettings.resourceSize[1];
         d = 1;
     }
+    else if (d == SINGLE_GROUP)
+    {
+        w = internalDispatchDesc.numThreads.width;
+        h = internalDispatchDesc.numThreads.height;
+        d = 1;
+    }
+
+    // Indirect dispatches cover whole tiles, the grid is an upper bound of the indirect arguments
+    if (internalDispatchDesc.isIndirect)
+    {
+        w = uint16_t(DivideUp(w, TILE_SIZE) * TILE_SIZE);
+        h = uint16_t(DivideUp(h, TILE_SIZE) * TILE_SIZE);
+    }
 
     w = DivideUp(w, d);
     h = DivideUp(h, d);
 
     dispatchDesc.gridWidth = DivideUp(w, internalDispatchDesc.numThreads.width);
     dispatchDesc.gridHeight = DivideUp(h, internalDispatchDesc.numThreads.height);
+    dispatchDesc.gridDepth = layersNum;
+    dispatchDesc.viewIndex = (uint16_t)m_ViewIndex;
 
     // Store
     m_ActiveDispatches.push_back(dispatchDesc);
 
-    return (void*)dispatchDesc.constantBufferData;
+    return constants;
+}
+
+uint8_t* nrd::InstanceImpl::PushConstantData(size_t constantDataSize)
+{
+    // The arena is sized for the worst case in "Create", growing is a safety net
+    size_t constantDataOffset = m_ConstantDataOffset + constantDataSize;
+    if (constantDataOffset > m_ConstantDataSize)
+        AllocateConstantData(max(constantDataOffset, m_ConstantDataSize * 2));
+
+    uint8_t* constantData = m_ConstantData + m_ConstantDataOffset;
+    m_ConstantDataOffset = constantDataOffset;
+    return constantData;
 }
@@ -10,7 +10,9 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #pragma once
 
+#include <assert.h> // assert
 #include <cstring> // memset
+#include <cstddef> // offsetof
 
 #include "NRD.h"
 
@@ -21,6 +23,8 @@ typedef nrd::AllocationCallbacks AllocationCallbacks;
 #include "MathLib/ml.h"
 #include "MathLib/ml.hlsli"
 
+#include "../Shaders/Include/NRD.hlsli"
+
 #define _NRD_STRINGIFY(s) #s
 #define NRD_STRINGIFY(s) _NRD_STRINGIFY(s)
 
@@ -47,10 +51,16 @@ typedef nrd::AllocationCallbacks AllocationCallbacks;
         downsampleFactor, sizeof(passName ## Constants), 1, #shaderName ".cs", \
         GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
 
-#define AddDispatchNoConstants(shaderName, passName, downsampleFactor) \
-    AddComputeDispatchDesc(NumThreads(passName ## GroupX, passName ## GroupY), \
-        downsampleFactor, 0, 1, #shaderName ".cs", \
-        GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
+#ifdef NRD_BINDLESS
+    // Resource indices travel in constants
+    #define AddDispatchNoConstants(shaderName, passName, downsampleFactor) \
+        AddDispatch(shaderName, passName, downsampleFactor)
+#else
+    #define AddDispatchNoConstants(shaderName, passName, downsampleFactor) \
+        AddComputeDispatchDesc(NumThreads(passName ## GroupX, passName ## GroupY), \
+            downsampleFactor, 0, 1, #shaderName ".cs", \
+            GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
+#endif
 
 #define AddDispatchRepeated(shaderName, passName, downsampleFactor, repeatNum) \
     AddComputeDispatchDesc(NumThreads(passName ## GroupX, passName ## GroupY), \
@@ -80,7 +90,11 @@ typedef nrd::AllocationCallbacks AllocationCallbacks;
 // IMPORTANT: do not use "float3" constants because of sizeof( ml::float3 ) = 16!
 #define NRD_CONSTANTS_START( name ) struct name {
 #define NRD_CONSTANT( type, name ) type name;
-#define NRD_CONSTANTS_END };
+#ifdef NRD_BINDLESS
+    #define NRD_CONSTANTS_END alignas(16) uint32_t gNrdBindlessIndices[NRD_BINDLESS_INDICES_NUM]; };
+#else
+    #define NRD_CONSTANTS_END };
+#endif
 
 #define NRD_INPUTS_START
 #define NRD_INPUT(...)
@@ -99,23 +113,133 @@ namespace nrd
 {
     constexpr uint16_t PERMANENT_POOL_START = 1000;
     constexpr uint16_t TRANSIENT_POOL_START = 2000;
-    constexpr size_t CONSTANT_DATA_SIZE = 128 * 1024; // TODO: improve
+    constexpr uint16_t INDIRECT_ARGUMENTS_POOL_START = 3000;
+
+    constexpr uint32_t INVALID_INDEX = uint32_t(-1);
 
     constexpr uint16_t USE_MAX_DIMS = 0xFFFF;
     constexpr uint16_t IGNORE_RS = 0xFFFE;
+    constexpr uint16_t SINGLE_GROUP = 0xFFFD;
+
+    constexpr uint32_t INDIRECT_ARGUMENTS_SIZE = sizeof(uint32_t) * 3;
 
     inline uint16_t DivideUp(uint32_t x, uint16_t y)
     { return uint16_t((x + y - 1) / y); }
 
     template <class T>
-    inline uint16_t AsUint(T x)
+    constexpr uint16_t AsUint(T x)
     { return (uint16_t)x; }
 
+    // A pass of a denoiser: "permutationNum" x "variantNum" dispatches (a variant is an alternative shader of a permutation, like the performance mode)
+    struct PassDesc
+    {
+        uint32_t permutationNum;
+        uint32_t variantNum;
+        DenoiserFeatureBits feature = DenoiserFeatureBits::NONE; // needed by all dispatches of the pass (see "DenoiserDesc::disabledFeatures")
+    };
+
+    // Features needed by variants: the second one is the performance mode
+    constexpr std::array<DenoiserFeatureBits, 2> g_VariantFeatures = {DenoiserFeatureBits::NONE, DenoiserFeatureBits::PERFORMANCE_MODE};
+
+    // Tables of passes drive both "Add_*" (see "AddPasses") and "Update_*", so dispatch indices can't go out of sync
+    template <class Pass, size_t N>
+    constexpr uint32_t GetDispatchIndex(const std::array<PassDesc, N>& passDescs, Pass pass, uint32_t permutation = 0, uint32_t variant = 0)
+    {
+        uint32_t dispatchIndex = 0;
+        for (size_t i = 0; i < (size_t)pass; i++)
+            dispatchIndex += passDescs[i].permutationNum * passDescs[i].variantNum;
+
+        return dispatchIndex + permutation * passDescs[(size_t)pass].variantNum + variant;
+    }
+
+    template <size_t N>
+    constexpr uint32_t GetMaxVariantNum(const std::array<PassDesc, N>& passDescs)
+    {
+        uint32_t maxVariantNum = 0;
+        for (const PassDesc& passDesc : passDescs)
+            maxVariantNum = passDesc.variantNum > maxVariantNum ? passDesc.variantNum : maxVariantNum;
+
+        return maxVariantNum;
+    }
+
+    // FNV-1a over 4 independent 64-bit lanes, then over 64-bit words (constant blocks are hashed every frame), high bits get folded down because callers mask low bits
+    inline uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+
+        size_t i = 0;
+        if (size >= sizeof(uint64_t) * 4)
+        {
+            uint64_t lane0 = hash;
+            uint64_t lane1 = hash ^ 1;
+            uint64_t lane2 = hash ^ 2;
+            uint64_t lane3 = hash ^ 3;
+
+            for (; i + sizeof(uint64_t) * 4 <= size; i += sizeof(uint64_t) * 4)
+            {
+                uint64_t words[4];
+                memcpy(words, bytes + i, sizeof(words));
+
+                lane0 = (lane0 ^ words[0]) * 1099511628211ull;
+                lane1 = (lane1 ^ words[1]) * 1099511628211ull;
+                lane2 = (lane2 ^ words[2]) * 1099511628211ull;
+                lane3 = (lane3 ^ words[3]) * 1099511628211ull;
+            }
+
+            hash = lane0 ^ (lane1 * 31) ^ (lane2 * 961) ^ (lane3 * 29791);
+        }
+
+        // Tails of constant blocks, pointers
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            memcpy(&word, bytes + i, sizeof(word));
+
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+
+        for (; i < size; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+
+        return hash ^ (hash >> 32);
+    }
+
+    inline uint32_t HashString(const char* string)
+    { return (uint32_t)HashBytes(string, strlen(string)); }
+
+    inline bool IsReadOnly(DescriptorType descriptorType)
+    { return descriptorType == DescriptorType::TEXTURE || descriptorType == DescriptorType::INDIRECT_ARGUMENTS; }
+
+    inline uint32_t HashClearResource(const ResourceDesc& resource)
+    { return (((uint32_t)resource.type << 16) | resource.indexInPool) * 2654435761u; }
+
+    // Same pipeline, resources, grid and constants
+    inline bool IsSameDispatch(const DispatchDesc& a, const DispatchDesc& b)
+    {
+        if (a.pipelineIndex != b.pipelineIndex || a.resourcesNum != b.resourcesNum || a.gridWidth != b.gridWidth || a.gridHeight != b.gridHeight || a.gridDepth != b.gridDepth)
+            return false;
+
+        for (uint32_t i = 0; i < a.resourcesNum; i++)
+        {
+            if (a.resources[i].descriptorType != b.resources[i].descriptorType || a.resources[i].type != b.resources[i].type || a.resources[i].indexInPool != b.resources[i].indexInPool)
+                return false;
+        }
+
+        if (a.sharedConstantBufferDataSize != b.sharedConstantBufferDataSize || a.constantBufferDataSize != b.constantBufferDataSize)
+            return false;
+
+        bool isSameSharedConstants = !a.sharedConstantBufferDataSize || !memcmp(a.sharedConstantBufferData, b.sharedConstantBufferData, a.sharedConstantBufferDataSize);
+        bool isSameConstants = !a.constantBufferDataSize || !memcmp(a.constantBufferData, b.constantBufferData, a.constantBufferDataSize);
+
+        return isSameSharedConstants && isSameConstants;
+    }
+
     union Settings
     {
         ReblurSettings reblur;
         RelaxSettings relax;
         SigmaSettings sigma;
+        SigmaArraySettings sigmaArray;
         ReferenceSettings reference;
     };
 
@@ -127,6 +251,31 @@ namespace nrd
         size_t dispatchOffset;
         size_t pingPongOffset;
         size_t pingPongNum;
+        size_t clearResourceOffset;
+        size_t clearResourceNum;
+    };
+
+    // Projection derived state of a view (indexed by "DispatchDesc::viewIndex"), recomputed only if the projection changes
+    struct ViewProjection
+    {
+        float viewToClipMatrix[16];
+        float viewToClipMatrixPrev[16];
+        float4x4 viewToClip;
+        float4x4 viewToClipPrev;
+        float4x4 clipToView;
+        float4x4 clipToViewPrev;
+        float4 frustum;
+        float4 frustumPrev;
+        float projectY;
+        float orthoMode;
+        bool isLeftHanded;
+        bool isValid;
+    };
+
+    struct IdentifierSlot
+    {
+        Identifier identifier;
+        uint32_t denoiserIndex;
     };
 
     struct PingPong
@@ -135,12 +284,34 @@ namespace nrd
         uint16_t indexInPoolToSwapWith;
     };
 
+    // A permanent texture holding a previous-frame copy of a guide
+    struct PrevGuide
+    {
+        uint32_t denoiserIndex;
+        ResourceType guide;
+        uint16_t indexInPool;
+    };
+
+    // Previous-frame guides shared by several denoisers: the texture written in the previous frame is read, the other one is written
+    struct PrevGuideGroup
+    {
+        uint16_t indexInPool[2];
+    };
+
+    struct PrevGuideResource
+    {
+        size_t resourceIndex;
+        uint32_t denoiserIndex;
+        uint16_t group;
+        bool isCurrent; // accessed after the guide is written in the current frame
+    };
+
     struct NumThreads
     {
-        inline NumThreads(uint8_t w, uint8_t h) : width(w), height(h)
+        constexpr NumThreads(uint8_t w, uint8_t h) : width(w), height(h)
         {}
 
-        inline NumThreads() : width(0), height(0)
+        constexpr NumThreads() : width(0), height(0)
         {}
 
         uint8_t width;
@@ -159,6 +330,99 @@ namespace nrd
         uint16_t downsampleFactor;
         uint16_t maxRepeatsNum; // mostly for internal use
         NumThreads numThreads;
+        bool isIndirect;
+    };
+
+    // Frame plan: dispatches, emitted by a denoiser in "m_ActiveDispatches"
+    struct FramePlanDenoiser
+    {
+        const DenoiserData* denoiserData;
+        size_t dispatchOffset;
+        size_t dispatchNum;
+        size_t sharedConstantsOffset;
+    };
+
+    // Frame plan: a per-frame constant, which must be refreshed even if the plan is reused
+    struct FramePlanPatch
+    {
+        size_t constantDataOffset;
+        const float4* source;
+    };
+
+    // Memory of a "GetComputeDispatches" call (the frame plan and its outputs), which stays valid until "ReleaseFrame". A slot
+    // is swapped into the instance for recording, i.e. dispatches, constants and barriers are recorded in place
+    struct FrameSlot
+    {
+        inline FrameSlot(const StdAllocator<uint8_t>& stdAllocator) :
+            dispatches(stdAllocator)
+            , dispatchResources(stdAllocator)
+            , resources(stdAllocator)
+            , clearBatchResources(stdAllocator)
+            , framePlanDenoisers(stdAllocator)
+            , framePlanPatches(stdAllocator)
+            , barriers(stdAllocator)
+            , barrierOffsets(stdAllocator)
+            , dependencies(stdAllocator)
+        {}
+
+        Vector<DispatchDesc> dispatches;
+        Vector<const ResourceDesc*> dispatchResources;
+        Vector<ResourceDesc> resources;
+        Vector<ResourceDesc> clearBatchResources;
+        Vector<FramePlanDenoiser> framePlanDenoisers;
+        Vector<FramePlanPatch> framePlanPatches;
+        Vector<BarrierDesc> barriers;
+        Vector<uint32_t> barrierOffsets;
+        Vector<DispatchDependencyDesc> dependencies;
+        uint8_t* constantDataUnaligned = nullptr;
+        uint8_t* constantData = nullptr;
+        size_t constantDataOffset = 0;
+        size_t constantDataSize = 0;
+        size_t dependencyOffsets[2] = {};
+        size_t dependencyNums[2] = {};
+        uint64_t framePlanCallIndex = 0;
+        uint32_t framePlanParity = 0;
+        uint32_t barrierPlanMask = 0;
+        uint32_t dependencyPlanMask = 0;
+        uint32_t viewsNum = 1;
+        bool isFramePlanValid = false;
+        bool isInFlight = false;
+    };
+
+    // Open addressing hash table entry
+    struct ConstantBlockSlot
+    {
+        uint64_t hash;
+        uint32_t dispatchIndex;
+        uint32_t patchesOffset; // per-frame patches of the block ("m_FramePlanPatches")
+        uint32_t patchesNum;
+    };
+
+    // Dependency graph: the last writer and readers since the last write of a resource
+    struct ResourceHazard
+    {
+        uint32_t writer;
+        uint32_t readers; // head of a list in "m_HazardReaders"
+    };
+
+    struct HazardReader
+    {
+        uint32_t dispatchIndex;
+        uint32_t next;
+    };
+
+    // Lifetime of a transient texture in a denoiser, in units of pass groups
+    struct TransientLifetime
+    {
+        uint32_t first;
+        uint32_t last;
+    };
+
+    enum class TransientKind : uint8_t
+    {
+        ALIASABLE, // can be reused by next denoisers
+        PRIVATE, // owned by a denoiser with "isTransientPoolPrivate = true"
+        SHARED // written by a pass, which is identical in several denoisers
     };
 
     struct ClearResource
@@ -169,6 +433,137 @@ namespace nrd
         bool isInteger;
     };
 
+    // Stands in for "InstanceImpl" when "AddPass" lambdas get evaluated at compile time (see "g_PassCheckers"): counts dispatches and descriptors bound to each shader
+    class PassChecker
+    {
+    public:
+        static constexpr uint32_t SHADER_SLOT_NUM = 512; // enough for all shaders of a denoiser family
+
+        template <class Pass, size_t N, class AddPass>
+        static constexpr PassChecker Check(const std::array<PassDesc, N>& passDescs, const AddPass& addPass)
+        {
+            PassChecker passChecker = {};
+            for (size_t pass = 0; pass < N; pass++)
+            {
+                for (uint32_t permutation = 0; permutation < passDescs[pass].permutationNum; permutation++)
+                {
+                    uint32_t dispatchNum = passChecker.m_DispatchNum;
+                    addPass(passChecker, (Pass)pass, permutation);
+                    if (passChecker.m_DispatchNum - dispatchNum != passDescs[pass].variantNum)
+                        passChecker.m_IsDispatchPerVariant = false;
+                }
+            }
+
+            return passChecker;
+        }
+
+        // Pipelines are shared by denoisers of a family, so shaders get merged across "Add_*" functions
+        static constexpr bool IsLayoutShared(std::initializer_list<const PassChecker*> passCheckers)
+        {
+            PassChecker merged = {};
+            for (const PassChecker* passChecker : passCheckers)
+            {
+                if (!passChecker->m_IsLayoutShared)
+                    merged.m_IsLayoutShared = false;
+
+                for (const ShaderSlot& shaderSlot : passChecker->m_ShaderSlots)
+                {
+                    if (shaderSlot.hash)
+                        merged.AddShader(shaderSlot);
+                }
+            }
+
+            return merged.m_IsLayoutShared;
+        }
+
+        constexpr bool IsDispatchPerVariant() const
+        { return m_IsDispatchPerVariant; }
+
+        constexpr void PushInput(uint16_t, uint16_t = uint16_t(-1))
+        { PushDescriptor(DescriptorType::TEXTURE); }
+
+        constexpr void PushOutput(uint16_t, uint16_t = uint16_t(-1))
+        { PushDescriptor(DescriptorType::STORAGE_TEXTURE); }
+
+        constexpr void PushArrayInput(uint16_t)
+        { PushDescriptor(DescriptorType::TEXTURE); }
+
+        constexpr void PushArrayOutput(uint16_t)
+        { PushDescriptor(DescriptorType::STORAGE_TEXTURE); }
+
+        constexpr void PushIndirectArgumentsOutput(uint16_t)
+        { PushDescriptor(DescriptorType::STORAGE_BUFFER); }
+
+        constexpr void PushIndirectArguments(uint16_t)
+        { PushDescriptor(DescriptorType::INDIRECT_ARGUMENTS); }
+
+        constexpr void _PushPass(const char*)
+        { m_Layout = 0; }
+
+        constexpr void AddComputeDispatchDesc(NumThreads, uint16_t, uint32_t, uint32_t, const char* shaderFileName, const ComputeShaderDesc&, const ComputeShaderDesc&, const ComputeShaderDesc&)
+        {
+            // 64-bit FNV-1a: names are compared by hash only (a collision can only fail the check, not hide a mismatch)
+            ShaderSlot shaderSlot = {14695981039346656037ull, m_Layout};
+            for (const char* c = shaderFileName; *c; c++)
+                shaderSlot.hash = (shaderSlot.hash ^ (uint8_t)*c) * 1099511628211ull;
+
+            AddShader(shaderSlot);
+            m_DispatchNum++;
+        }
+
+    private:
+        struct ShaderSlot
+        {
+            uint64_t hash; // 0 - empty
+            uint32_t layout;
+        };
+
+        // Descriptors per "DescriptorType", 8 bits each
+        constexpr void PushDescriptor(DescriptorType descriptorType)
+        {
+            assert("Too many descriptors" && ((m_Layout >> (8 * (uint32_t)descriptorType)) & 0xFF) != 0xFF);
+            m_Layout += 1u << (8 * (uint32_t)descriptorType);
+        }
+
+        constexpr void AddShader(const ShaderSlot& shaderSlot)
+        {
+            assert("Too many shaders" && m_ShaderNum < SHADER_SLOT_NUM / 2);
+
+            uint32_t mask = SHADER_SLOT_NUM - 1;
+            for (uint32_t i = (uint32_t)shaderSlot.hash & mask; ; i = (i + 1) & mask)
+            {
+                ShaderSlot& temp = m_ShaderSlots[i];
+                if (!temp.hash)
+                {
+                    temp = shaderSlot;
+                    m_ShaderNum++;
+
+                    return;
+                }
+
+                if (temp.hash == shaderSlot.hash)
+                {
+                    if (temp.layout != shaderSlot.layout)
+                        m_IsLayoutShared = false;
+
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::array<ShaderSlot, SHADER_SLOT_NUM> m_ShaderSlots = {};
+        uint32_t m_Layout = 0;
+        uint32_t m_ShaderNum = 0;
+        uint32_t m_DispatchNum = 0;
+        bool m_IsDispatchPerVariant = true;
+        bool m_IsLayoutShared = true;
+    };
+
+    // Dispatches and layouts of an "Add_*" function, computed once per pass table and lambda
+    template <class Pass, const auto& passDescs, const auto& addPass>
+    constexpr PassChecker g_PassCheckers = PassChecker::Check<Pass>(passDescs, addPass);
+
     class InstanceImpl
     {
     // Add denoisers here
@@ -186,7 +581,7 @@ namespace nrd
         void Add_ReblurDiffuseDirectionalOcclusion(DenoiserData& denoiserData);
         void Update_Reblur(const DenoiserData& denoiserData);
         void Update_ReblurOcclusion(const DenoiserData& denoiserData);
-        void AddSharedConstants_Reblur(const ReblurSettings& settings, void* data);
+        size_t AddSharedConstants_Reblur(const ReblurSettings& settings, void* data);
 
         // Relax
         void Add_RelaxDiffuse(DenoiserData& denoiserData);
@@ -196,13 +591,16 @@ namespace nrd
         void Add_RelaxDiffuseSpecular(DenoiserData& denoiserData);
         void Add_RelaxDiffuseSpecularSh(DenoiserData& denoiserData);
         void Update_Relax(const DenoiserData& denoiserData);
-        void AddSharedConstants_Relax(const RelaxSettings& settings, void* data);
+        size_t AddSharedConstants_Relax(const RelaxSettings& settings, void* data);
 
         // Sigma
         void Add_SigmaShadow(DenoiserData& denoiserData);
         void Add_SigmaShadowTranslucency(DenoiserData& denoiserData);
+        void Add_SigmaShadowArray(DenoiserData& denoiserData);
         void Update_SigmaShadow(const DenoiserData& denoiserData);
-        void AddSharedConstants_Sigma(const SigmaSettings& settings, void* data);
+        void Update_SigmaShadowArray(const DenoiserData& denoiserData);
+        size_t AddSharedConstants_Sigma(const SigmaSettings& settings, void* data);
+        size_t AddSharedConstants_SigmaArray(const SigmaArraySettings& settings, uint16_t layersNum, void* data);
 
         // Other
         void Add_Reference(DenoiserData& denoiserData);
@@ -215,25 +613,50 @@ namespace nrd
             , m_DenoiserData(GetStdAllocator())
             , m_PermanentPool(GetStdAllocator())
             , m_TransientPool(GetStdAllocator())
+            , m_TransientPoolKinds(GetStdAllocator())
+            , m_TransientPoolWriters(GetStdAllocator())
             , m_Resources(GetStdAllocator())
             , m_ClearResources(GetStdAllocator())
+            , m_ClearBatchResources(GetStdAllocator())
             , m_PingPongs(GetStdAllocator())
+            , m_PrevGuides(GetStdAllocator())
+            , m_PrevGuideGroups(GetStdAllocator())
+            , m_PrevGuideResources(GetStdAllocator())
+            , m_PrevGuideGroupViews(GetStdAllocator())
             , m_ResourceRanges(GetStdAllocator())
             , m_Pipelines(GetStdAllocator())
             , m_Dispatches(GetStdAllocator())
             , m_ActiveDispatches(GetStdAllocator())
+            , m_DispatchResources(GetStdAllocator())
+            , m_FrameResources(GetStdAllocator())
             , m_IndexRemap(GetStdAllocator())
+            , m_IdentifierSlots(GetStdAllocator())
+            , m_PipelineSlots(GetStdAllocator())
+            , m_ClearResourceSlots(GetStdAllocator())
+            , m_ActiveDenoisers(GetStdAllocator())
+            , m_FramePlanDenoisers(GetStdAllocator())
+            , m_FramePlanPatches(GetStdAllocator())
+            , m_ConstantBlockSlots(GetStdAllocator())
+            , m_Barriers(GetStdAllocator())
+            , m_BarrierOffsets(GetStdAllocator())
+            , m_ResourceStates(GetStdAllocator())
+            , m_Dependencies(GetStdAllocator())
+            , m_ResourceHazards(GetStdAllocator())
+            , m_HazardReaders(GetStdAllocator())
+            , m_DependencyMarks(GetStdAllocator())
+            , m_DenoiserViews(GetStdAllocator())
+            , m_TransientPoolViews(GetStdAllocator())
+            , m_ViewDispatchOffsets(GetStdAllocator())
+            , m_ViewDispatches(GetStdAllocator())
+            , m_ViewProjections(GetStdAllocator())
+            , m_FrameSlots(GetStdAllocator())
+            , m_FramePlanKey(GetStdAllocator())
+            , m_FramePlanKeyPrev(GetStdAllocator())
         {
-            m_ConstantDataUnaligned = m_StdAllocator.allocate(CONSTANT_DATA_SIZE + sizeof(float4));
-
-            // IMPORTANT: underlying memory for constants must be aligned, as well as any individual SSE-type containing member,
-            // because a compiler can generate dangerous "movaps" instruction!
-            m_ConstantData = Align(m_ConstantDataUnaligned, sizeof(float4));
-            memset(m_ConstantData, 0, CONSTANT_DATA_SIZE);
-
             m_DenoiserData.reserve(8);
             m_PermanentPool.reserve(32);
             m_TransientPool.reserve(32);
+            m_TransientPoolKinds.reserve(32);
             m_Resources.reserve(128);
             m_ClearResources.reserve(32);
             m_PingPongs.reserve(32);
@@ -241,10 +664,25 @@ namespace nrd
             m_Pipelines.reserve(32);
             m_Dispatches.reserve(32);
             m_ActiveDispatches.reserve(32);
+            m_FramePlanDenoisers.reserve(8);
+            m_FramePlanPatches.reserve(32);
+            m_ConstantBlockSlots.reserve(64);
+            m_Barriers.reserve(256);
+            m_BarrierOffsets.reserve(64);
+            m_ResourceStates.reserve(128);
         }
 
         ~InstanceImpl()
-        { m_StdAllocator.deallocate(m_ConstantDataUnaligned, 0); }
+        {
+            if (m_ConstantDataUnaligned)
+                m_StdAllocator.deallocate(m_ConstantDataUnaligned, 0);
+
+            for (FrameSlot& frameSlot : m_FrameSlots)
+            {
+                if (frameSlot.constantDataUnaligned)
+                    m_StdAllocator.deallocate(frameSlot.constantDataUnaligned, 0);
+            }
+        }
 
         inline const InstanceDesc& GetDesc() const
         { return m_Desc; }
@@ -252,61 +690,228 @@ namespace nrd
         inline StdAllocator<uint8_t>& GetStdAllocator()
         { return m_StdAllocator; }
 
+        inline const StdAllocator<uint8_t>& GetStdAllocator() const
+        { return m_StdAllocator; }
+
         Result Create(const InstanceCreationDesc& instanceCreationDesc);
+        Result CreateFrameContext(const InstanceImpl& instanceImpl);
         Result SetCommonSettings(const CommonSettings& commonSettings);
         Result SetDenoiserSettings(Identifier identifier, const void* denoiserSettings);
         Result GetComputeDispatches(const Identifier* identifiers, uint32_t identifiersNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
+        Result GetComputeDispatchesMultiView(const ViewDesc* viewDescs, uint32_t viewDescsNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
+        Result GetDispatchDependencies(const DispatchDependencyDesc*& dependencyDescs, uint32_t& dependencyDescsNum);
+        Result ReleaseFrame(const DispatchDesc* dispatchDescs);
 
     private:
-        void AddComputeDispatchDesc
-        (
-            NumThreads numThreads,
-            uint16_t downsampleFactor,
-            uint32_t constantBufferDataSize,
-            uint32_t maxRepeatNum,
-            const char* shaderFileName,
-            const ComputeShaderDesc& dxbc,
-            const ComputeShaderDesc& dxil,
-            const ComputeShaderDesc& spirv
-        );
-
         void PrepareDesc();
+        void AliasTransientPool(const DenoiserData& denoiserData, size_t resourceOffset);
+        bool IsSharedPass(const ResourceDesc* resources, uint32_t resourcesNum) const;
+        void AllocateConstantData(size_t constantDataSize);
         void UpdatePingPong(const DenoiserData& denoiserData);
-        void PushTexture(DescriptorType descriptorType, uint16_t localIndex, uint16_t indexToSwapWith = uint16_t(-1));
+        void SharePrevGuides();
+        void UpdatePrevGuides();
+        void PushTexture(DescriptorType descriptorType, uint16_t localIndex, uint16_t indexToSwapWith = uint16_t(-1), bool isArray = false);
+        void PushBuffer(DescriptorType descriptorType, uint16_t localIndex);
+        void UpdateDenoiser(const DenoiserData& denoiserData);
+        void SetActiveDenoisers(const Identifier* identifiers, uint32_t identifiersNum);
+        void UpdateCommonSettings(const CommonSettings& commonSettings, bool isNewFrame);
+        void ResetFramePlan();
+        void InitFrameSlots(size_t frameSlotsNum);
+        void SwapFrameSlot(FrameSlot& frameSlot);
+        bool AcquireFrameSlot();
+        void PublishDispatches(const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum);
+        bool ValidateViews(const ViewDesc* viewDescs, uint32_t viewDescsNum);
+        void AddViewDispatches(const Identifier* identifiers, uint32_t identifiersNum, bool& isCacheable);
+        void SkipSharedDispatches(size_t dispatchOffset);
+        void AddClearDispatches(size_t viewDispatchOffset, size_t viewDenoiserOffset);
+        bool IsClearNeeded(const FramePlanDenoiser& framePlanDenoiser, const ResourceDesc& resource) const;
+        void FinalizeDispatches(bool isFramePlanReused);
+        void ResolveResources();
+        void UpdateBindlessIndices();
+        size_t AddSharedConstants(const DenoiserData& denoiserData, void* data);
+        void GetFramePlanKey(const Identifier* identifiers, uint32_t identifiersNum);
+        void ReplayFramePlan();
+        void DeduplicateConstants();
+        void AddBarriers(uint32_t parity);
+        void AddDependencies(uint32_t parity);
+        void AddClearResource(const ClearResource& clearResource);
+        bool IsPermutationUsed(uint32_t features) const;
+        uint32_t GetRequestedFeatures(const DenoiserData& denoiserData, const CommonSettings& commonSettings) const;
+
+        inline uint32_t GetDenoiserIndex(Identifier identifier) const
+        {
+            uint32_t mask = (uint32_t)m_IdentifierSlots.size() - 1;
+            for (uint32_t i = (identifier * 2654435761u) & mask; ; i = (i + 1) & mask)
+            {
+                const IdentifierSlot& identifierSlot = m_IdentifierSlots[i];
+                if (identifierSlot.denoiserIndex == INVALID_INDEX || identifierSlot.identifier == identifier)
+                    return identifierSlot.denoiserIndex;
+            }
+        }
+
+        inline bool HasClearResource(const ResourceDesc& resource) const
+        {
+            uint32_t mask = (uint32_t)m_ClearResourceSlots.size() - 1;
+            for (uint32_t i = HashClearResource(resource) & mask; m_ClearResourceSlots[i] != INVALID_INDEX; i = (i + 1) & mask)
+            {
+                const ResourceDesc& temp = m_ClearResources[m_ClearResourceSlots[i]].resource;
+                if (temp.descriptorType == resource.descriptorType && temp.type == resource.type && temp.indexInPool == resource.indexInPool)
+                    return true;
+            }
+
+            return false;
+        }
+
+        inline bool IsDenoiserActive(size_t denoiserIndex) const
+        { return (m_ActiveDenoisers[denoiserIndex >> 6] & (1ull << (denoiserIndex & 63))) != 0; }
+
+        // User resources (per view), then permanent, transient and indirect arguments pools
+        inline size_t GetResourceStateIndex(const ResourceDesc& resource, uint32_t viewIndex) const
+        {
+            size_t userResourceNum = (size_t)ResourceType::MAX_NUM * m_ViewsNum;
+
+            if (resource.type == ResourceType::PERMANENT_POOL)
+                return userResourceNum + resource.indexInPool;
+            else if (resource.type == ResourceType::TRANSIENT_POOL)
+                return userResourceNum + m_PermanentPool.size() + resource.indexInPool;
+            else if (resource.type == ResourceType::INDIRECT_ARGUMENTS_POOL)
+                return userResourceNum + m_PermanentPool.size() + m_TransientPool.size() + resource.indexInPool;
+
+            return (size_t)ResourceType::MAX_NUM * viewIndex + (size_t)resource.type;
+        }
+
+        inline size_t GetResourceStateNum() const
+        { return (size_t)ResourceType::MAX_NUM * m_ViewsNum + m_PermanentPool.size() + m_TransientPool.size() + m_IndirectArgumentsPoolSize; }
 
     // Available in denoiser implementations
     private:
         void AddTextureToTransientPool(const TextureDesc& textureDesc);
-        void* PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex);
+        void* PushDispatch(const DenoiserData& denoiserData, uint32_t localIndex, uint16_t layersNum = 1);
+        uint8_t* PushConstantData(size_t constantDataSize);
+
+        // Use for constants, which change every frame regardless of settings (rotators, etc.)
+        inline void SetPerFrameConstant(float4& constant, const float4& source)
+        {
+            constant = source;
+            m_FramePlanPatches.push_back( {size_t((uint8_t*)&constant - m_ConstantData), &source} );
+        }
 
         inline void AddTextureToPermanentPool(const TextureDesc& textureDesc)
         { m_PermanentPool.push_back(textureDesc); }
 
+        // Previous-frame copy of a guide, written with the same data by all denoisers (shared if "enableGuideSharing" is set)
+        inline void AddGuideToPermanentPool(const TextureDesc& textureDesc, ResourceType guide)
+        {
+            m_PrevGuides.push_back( {(uint32_t)m_DenoiserData.size(), guide, (uint16_t)m_PermanentPool.size()} );
+            m_PermanentPool.push_back(textureDesc);
+        }
+
+        inline void AddBufferToIndirectArgumentsPool()
+        { m_IndirectArgumentsPoolSize++; }
+
+        // Walks the table: "addPass(instance, pass, permutation)" pushes the resources and adds a dispatch per variant
+        template <class Pass, const auto& passDescs, const auto& addPass>
+        void AddPasses()
+        {
+            static_assert(g_PassCheckers<Pass, passDescs, addPass>.IsDispatchPerVariant(), "A pass must add a dispatch per variant");
+            static_assert(GetMaxVariantNum(passDescs) <= g_VariantFeatures.size(), "Features of a variant are unknown (see \"g_VariantFeatures\")");
+
+            for (size_t pass = 0; pass < passDescs.size(); pass++)
+            {
+                m_PassFeatures = (uint32_t)passDescs[pass].feature;
+
+                for (uint32_t permutation = 0; permutation < passDescs[pass].permutationNum; permutation++)
+                    addPass(*this, (Pass)pass, permutation);
+            }
+
+            m_PassFeatures = 0;
+        }
+
+    // Available in "AddPass" lambdas (mirrored by "PassChecker")
+    public:
         inline void PushInput(uint16_t indexInPool, uint16_t indexToSwapWith = uint16_t(-1))
         { PushTexture(DescriptorType::TEXTURE, indexInPool, indexToSwapWith); }
 
         inline void PushOutput(uint16_t indexInPool, uint16_t indexToSwapWith = uint16_t(-1))
         { PushTexture(DescriptorType::STORAGE_TEXTURE, indexInPool, indexToSwapWith); }
 
+        // "Texture2DArray" views, all layers are accessed by a single dispatch
+        inline void PushArrayInput(uint16_t indexInPool)
+        { PushTexture(DescriptorType::TEXTURE, indexInPool, uint16_t(-1), true); }
+
+        inline void PushArrayOutput(uint16_t indexInPool)
+        { PushTexture(DescriptorType::STORAGE_TEXTURE, indexInPool, uint16_t(-1), true); }
+
+        // Indirect arguments: written as "RWStructuredBuffer<uint>" (after texture outputs), consumed by an indirect dispatch (must be pushed last)
+        inline void PushIndirectArgumentsOutput(uint16_t indexInPool)
+        { PushBuffer(DescriptorType::STORAGE_BUFFER, indexInPool); }
+
+        inline void PushIndirectArguments(uint16_t indexInPool)
+        { PushBuffer(DescriptorType::INDIRECT_ARGUMENTS, indexInPool); }
+
         inline void _PushPass(const char* name)
         {
             m_PassName = name;
             m_ResourceOffset = m_Resources.size();
+            m_PassDispatchOffset = m_Dispatches.size();
         }
 
+        void AddComputeDispatchDesc
+        (
+            NumThreads numThreads,
+            uint16_t downsampleFactor,
+            uint32_t constantBufferDataSize,
+            uint32_t maxRepeatNum,
+            const char* shaderFileName,
+            const ComputeShaderDesc& dxbc,
+            const ComputeShaderDesc& dxil,
+            const ComputeShaderDesc& spirv
+        );
+
     private:
         StdAllocator<uint8_t> m_StdAllocator;
         Vector<DenoiserData> m_DenoiserData;
         Vector<TextureDesc> m_PermanentPool;
         Vector<TextureDesc> m_TransientPool;
+        Vector<TransientKind> m_TransientPoolKinds;
+        Vector<uint32_t> m_TransientPoolWriters; // indices in "m_ActiveDispatches" of the last writers of shared textures
         Vector<ResourceDesc> m_Resources;
         Vector<ClearResource> m_ClearResources;
+        Vector<ResourceDesc> m_ClearBatchResources;
         Vector<PingPong> m_PingPongs;
+        Vector<PrevGuide> m_PrevGuides;
+        Vector<PrevGuideGroup> m_PrevGuideGroups;
+        Vector<PrevGuideResource> m_PrevGuideResources;
+        Vector<uint32_t> m_PrevGuideGroupViews;
         Vector<ResourceRangeDesc> m_ResourceRanges;
         Vector<PipelineDesc> m_Pipelines;
         Vector<InternalDispatchDesc> m_Dispatches;
         Vector<DispatchDesc> m_ActiveDispatches;
+        Vector<const ResourceDesc*> m_DispatchResources; // live "DispatchDesc::resources", resolved into "m_FrameResources" if frames are in flight
+        Vector<ResourceDesc> m_FrameResources;
         Vector<uint16_t> m_IndexRemap;
+        Vector<IdentifierSlot> m_IdentifierSlots;
+        Vector<uint32_t> m_PipelineSlots; // indices in "m_Pipelines"
+        Vector<uint32_t> m_ClearResourceSlots; // indices in "m_ClearResources"
+        Vector<uint64_t> m_ActiveDenoisers;
+        Vector<FramePlanDenoiser> m_FramePlanDenoisers;
+        Vector<FramePlanPatch> m_FramePlanPatches;
+        Vector<ConstantBlockSlot> m_ConstantBlockSlots;
+        Vector<BarrierDesc> m_Barriers;
+        Vector<uint32_t> m_BarrierOffsets;
+        Vector<DescriptorType> m_ResourceStates;
+        Vector<DispatchDependencyDesc> m_Dependencies;
+        Vector<ResourceHazard> m_ResourceHazards;
+        Vector<HazardReader> m_HazardReaders;
+        Vector<uint32_t> m_DependencyMarks;
+        Vector<uint32_t> m_DenoiserViews;
+        Vector<uint32_t> m_TransientPoolViews;
+        Vector<uint32_t> m_ViewDispatchOffsets;
+        Vector<DispatchDesc> m_ViewDispatches;
+        Vector<ViewProjection> m_ViewProjections;
+        Vector<FrameSlot> m_FrameSlots;
+        Vector<uint8_t> m_FramePlanKey; // of the current call
+        Vector<uint8_t> m_FramePlanKeyPrev; // of the last call
         Timer m_Timer;
         InstanceDesc m_Desc = {};
         CommonSettings m_CommonSettings = {};
@@ -335,8 +940,17 @@ namespace nrd
         uint8_t* m_ConstantDataUnaligned = nullptr;
         uint8_t* m_ConstantData = nullptr;
         size_t m_ConstantDataOffset = 0;
+        size_t m_ConstantDataSize = 0;
+        size_t m_SharedConstantsOffset = 0;
+        size_t m_SharedConstantsSize = 0;
         size_t m_ResourceOffset = 0;
+        size_t m_PassDispatchOffset = 0; // variants of a permutation follow each other
         size_t m_DispatchClearIndex[2] = {};
+        size_t m_DependencyOffsets[2] = {};
+        size_t m_DependencyNums[2] = {};
+        uint64_t m_FramePlanCallIndex = 0; // the last call, which used the frame plan
+        uint64_t m_FramePlanRunStart = 0; // the first call of consecutive calls with the same frame plan key
+        uint64_t m_CallIndex = 0;
         float m_OrthoMode = 0.0f;
         float m_CheckerboardResolveAccumSpeed = 0.0f;
         float m_JitterDelta = 0.0f;
@@ -344,8 +958,24 @@ namespace nrd
         float m_FrameRateScale = 0.0f;
         float m_ProjectY = 0.0f;
         uint32_t m_AccumulatedFrameNum = 0;
+        uint32_t m_FramePlanParity = 0;
+        uint32_t m_PrevGuideParity = 0; // index of the texture written by the last frame in "PrevGuideGroup"
+        uint32_t m_BarrierPlanMask = 0;
+        uint32_t m_DependencyPlanMask = 0;
+        uint32_t m_DisabledFeatures = 0;
+        uint32_t m_PassFeatures = 0; // of the pass being added by "AddPasses"
+        uint32_t m_FrameSlotIndex = 0; // the slot, which memory is held by the instance
+        uint32_t m_ViewIndex = 0;
+        uint32_t m_ViewsNum = 1;
+        uint32_t m_ResourceDescriptorHeapOffset = 0;
+        uint32_t m_SamplerDescriptorHeapOffset = 0;
         uint16_t m_TransientPoolOffset = 0;
         uint16_t m_PermanentPoolOffset = 0;
+        uint16_t m_IndirectArgumentsPoolOffset = 0;
+        uint16_t m_IndirectArgumentsPoolSize = 0;
         bool m_IsFirstUse = true;
+        bool m_IsFramePlanValid = false;
+        bool m_IsLeftHanded = true;
+        bool m_IsGuideSharingEnabled = false;
     };
 }
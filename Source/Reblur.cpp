@@ -15,6 +15,7 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "../Shaders/Include/REBLUR_Config.hlsli"
 #include "../Shaders/Resources/REBLUR_Blur.resources.hlsli"
 #include "../Shaders/Resources/REBLUR_ClassifyTiles.resources.hlsli"
+#include "../Shaders/Resources/REBLUR_CompactTiles.resources.hlsli"
 #include "../Shaders/Resources/REBLUR_Copy.resources.hlsli"
 #include "../Shaders/Resources/REBLUR_HistoryFix.resources.hlsli"
 #include "../Shaders/Resources/REBLUR_HitDistReconstruction.resources.hlsli"
@@ -67,17 +68,17 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #define REBLUR_NO_PERMUTATIONS                                      1
 
 #define REBLUR_ADD_VALIDATION_DISPATCH( data2, diff, spec ) \
-    PushPass("Validation"); \
+    instance.PushPass("Validation"); \
     { \
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) ); \
-        PushInput( AsUint(ResourceType::IN_VIEWZ) ); \
-        PushInput( AsUint(ResourceType::IN_MV) ); \
-        PushInput( AsUint(Transient::DATA1) ); \
-        PushInput( AsUint(data2) ); \
-        PushInput( AsUint(diff) ); \
-        PushInput( AsUint(spec) ); \
-        PushOutput( AsUint(ResourceType::OUT_VALIDATION) ); \
-        AddDispatch( REBLUR_Validation, REBLUR_Validation, IGNORE_RS ); \
+        instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) ); \
+        instance.PushInput( AsUint(ResourceType::IN_VIEWZ) ); \
+        instance.PushInput( AsUint(ResourceType::IN_MV) ); \
+        instance.PushInput( AsUint(Transient::DATA1) ); \
+        instance.PushInput( AsUint(data2) ); \
+        instance.PushInput( AsUint(diff) ); \
+        instance.PushInput( AsUint(spec) ); \
+        instance.PushOutput( AsUint(ResourceType::OUT_VALIDATION) ); \
+        instance.AddDispatch( REBLUR_Validation, REBLUR_Validation, IGNORE_RS ); \
     }
 
 struct ReblurProps
@@ -100,23 +101,72 @@ constexpr std::array<ReblurProps, 10> g_ReblurProps =
     {true, false},      // REBLUR_DIFFUSE_DIRECTIONAL_OCCLUSION
 }};
 
-void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData)
+// Passes in registration order
+enum class ReblurPass
 {
-    enum class Dispatch
-    {
-        CLASSIFY_TILES,
-        HITDIST_RECONSTRUCTION  = CLASSIFY_TILES + REBLUR_NO_PERMUTATIONS * 1, // CLASSIFY_TILES doesn't have perf mode
-        PREPASS                 = HITDIST_RECONSTRUCTION + REBLUR_HITDIST_RECONSTRUCTION_PERMUTATION_NUM * 2,
-        TEMPORAL_ACCUMULATION   = PREPASS + REBLUR_PREPASS_PERMUTATION_NUM * 2,
-        HISTORY_FIX             = TEMPORAL_ACCUMULATION + REBLUR_TEMPORAL_ACCUMULATION_PERMUTATION_NUM * 2,
-        BLUR                    = HISTORY_FIX + REBLUR_NO_PERMUTATIONS * 2,
-        POST_BLUR               = BLUR + REBLUR_NO_PERMUTATIONS * 2,
-        COPY                    = POST_BLUR + REBLUR_POST_BLUR_PERMUTATION_NUM * 2,
-        TEMPORAL_STABILIZATION  = COPY + REBLUR_NO_PERMUTATIONS * 1, // COPY doesn't have perf mode
-        SPLIT_SCREEN            = TEMPORAL_STABILIZATION + REBLUR_TEMPORAL_STABILIZATION_PERMUTATION_NUM * 2,
-        VALIDATION              = SPLIT_SCREEN + REBLUR_NO_PERMUTATIONS * 1, // SPLIT_SCREEN doesn't have perf mode
-    };
+    CLASSIFY_TILES,
+    COMPACT_TILES,
+    HITDIST_RECONSTRUCTION,
+    PREPASS,
+    TEMPORAL_ACCUMULATION,
+    HISTORY_FIX,
+    BLUR,
+    POST_BLUR,
+    COPY,
+    TEMPORAL_STABILIZATION,
+    SPLIT_SCREEN,
+    VALIDATION,
+
+    MAX_NUM
+};
+
+// Permutations x variants (2 - with perf mode), features needed by the pass
+constexpr std::array<nrd::PassDesc, (size_t)ReblurPass::MAX_NUM> g_ReblurPasses =
+{{
+    {REBLUR_NO_PERMUTATIONS, 1},                                                                                // CLASSIFY_TILES
+    {REBLUR_NO_PERMUTATIONS, 1},                                                                                // COMPACT_TILES
+    {REBLUR_HITDIST_RECONSTRUCTION_PERMUTATION_NUM, 2, nrd::DenoiserFeatureBits::HIT_DISTANCE_RECONSTRUCTION},  // HITDIST_RECONSTRUCTION
+    {REBLUR_PREPASS_PERMUTATION_NUM, 2},                                                                        // PREPASS
+    {REBLUR_TEMPORAL_ACCUMULATION_PERMUTATION_NUM, 2},                                                          // TEMPORAL_ACCUMULATION
+    {REBLUR_NO_PERMUTATIONS, 2},                                                                                // HISTORY_FIX
+    {REBLUR_NO_PERMUTATIONS, 2},                                                                                // BLUR
+    {REBLUR_POST_BLUR_PERMUTATION_NUM, 2},                                                                      // POST_BLUR
+    {REBLUR_NO_PERMUTATIONS, 1},                                                                                // COPY
+    {REBLUR_TEMPORAL_STABILIZATION_PERMUTATION_NUM, 2},                                                         // TEMPORAL_STABILIZATION
+    {REBLUR_NO_PERMUTATIONS, 1, nrd::DenoiserFeatureBits::SPLIT_SCREEN},                                        // SPLIT_SCREEN
+    {REBLUR_NO_PERMUTATIONS, 1, nrd::DenoiserFeatureBits::VALIDATION},                                          // VALIDATION
+}};
+
+enum class ReblurOcclusionPass
+{
+    CLASSIFY_TILES,
+    COMPACT_TILES,
+    HITDIST_RECONSTRUCTION,
+    TEMPORAL_ACCUMULATION,
+    HISTORY_FIX,
+    BLUR,
+    POST_BLUR,
+    SPLIT_SCREEN,
+    VALIDATION,
+
+    MAX_NUM
+};
+
+constexpr std::array<nrd::PassDesc, (size_t)ReblurOcclusionPass::MAX_NUM> g_ReblurOcclusionPasses =
+{{
+    {REBLUR_NO_PERMUTATIONS, 1},                                                                                            // CLASSIFY_TILES
+    {REBLUR_NO_PERMUTATIONS, 1},                                                                                            // COMPACT_TILES
+    {REBLUR_OCCLUSION_HITDIST_RECONSTRUCTION_PERMUTATION_NUM, 2, nrd::DenoiserFeatureBits::HIT_DISTANCE_RECONSTRUCTION},    // HITDIST_RECONSTRUCTION
+    {REBLUR_OCCLUSION_TEMPORAL_ACCUMULATION_PERMUTATION_NUM, 2},                                                            // TEMPORAL_ACCUMULATION
+    {REBLUR_NO_PERMUTATIONS, 2},                                                                                            // HISTORY_FIX
+    {REBLUR_NO_PERMUTATIONS, 2},                                                                                            // BLUR
+    {REBLUR_NO_PERMUTATIONS, 2},                                                                                            // POST_BLUR
+    {REBLUR_NO_PERMUTATIONS, 1, nrd::DenoiserFeatureBits::SPLIT_SCREEN},                                                    // SPLIT_SCREEN
+    {REBLUR_NO_PERMUTATIONS, 1, nrd::DenoiserFeatureBits::VALIDATION},                                                      // VALIDATION
+}};
 
+void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData)
+{
     NRD_DECLARE_DIMS;
 
     const ReblurSettings& settings = denoiserData.settings.reblur;
@@ -127,191 +177,171 @@ void nrd::InstanceImpl::Update_Reblur(const DenoiserData& denoiserData)
     bool skipPrePass = (settings.diffusePrepassBlurRadius == 0.0f || !props.hasDiffuse) &&
         (settings.specularPrepassBlurRadius == 0.0f || !props.hasSpecular) &&
         settings.checkerboardMode == CheckerboardMode::OFF;
+    uint32_t perfVariant = settings.enablePerformanceMode ? 1 : 0;
 
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurPasses, ReblurPass::SPLIT_SCREEN));
 
         return;
     }
 
     { // CLASSIFY_TILES
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-        AddSharedConstants_Reblur(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurPasses, ReblurPass::CLASSIFY_TILES));
+    }
+
+    { // COMPACT_TILES
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurPasses, ReblurPass::COMPACT_TILES));
     }
 
     // HITDIST_RECONSTRUCTION
     if (enableHitDistanceReconstruction)
     {
-        uint32_t passIndex = AsUint(Dispatch::HITDIST_RECONSTRUCTION) + (settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_5X5 ? 4 : 0) + (!skipPrePass ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t permutation = (settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_5X5 ? 2 : 0) + (!skipPrePass ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::HITDIST_RECONSTRUCTION, permutation, perfVariant);
+        PushDispatch(denoiserData, passIndex);
     }
 
     // PREPASS
     if (!skipPrePass)
     {
-        uint32_t passIndex = AsUint(Dispatch::PREPASS) + (enableHitDistanceReconstruction ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::PREPASS, enableHitDistanceReconstruction ? 1 : 0, perfVariant);
         REBLUR_PrePassConstants* consts = (REBLUR_PrePassConstants*)PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
-        consts->gRotator = m_Rotator_PrePass; // TODO: push constant
+        SetPerFrameConstant(consts->gRotator, m_Rotator_PrePass);
     }
 
     { // TEMPORAL_ACCUMULATION
-        uint32_t passIndex = AsUint(Dispatch::TEMPORAL_ACCUMULATION) + (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 16 : 0) +
-            (!skipTemporalStabilization ? 8 : 0) + (m_CommonSettings.isHistoryConfidenceAvailable ? 4 : 0) +
-            ((!skipPrePass || enableHitDistanceReconstruction) ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t permutation = (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 8 : 0) + (!skipTemporalStabilization ? 4 : 0) +
+            (m_CommonSettings.isHistoryConfidenceAvailable ? 2 : 0) + ((!skipPrePass || enableHitDistanceReconstruction) ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::TEMPORAL_ACCUMULATION, permutation, perfVariant);
+        PushDispatch(denoiserData, passIndex);
     }
 
     { // HISTORY_FIX
-        uint32_t passIndex = AsUint(Dispatch::HISTORY_FIX) + (settings.enablePerformanceMode ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::HISTORY_FIX, 0, perfVariant);
+        PushDispatch(denoiserData, passIndex);
     }
 
     { // BLUR
-        uint32_t passIndex = AsUint(Dispatch::BLUR) + (settings.enablePerformanceMode ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::BLUR, 0, perfVariant);
         REBLUR_BlurConstants* consts = (REBLUR_BlurConstants*)PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
-        consts->gRotator = m_Rotator_Blur; // TODO: push constant
+        SetPerFrameConstant(consts->gRotator, m_Rotator_Blur);
     }
 
     { // POST_BLUR
-        uint32_t passIndex = AsUint(Dispatch::POST_BLUR) + (skipTemporalStabilization ? 0 : 2) + (settings.enablePerformanceMode ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::POST_BLUR, skipTemporalStabilization ? 0 : 1, perfVariant);
         REBLUR_PostBlurConstants* consts = (REBLUR_PostBlurConstants*)PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
-        consts->gRotator = m_Rotator_PostBlur; // TODO: push constant
+        SetPerFrameConstant(consts->gRotator, m_Rotator_PostBlur);
     }
 
     // COPY
     if (!skipTemporalStabilization)
     {
-        uint32_t passIndex = AsUint(Dispatch::COPY);
-        void* consts = (REBLUR_CopyConstants*)PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::COPY);
+        PushDispatch(denoiserData, passIndex);
     }
 
     // TEMPORAL_STABILIZATION
     if (!skipTemporalStabilization)
     {
-        uint32_t passIndex = AsUint(Dispatch::TEMPORAL_STABILIZATION) + (m_CommonSettings.isBaseColorMetalnessAvailable ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurPasses, ReblurPass::TEMPORAL_STABILIZATION, m_CommonSettings.isBaseColorMetalnessAvailable ? 1 : 0, perfVariant);
+        PushDispatch(denoiserData, passIndex);
     }
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurPasses, ReblurPass::SPLIT_SCREEN));
     }
 
     // VALIDATION
     if (m_CommonSettings.enableValidation)
     {
-        REBLUR_ValidationConstants* consts = (REBLUR_ValidationConstants*)PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
-        AddSharedConstants_Reblur(settings, consts);
-        consts->gHasDiffuse = props.hasDiffuse ? 1 : 0; // TODO: push constant
-        consts->gHasSpecular = props.hasSpecular ? 1 : 0; // TODO: push constant
+        REBLUR_ValidationConstants* consts = (REBLUR_ValidationConstants*)PushDispatch(denoiserData, GetDispatchIndex(g_ReblurPasses, ReblurPass::VALIDATION));
+        consts->gHasDiffuse = props.hasDiffuse ? 1 : 0;
+        consts->gHasSpecular = props.hasSpecular ? 1 : 0;
     }
 }
 
 void nrd::InstanceImpl::Update_ReblurOcclusion(const DenoiserData& denoiserData)
 {
-    enum class Dispatch
-    {
-        CLASSIFY_TILES,
-        HITDIST_RECONSTRUCTION  = CLASSIFY_TILES + REBLUR_NO_PERMUTATIONS * 1, // CLASSIFY_TILES doesn't have perf mode
-        TEMPORAL_ACCUMULATION   = HITDIST_RECONSTRUCTION + REBLUR_OCCLUSION_HITDIST_RECONSTRUCTION_PERMUTATION_NUM * 2,
-        HISTORY_FIX             = TEMPORAL_ACCUMULATION + REBLUR_OCCLUSION_TEMPORAL_ACCUMULATION_PERMUTATION_NUM * 2,
-        BLUR                    = HISTORY_FIX + REBLUR_NO_PERMUTATIONS * 2,
-        POST_BLUR               = BLUR + REBLUR_NO_PERMUTATIONS * 2,
-        SPLIT_SCREEN            = POST_BLUR + REBLUR_NO_PERMUTATIONS * 2,
-        VALIDATION              = SPLIT_SCREEN + REBLUR_NO_PERMUTATIONS * 1, // SPLIT_SCREEN doesn't have perf mode
-    };
-
     NRD_DECLARE_DIMS;
 
     const ReblurSettings& settings = denoiserData.settings.reblur;
     const ReblurProps& props = g_ReblurProps[ size_t(denoiserData.desc.denoiser) - size_t(Denoiser::REBLUR_DIFFUSE) ];
 
     bool enableHitDistanceReconstruction = settings.hitDistanceReconstructionMode != HitDistanceReconstructionMode::OFF && settings.checkerboardMode == CheckerboardMode::OFF;
+    uint32_t perfVariant = settings.enablePerformanceMode ? 1 : 0;
 
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::SPLIT_SCREEN));
 
         return;
     }
 
     { // CLASSIFY_TILES
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-        AddSharedConstants_Reblur(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::CLASSIFY_TILES));
+    }
+
+    { // COMPACT_TILES
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::COMPACT_TILES));
     }
 
     // HITDIST_RECONSTRUCTION
     if (enableHitDistanceReconstruction)
     {
-        uint32_t passIndex = AsUint(Dispatch::HITDIST_RECONSTRUCTION) + (settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_5X5 ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t permutation = settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_5X5 ? 1 : 0;
+        uint32_t passIndex = GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::HITDIST_RECONSTRUCTION, permutation, perfVariant);
+        PushDispatch(denoiserData, passIndex);
     }
 
     { // TEMPORAL_ACCUMULATION
-        uint32_t passIndex = AsUint(Dispatch::TEMPORAL_ACCUMULATION) + (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 8 : 0) +
-            (m_CommonSettings.isHistoryConfidenceAvailable ? 4 : 0) + (enableHitDistanceReconstruction ? 2 : 0) + (settings.enablePerformanceMode ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t permutation = (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 4 : 0) + (m_CommonSettings.isHistoryConfidenceAvailable ? 2 : 0) + (enableHitDistanceReconstruction ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::TEMPORAL_ACCUMULATION, permutation, perfVariant);
+        PushDispatch(denoiserData, passIndex);
     }
 
     { // HISTORY_FIX
-        uint32_t passIndex = AsUint(Dispatch::HISTORY_FIX) + (!settings.enableAntiFirefly ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::HISTORY_FIX, 0, perfVariant);
+        PushDispatch(denoiserData, passIndex);
     }
 
     { // BLUR
-        uint32_t passIndex = AsUint(Dispatch::BLUR) + (settings.enablePerformanceMode ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::BLUR, 0, perfVariant);
         REBLUR_BlurConstants* consts = (REBLUR_BlurConstants* )PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
-        consts->gRotator = m_Rotator_Blur; // TODO: push constant
+        SetPerFrameConstant(consts->gRotator, m_Rotator_Blur);
     }
 
     { // POST_BLUR
-        uint32_t passIndex = AsUint(Dispatch::POST_BLUR) + (settings.enablePerformanceMode ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::POST_BLUR, 0, perfVariant);
         REBLUR_PostBlurConstants* consts = (REBLUR_PostBlurConstants*)PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Reblur(settings, consts);
-        consts->gRotator = m_Rotator_PostBlur; // TODO: push constant
+        SetPerFrameConstant(consts->gRotator, m_Rotator_PostBlur);
     }
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Reblur(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::SPLIT_SCREEN));
     }
 
     // VALIDATION
     if (m_CommonSettings.enableValidation)
     {
-        REBLUR_ValidationConstants* consts = (REBLUR_ValidationConstants*)PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
-        AddSharedConstants_Reblur(settings, consts);
-        consts->gHasDiffuse = props.hasDiffuse ? 1 : 0; // TODO: push constant
-        consts->gHasSpecular = props.hasSpecular ? 1 : 0; // TODO: push constant
+        REBLUR_ValidationConstants* consts = (REBLUR_ValidationConstants*)PushDispatch(denoiserData, GetDispatchIndex(g_ReblurOcclusionPasses, ReblurOcclusionPass::VALIDATION));
+        consts->gHasDiffuse = props.hasDiffuse ? 1 : 0;
+        consts->gHasSpecular = props.hasSpecular ? 1 : 0;
     }
 }
 
-void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings, void* data)
+size_t nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings, void* data)
 {
     struct SharedConstants
     {
         REBLUR_SHARED_CONSTANTS
+        uint8_t end; // trailing padding can be occupied by non-shared constants
     };
 
     NRD_DECLARE_DIMS;
@@ -372,6 +402,7 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings
     consts->gDisocclusionThreshold                              = m_CommonSettings.disocclusionThreshold + disocclusionThresholdBonus;
     consts->gDisocclusionThresholdAlternate                     = m_CommonSettings.disocclusionThresholdAlternate + disocclusionThresholdBonus;
     consts->gStrandMaterialID                                   = m_CommonSettings.strandMaterialID;
+    consts->gStrandThickness                                    = m_CommonSettings.strandThickness;
     consts->gStabilizationStrength                              = stabilizationStrength;
     consts->gHitDistStabilizationStrength                       = min(stabilizationStrength, settings.hitDistanceStabilizationStrength);
     consts->gDebug                                              = m_CommonSettings.debug;
@@ -406,21 +437,26 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings
     consts->gSpecMaterialMask                                   = settings.enableMaterialTestForSpecular ? 1 : 0;
     consts->gIsRectChanged                                      = isRectChanged ? 1 : 0;
     consts->gResetHistory                                       = isHistoryReset ? 1 : 0;
+
+    return offsetof(SharedConstants, end);
 }
 
 // REBLUR_SHARED
 #ifdef NRD_EMBEDS_DXBC_SHADERS
     #include "REBLUR_ClassifyTiles.cs.dxbc.h"
+    #include "REBLUR_CompactTiles.cs.dxbc.h"
     #include "REBLUR_Validation.cs.dxbc.h"
 #endif
 
 #ifdef NRD_EMBEDS_DXIL_SHADERS
     #include "REBLUR_ClassifyTiles.cs.dxil.h"
+    #include "REBLUR_CompactTiles.cs.dxil.h"
     #include "REBLUR_Validation.cs.dxil.h"
 #endif
 
 #ifdef NRD_EMBEDS_SPIRV_SHADERS
     #include "REBLUR_ClassifyTiles.cs.spirv.h"
+    #include "REBLUR_CompactTiles.cs.spirv.h"
     #include "REBLUR_Validation.cs.spirv.h"
 #endif
 
@@ -1057,3 +1093,17 @@ void nrd::InstanceImpl::AddSharedConstants_Reblur(const ReblurSettings& settings
 #endif
 
 #include "Denoisers/Reblur_DiffuseDirectionalOcclusion.hpp"
+
+// Pipelines are shared by all denoisers of the family
+static_assert(nrd::PassChecker::IsLayoutShared({
+    &nrd::g_PassCheckers<ReblurPass, g_ReblurPasses, nrd::ReblurDiffuse::AddPass>,
+    &nrd::g_PassCheckers<ReblurOcclusionPass, g_ReblurOcclusionPasses, nrd::ReblurDiffuseOcclusion::AddPass>,
+    &nrd::g_PassCheckers<ReblurPass, g_ReblurPasses, nrd::ReblurDiffuseSh::AddPass>,
+    &nrd::g_PassCheckers<ReblurPass, g_ReblurPasses, nrd::ReblurSpecular::AddPass>,
+    &nrd::g_PassCheckers<ReblurOcclusionPass, g_ReblurOcclusionPasses, nrd::ReblurSpecularOcclusion::AddPass>,
+    &nrd::g_PassCheckers<ReblurPass, g_ReblurPasses, nrd::ReblurSpecularSh::AddPass>,
+    &nrd::g_PassCheckers<ReblurPass, g_ReblurPasses, nrd::ReblurDiffuseSpecular::AddPass>,
+    &nrd::g_PassCheckers<ReblurOcclusionPass, g_ReblurOcclusionPasses, nrd::ReblurDiffuseSpecularOcclusion::AddPass>,
+    &nrd::g_PassCheckers<ReblurPass, g_ReblurPasses, nrd::ReblurDiffuseSpecularSh::AddPass>,
+    &nrd::g_PassCheckers<ReblurPass, g_ReblurPasses, nrd::ReblurDiffuseDirectionalOcclusion::AddPass>
+}), "A shader must be bound with the same layout in all passes using it");
@@ -10,6 +10,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "InstanceImpl.h"
 
+#include <array>
+
 #include "../Shaders/Include/RELAX_Config.hlsli"
 #include "../Shaders/Resources/RELAX_AntiFirefly.resources.hlsli"
 #include "../Shaders/Resources/RELAX_Atrous.resources.hlsli"
@@ -38,14 +40,14 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 constexpr uint32_t RELAX_MAX_ATROUS_PASS_NUM = 8;
 
 #define RELAX_ADD_VALIDATION_DISPATCH \
-    PushPass("Validation"); \
+    instance.PushPass("Validation"); \
     { \
-        PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) ); \
-        PushInput( AsUint(ResourceType::IN_VIEWZ) ); \
-        PushInput( AsUint(ResourceType::IN_MV) ); \
-        PushInput( AsUint(Transient::HISTORY_LENGTH) ); \
-        PushOutput( AsUint(ResourceType::OUT_VALIDATION) ); \
-        AddDispatch( RELAX_Validation, RELAX_Validation, IGNORE_RS ); \
+        instance.PushInput( AsUint(ResourceType::IN_NORMAL_ROUGHNESS) ); \
+        instance.PushInput( AsUint(ResourceType::IN_VIEWZ) ); \
+        instance.PushInput( AsUint(ResourceType::IN_MV) ); \
+        instance.PushInput( AsUint(Transient::HISTORY_LENGTH) ); \
+        instance.PushOutput( AsUint(ResourceType::OUT_VALIDATION) ); \
+        instance.AddDispatch( RELAX_Validation, RELAX_Validation, IGNORE_RS ); \
     }
 
 inline float3 RELAX_GetFrustumForward(const float4x4& viewToWorld, const float4& frustum)
@@ -57,11 +59,12 @@ inline float3 RELAX_GetFrustumForward(const float4x4& viewToWorld, const float4&
     return frustumForwardWorld;
 }
 
-void nrd::InstanceImpl::AddSharedConstants_Relax(const RelaxSettings& settings, void* data)
+size_t nrd::InstanceImpl::AddSharedConstants_Relax(const RelaxSettings& settings, void* data)
 {
     struct SharedConstants
     {
         RELAX_SHARED_CONSTANTS
+        uint8_t end; // trailing padding can be occupied by non-shared constants
     };
 
     NRD_DECLARE_DIMS;
@@ -127,6 +130,7 @@ void nrd::InstanceImpl::AddSharedConstants_Relax(const RelaxSettings& settings,
     consts->gDisocclusionThreshold                              = m_CommonSettings.disocclusionThreshold + disocclusionThresholdBonus;
     consts->gDisocclusionThresholdAlternate                     = m_CommonSettings.disocclusionThresholdAlternate + disocclusionThresholdBonus;
     consts->gStrandMaterialID                                   = m_CommonSettings.strandMaterialID;
+    consts->gStrandThickness                                    = m_CommonSettings.strandThickness;
     consts->gRoughnessFraction                                  = settings.roughnessFraction;
     consts->gSpecVarianceBoost                                  = settings.specularVarianceBoost;
     consts->gSplitScreen                                        = m_CommonSettings.splitScreen;
@@ -171,25 +175,46 @@ void nrd::InstanceImpl::AddSharedConstants_Relax(const RelaxSettings& settings,
     consts->gDiffMaterialMask                                   = settings.enableMaterialTestForDiffuse ? 1 : 0;
     consts->gSpecMaterialMask                                   = settings.enableMaterialTestForSpecular ? 1 : 0;
     consts->gResetHistory                                       = m_CommonSettings.accumulationMode != AccumulationMode::CONTINUE ? 1 : 0;
+
+    return offsetof(SharedConstants, end);
 }
 
-void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData)
+// Passes in registration order
+enum class RelaxPass
 {
-    enum class Dispatch
-    {
-        CLASSIFY_TILES,
-        HITDIST_RECONSTRUCTION  = CLASSIFY_TILES + RELAX_NO_PERMUTATIONS,
-        PREPASS                 = HITDIST_RECONSTRUCTION + RELAX_HITDIST_RECONSTRUCTION_PERMUTATION_NUM,
-        TEMPORAL_ACCUMULATION   = PREPASS + RELAX_PREPASS_PERMUTATION_NUM,
-        HISTORY_FIX             = TEMPORAL_ACCUMULATION + RELAX_TEMPORAL_ACCUMULATION_PERMUTATION_NUM,
-        HISTORY_CLAMPING        = HISTORY_FIX + RELAX_NO_PERMUTATIONS,
-        COPY                    = HISTORY_CLAMPING + RELAX_NO_PERMUTATIONS,
-        ANTI_FIREFLY            = COPY + RELAX_NO_PERMUTATIONS,
-        ATROUS                  = ANTI_FIREFLY + RELAX_NO_PERMUTATIONS,
-        SPLIT_SCREEN            = ATROUS + RELAX_ATROUS_PERMUTATION_NUM * RELAX_ATROUS_BINDING_VARIANT_NUM,
-        VALIDATION              = SPLIT_SCREEN + RELAX_NO_PERMUTATIONS,
-    };
+    CLASSIFY_TILES,
+    HITDIST_RECONSTRUCTION,
+    PREPASS,
+    TEMPORAL_ACCUMULATION,
+    HISTORY_FIX,
+    HISTORY_CLAMPING,
+    COPY,
+    ANTI_FIREFLY,
+    ATROUS,
+    SPLIT_SCREEN,
+    VALIDATION,
+
+    MAX_NUM
+};
+
+// Permutations x variants, features needed by the pass
+constexpr std::array<nrd::PassDesc, (size_t)RelaxPass::MAX_NUM> g_RelaxPasses =
+{{
+    {RELAX_NO_PERMUTATIONS, 1},                                                                                 // CLASSIFY_TILES
+    {RELAX_HITDIST_RECONSTRUCTION_PERMUTATION_NUM, 1, nrd::DenoiserFeatureBits::HIT_DISTANCE_RECONSTRUCTION},   // HITDIST_RECONSTRUCTION
+    {RELAX_PREPASS_PERMUTATION_NUM, 1},                                                                         // PREPASS
+    {RELAX_TEMPORAL_ACCUMULATION_PERMUTATION_NUM, 1},                                                           // TEMPORAL_ACCUMULATION
+    {RELAX_NO_PERMUTATIONS, 1},                                                                                 // HISTORY_FIX
+    {RELAX_NO_PERMUTATIONS, 1},                                                                                 // HISTORY_CLAMPING
+    {RELAX_NO_PERMUTATIONS, 1},                                                                                 // COPY
+    {RELAX_NO_PERMUTATIONS, 1},                                                                                 // ANTI_FIREFLY
+    {RELAX_ATROUS_PERMUTATION_NUM * RELAX_ATROUS_BINDING_VARIANT_NUM, 1},                                       // ATROUS
+    {RELAX_NO_PERMUTATIONS, 1, nrd::DenoiserFeatureBits::SPLIT_SCREEN},                                         // SPLIT_SCREEN
+    {RELAX_NO_PERMUTATIONS, 1, nrd::DenoiserFeatureBits::VALIDATION},                                           // VALIDATION
+}};
 
+void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData)
+{
     NRD_DECLARE_DIMS;
 
     const RelaxSettings& settings = denoiserData.settings.relax;
@@ -199,89 +224,79 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData)
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Relax(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::SPLIT_SCREEN));
 
         return;
     }
 
     { // CLASSIFY_TILES
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-        AddSharedConstants_Relax(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::CLASSIFY_TILES));
     }
 
     // HITDIST_RECONSTRUCTION
     if (enableHitDistanceReconstruction)
     {
         bool is5x5 = settings.hitDistanceReconstructionMode == HitDistanceReconstructionMode::AREA_5X5;
-        uint32_t passIndex = AsUint(Dispatch::HITDIST_RECONSTRUCTION) + (is5x5 ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Relax(settings, consts);
+        uint32_t passIndex = GetDispatchIndex(g_RelaxPasses, RelaxPass::HITDIST_RECONSTRUCTION, is5x5 ? 1 : 0);
+        PushDispatch(denoiserData, passIndex);
     }
 
     { // PREPASS
-        uint32_t passIndex = AsUint(Dispatch::PREPASS) + (enableHitDistanceReconstruction ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_RelaxPasses, RelaxPass::PREPASS, enableHitDistanceReconstruction ? 1 : 0);
         RELAX_PrePassConstants* consts = (RELAX_PrePassConstants*)PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Relax(settings, consts);
-        consts->gRotator = m_Rotator_PrePass; // TODO: push constant
+        SetPerFrameConstant(consts->gRotator, m_Rotator_PrePass);
     }
 
     { // TEMPORAL_ACCUMULATION
-        uint32_t passIndex = AsUint(Dispatch::TEMPORAL_ACCUMULATION) + (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 2 : 0) + (m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0);
-        void* consts = PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Relax(settings, consts);
+        uint32_t permutation = (m_CommonSettings.isDisocclusionThresholdMixAvailable ? 2 : 0) + (m_CommonSettings.isHistoryConfidenceAvailable ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_RelaxPasses, RelaxPass::TEMPORAL_ACCUMULATION, permutation);
+        PushDispatch(denoiserData, passIndex);
     }
 
     { // HISTORY_FIX
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_FIX));
-        AddSharedConstants_Relax(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::HISTORY_FIX));
     }
 
     { // HISTORY_CLAMPING
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::HISTORY_CLAMPING));
-        AddSharedConstants_Relax(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::HISTORY_CLAMPING));
     }
 
     if (settings.enableAntiFirefly)
     {
         { // COPY
-            void* consts = PushDispatch(denoiserData, AsUint(Dispatch::COPY));
-            AddSharedConstants_Relax(settings, consts);
+            PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::COPY));
         }
 
         { // ANTI_FIREFLY
-            void* consts = PushDispatch(denoiserData, AsUint(Dispatch::ANTI_FIREFLY));
-            AddSharedConstants_Relax(settings, consts);
+            PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::ANTI_FIREFLY));
         }
     }
 
     // A-TROUS
     for (uint32_t i = 0; i < iterationNum; i++)
     {
-        uint32_t passIndex = AsUint(Dispatch::ATROUS) + (m_CommonSettings.isHistoryConfidenceAvailable ? RELAX_ATROUS_BINDING_VARIANT_NUM : 0);
+        uint32_t permutation = m_CommonSettings.isHistoryConfidenceAvailable ? RELAX_ATROUS_BINDING_VARIANT_NUM : 0;
         if (i != 0)
-            passIndex += 2 - (i & 0x1);
+            permutation += 2 - (i & 0x1);
         if (i == iterationNum - 1)
-            passIndex += 2;
+            permutation += 2;
 
-        RELAX_AtrousConstants* consts = (RELAX_AtrousConstants*)PushDispatch(denoiserData, AsUint(passIndex)); // TODO: same as "RELAX_AtrousSmemConstants"
-        AddSharedConstants_Relax(settings, consts);
-        consts->gStepSize = 1 << i; // TODO: push constants
-        consts->gIsLastPass = i == iterationNum - 1 ? 1 : 0; // TODO: push constants
+        uint32_t passIndex = GetDispatchIndex(g_RelaxPasses, RelaxPass::ATROUS, permutation);
+        RELAX_AtrousConstants* consts = (RELAX_AtrousConstants*)PushDispatch(denoiserData, passIndex); // TODO: same as "RELAX_AtrousSmemConstants"
+        consts->gStepSize = 1 << i;
+        consts->gIsLastPass = i == iterationNum - 1 ? 1 : 0;
     }
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Relax(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::SPLIT_SCREEN));
     }
 
     // VALIDATION
     if (m_CommonSettings.enableValidation)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::VALIDATION));
-        AddSharedConstants_Relax(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_RelaxPasses, RelaxPass::VALIDATION));
     }
 }
 
@@ -557,3 +572,13 @@ void nrd::InstanceImpl::Update_Relax(const DenoiserData& denoiserData)
 #endif
 
 #include "Denoisers/Relax_DiffuseSpecularSh.hpp"
+
+// Pipelines are shared by all denoisers of the family
+static_assert(nrd::PassChecker::IsLayoutShared({
+    &nrd::g_PassCheckers<RelaxPass, g_RelaxPasses, nrd::RelaxDiffuse::AddPass>,
+    &nrd::g_PassCheckers<RelaxPass, g_RelaxPasses, nrd::RelaxDiffuseSh::AddPass>,
+    &nrd::g_PassCheckers<RelaxPass, g_RelaxPasses, nrd::RelaxSpecular::AddPass>,
+    &nrd::g_PassCheckers<RelaxPass, g_RelaxPasses, nrd::RelaxSpecularSh::AddPass>,
+    &nrd::g_PassCheckers<RelaxPass, g_RelaxPasses, nrd::RelaxDiffuseSpecular::AddPass>,
+    &nrd::g_PassCheckers<RelaxPass, g_RelaxPasses, nrd::RelaxDiffuseSpecularSh::AddPass>
+}), "A shader must be bound with the same layout in all passes using it");
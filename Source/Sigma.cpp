@@ -10,6 +10,8 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 
 #include "InstanceImpl.h"
 
+#include <array>
+
 #include "../Shaders/Include/SIGMA_Config.hlsli"
 #include "../Shaders/Resources/SIGMA_ClassifyTiles.resources.hlsli"
 #include "../Shaders/Resources/SIGMA_SmoothTiles.resources.hlsli"
@@ -17,76 +19,152 @@ license agreement from NVIDIA CORPORATION is strictly prohibited.
 #include "../Shaders/Resources/SIGMA_TemporalStabilization.resources.hlsli"
 #include "../Shaders/Resources/SIGMA_SplitScreen.resources.hlsli"
 
+// SIGMA_SHADOW_ARRAY constants ("SIGMA_SHARED_CONSTANTS" get per layer data)
+namespace SigmaArray
+{
+    #undef SIGMA_LAYER_CONSTANTS
+    #define SIGMA_LAYER_CONSTANTS SIGMA_ARRAY_CONSTANTS
+
+    #include "../Shaders/Resources/SIGMA_ClassifyTiles.resources.hlsli"
+    #include "../Shaders/Resources/SIGMA_SmoothTiles.resources.hlsli"
+    #include "../Shaders/Resources/SIGMA_Blur.resources.hlsli"
+    #include "../Shaders/Resources/SIGMA_TemporalStabilization.resources.hlsli"
+    #include "../Shaders/Resources/SIGMA_SplitScreen.resources.hlsli"
+
+    #undef SIGMA_LAYER_CONSTANTS
+    #define SIGMA_LAYER_CONSTANTS
+}
+
+static_assert(SIGMA_MAX_LAYERS == nrd::SIGMA_MAX_LAYERS_NUM, "\"SIGMA_MAX_LAYERS\" must match \"nrd::SIGMA_MAX_LAYERS_NUM\"");
+
+#define AddArrayDispatch(shaderName, passName, downsampleFactor) \
+    AddComputeDispatchDesc(NumThreads(passName ## GroupX, passName ## GroupY), \
+        downsampleFactor, sizeof(SigmaArray::passName ## Constants), 1, #shaderName ".cs", \
+        GET_DXBC_SHADER_DESC(shaderName), GET_DXIL_SHADER_DESC(shaderName), GET_SPIRV_SHADER_DESC(shaderName))
+
 // Permutations
 #define SIGMA_POST_BLUR_PERMUTATION_NUM     2
 #define SIGMA_NO_PERMUTATIONS               1
 
-void nrd::InstanceImpl::Update_SigmaShadow(const DenoiserData& denoiserData)
+// Passes in registration order
+enum class SigmaPass
 {
-    enum class Dispatch
-    {
-        CLASSIFY_TILES,
-        SMOOTH_TILES            = CLASSIFY_TILES + SIGMA_NO_PERMUTATIONS,
-        BLUR                    = SMOOTH_TILES + SIGMA_NO_PERMUTATIONS,
-        POST_BLUR               = BLUR + SIGMA_NO_PERMUTATIONS,
-        TEMPORAL_STABILIZATION  = POST_BLUR + SIGMA_POST_BLUR_PERMUTATION_NUM,
-        SPLIT_SCREEN            = TEMPORAL_STABILIZATION + SIGMA_NO_PERMUTATIONS,
-    };
+    CLASSIFY_TILES,
+    SMOOTH_TILES,
+    BLUR,
+    POST_BLUR,
+    TEMPORAL_STABILIZATION,
+    SPLIT_SCREEN,
+
+    MAX_NUM
+};
+
+// Permutations x variants, features needed by the pass
+constexpr std::array<nrd::PassDesc, (size_t)SigmaPass::MAX_NUM> g_SigmaPasses =
+{{
+    {SIGMA_NO_PERMUTATIONS, 1},                                         // CLASSIFY_TILES
+    {SIGMA_NO_PERMUTATIONS, 1},                                         // SMOOTH_TILES
+    {SIGMA_NO_PERMUTATIONS, 1},                                         // BLUR
+    {SIGMA_POST_BLUR_PERMUTATION_NUM, 1},                               // POST_BLUR
+    {SIGMA_NO_PERMUTATIONS, 1},                                         // TEMPORAL_STABILIZATION
+    {SIGMA_NO_PERMUTATIONS, 1, nrd::DenoiserFeatureBits::SPLIT_SCREEN}, // SPLIT_SCREEN
+}};
 
+void nrd::InstanceImpl::Update_SigmaShadow(const DenoiserData& denoiserData)
+{
     const SigmaSettings& settings = denoiserData.settings.sigma;
 
     // SPLIT_SCREEN (passthrough)
     if (m_CommonSettings.splitScreen >= 1.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Sigma(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::SPLIT_SCREEN));
 
         return;
     }
 
     { // CLASSIFY_TILES
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::CLASSIFY_TILES));
-        AddSharedConstants_Sigma(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::CLASSIFY_TILES));
     }
 
     { // SMOOTH_TILES
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SMOOTH_TILES));
-        AddSharedConstants_Sigma(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::SMOOTH_TILES));
     }
 
     { // BLUR
-        SIGMA_BlurConstants* consts = (SIGMA_BlurConstants*)PushDispatch(denoiserData, AsUint(Dispatch::BLUR));
-        AddSharedConstants_Sigma(settings, consts);
-        consts->gRotator = m_Rotator_Blur; // TODO: push constant
+        SIGMA_BlurConstants* consts = (SIGMA_BlurConstants*)PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::BLUR));
+        SetPerFrameConstant(consts->gRotator, m_Rotator_Blur);
     }
 
     { // POST_BLUR
-        uint32_t passIndex = AsUint(Dispatch::POST_BLUR) + (settings.stabilizationStrength != 0.0f ? 1 : 0);
+        uint32_t passIndex = GetDispatchIndex(g_SigmaPasses, SigmaPass::POST_BLUR, settings.stabilizationStrength != 0.0f ? 1 : 0);
         SIGMA_BlurConstants* consts = (SIGMA_BlurConstants*)PushDispatch(denoiserData, passIndex);
-        AddSharedConstants_Sigma(settings, consts);
-        consts->gRotator = m_Rotator_PostBlur; // TODO: push constant
+        SetPerFrameConstant(consts->gRotator, m_Rotator_PostBlur);
     }
 
     // TEMPORAL_STABILIZATION
     if (settings.stabilizationStrength != 0.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::TEMPORAL_STABILIZATION));
-        AddSharedConstants_Sigma(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::TEMPORAL_STABILIZATION));
     }
 
     // SPLIT_SCREEN
     if (m_CommonSettings.splitScreen > 0.0f)
     {
-        void* consts = PushDispatch(denoiserData, AsUint(Dispatch::SPLIT_SCREEN));
-        AddSharedConstants_Sigma(settings, consts);
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::SPLIT_SCREEN));
     }
 }
 
-void nrd::InstanceImpl::AddSharedConstants_Sigma(const SigmaSettings& settings, void* data)
+void nrd::InstanceImpl::Update_SigmaShadowArray(const DenoiserData& denoiserData)
+{
+    const SigmaSettings& settings = denoiserData.settings.sigmaArray.sigma;
+    uint16_t layersNum = denoiserData.desc.layersNum;
+
+    // SPLIT_SCREEN (passthrough)
+    if (m_CommonSettings.splitScreen >= 1.0f)
+    {
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::SPLIT_SCREEN), layersNum);
+
+        return;
+    }
+
+    { // CLASSIFY_TILES (all layers in one pass)
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::CLASSIFY_TILES));
+    }
+
+    { // SMOOTH_TILES
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::SMOOTH_TILES), layersNum);
+    }
+
+    { // BLUR
+        SigmaArray::SIGMA_BlurConstants* consts = (SigmaArray::SIGMA_BlurConstants*)PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::BLUR), layersNum);
+        SetPerFrameConstant(consts->gRotator, m_Rotator_Blur);
+    }
+
+    { // POST_BLUR
+        uint32_t passIndex = GetDispatchIndex(g_SigmaPasses, SigmaPass::POST_BLUR, settings.stabilizationStrength != 0.0f ? 1 : 0);
+        SigmaArray::SIGMA_BlurConstants* consts = (SigmaArray::SIGMA_BlurConstants*)PushDispatch(denoiserData, passIndex, layersNum);
+        SetPerFrameConstant(consts->gRotator, m_Rotator_PostBlur);
+    }
+
+    // TEMPORAL_STABILIZATION
+    if (settings.stabilizationStrength != 0.0f)
+    {
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::TEMPORAL_STABILIZATION), layersNum);
+    }
+
+    // SPLIT_SCREEN
+    if (m_CommonSettings.splitScreen > 0.0f)
+    {
+        PushDispatch(denoiserData, GetDispatchIndex(g_SigmaPasses, SigmaPass::SPLIT_SCREEN), layersNum);
+    }
+}
+
+size_t nrd::InstanceImpl::AddSharedConstants_Sigma(const SigmaSettings& settings, void* data)
 {
     struct SharedConstants
     {
         SIGMA_SHARED_CONSTANTS
+        uint8_t end; // trailing padding can be occupied by non-shared constants
     };
 
     NRD_DECLARE_DIMS;
@@ -125,6 +203,32 @@ void nrd::InstanceImpl::AddSharedConstants_Sigma(const SigmaSettings& settings,
     consts->gViewZScale             = m_CommonSettings.viewZScale;
     consts->gMinRectDimMulUnproject = (float)min(rectW, rectH) * unproject;
     consts->gFrameIndex             = m_CommonSettings.frameIndex;
+
+    return offsetof(SharedConstants, end);
+}
+
+size_t nrd::InstanceImpl::AddSharedConstants_SigmaArray(const SigmaArraySettings& settings, uint16_t layersNum, void* data)
+{
+    struct SharedConstants
+    {
+        SIGMA_SHARED_CONSTANTS
+        SIGMA_ARRAY_CONSTANTS
+        uint8_t end; // trailing padding can be occupied by non-shared constants
+    };
+
+    AddSharedConstants_Sigma(settings.sigma, data);
+
+    SharedConstants* consts         = (SharedConstants*)data;
+    consts->gLayersNum              = layersNum;
+
+    for (uint32_t i = 0; i < SIGMA_MAX_LAYERS_NUM; i++)
+    {
+        const float* lightDirection = settings.lightDirections[i];
+        float3 lightDirectionView = Rotate(m_WorldToView, float3(lightDirection[0], lightDirection[1], lightDirection[2]));
+        consts->gLightDirectionsView[i] = float4(lightDirectionView.x, lightDirectionView.y, lightDirectionView.z, 0.0f);
+    }
+
+    return offsetof(SharedConstants, end);
 }
 
 // SIGMA_SHADOW
@@ -184,3 +288,41 @@ void nrd::InstanceImpl::AddSharedConstants_Sigma(const SigmaSettings& settings,
 #endif
 
 #include "Denoisers/Sigma_ShadowTranslucency.hpp"
+
+
+// SIGMA_SHADOW_ARRAY
+#ifdef NRD_EMBEDS_DXBC_SHADERS
+    #include "SIGMA_ShadowArray_ClassifyTiles.cs.dxbc.h"
+    #include "SIGMA_ShadowArray_SmoothTiles.cs.dxbc.h"
+    #include "SIGMA_ShadowArray_Blur.cs.dxbc.h"
+    #include "SIGMA_ShadowArray_PostBlur.cs.dxbc.h"
+    #include "SIGMA_ShadowArray_TemporalStabilization.cs.dxbc.h"
+    #include "SIGMA_ShadowArray_SplitScreen.cs.dxbc.h"
+#endif
+
+#ifdef NRD_EMBEDS_DXIL_SHADERS
+    #include "SIGMA_ShadowArray_ClassifyTiles.cs.dxil.h"
+    #include "SIGMA_ShadowArray_SmoothTiles.cs.dxil.h"
+    #include "SIGMA_ShadowArray_Blur.cs.dxil.h"
+    #include "SIGMA_ShadowArray_PostBlur.cs.dxil.h"
+    #include "SIGMA_ShadowArray_TemporalStabilization.cs.dxil.h"
+    #include "SIGMA_ShadowArray_SplitScreen.cs.dxil.h"
+#endif
+
+#ifdef NRD_EMBEDS_SPIRV_SHADERS
+    #include "SIGMA_ShadowArray_ClassifyTiles.cs.spirv.h"
+    #include "SIGMA_ShadowArray_SmoothTiles.cs.spirv.h"
+    #include "SIGMA_ShadowArray_Blur.cs.spirv.h"
+    #include "SIGMA_ShadowArray_PostBlur.cs.spirv.h"
+    #include "SIGMA_ShadowArray_TemporalStabilization.cs.spirv.h"
+    #include "SIGMA_ShadowArray_SplitScreen.cs.spirv.h"
+#endif
+
+#include "Denoisers/Sigma_ShadowArray.hpp"
+
+// Pipelines are shared by all denoisers of the family
+static_assert(nrd::PassChecker::IsLayoutShared({
+    &nrd::g_PassCheckers<SigmaPass, g_SigmaPasses, nrd::SigmaShadow::AddPass>,
+    &nrd::g_PassCheckers<SigmaPass, g_SigmaPasses, nrd::SigmaShadowTranslucency::AddPass>,
+    &nrd::g_PassCheckers<SigmaPass, g_SigmaPasses, nrd::SigmaShadowArray::AddPass>
+}), "A shader must be bound with the same layout in all passes using it");
@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// CPU reference of "REBLUR_CompactTiles.cs.hlsl" (keep in sync), also defines the layout of indirect arguments
+namespace nrd
+{
+    constexpr uint32_t TILE_SIZE = 16; // pixels, must match "REBLUR_TILE_SIZE"
+    constexpr uint32_t TILE_COMPACTION_THREAD_NUM = 256; // single group
+    constexpr uint32_t INVALID_TILE = 0xFFFFFFFF;
+
+    inline uint32_t PackTile(uint32_t x, uint32_t y)
+    { return x | (y << 16); }
+
+    // "tiles" - "tilesW x tilesH" classification (0 - has data, != 0 - sky)
+    // "tileList" - "tilesW x tilesH" list, entry "i" is at "(i % tilesW, i / tilesW)", unused slots of the last row are "INVALID_TILE"
+    // "indirectArgs" - group counts of a consumer running "groupsPerTileX x groupsPerTileY" groups per tile
+    // Returns the number of listed tiles
+    inline uint32_t CompactTiles(const float* tiles, uint32_t tilesW, uint32_t tilesH, uint32_t groupsPerTileX, uint32_t groupsPerTileY, uint32_t* tileList, uint32_t indirectArgs[3])
+    {
+        uint32_t tilesNum = tilesW * tilesH;
+        uint32_t chunkSize = (tilesNum + TILE_COMPACTION_THREAD_NUM - 1) / TILE_COMPACTION_THREAD_NUM;
+
+        // Count (per thread)
+        uint32_t offsets[TILE_COMPACTION_THREAD_NUM];
+        uint32_t liveNums[TILE_COMPACTION_THREAD_NUM];
+        for (uint32_t t = 0; t < TILE_COMPACTION_THREAD_NUM; t++)
+        {
+            uint32_t chunkBegin = t * chunkSize < tilesNum ? t * chunkSize : tilesNum;
+            uint32_t chunkEnd = chunkBegin + chunkSize < tilesNum ? chunkBegin + chunkSize : tilesNum;
+
+            liveNums[t] = 0;
+            for (uint32_t n = chunkBegin; n < chunkEnd; n++)
+                liveNums[t] += tiles[n] == 0.0f ? 1 : 0;
+
+            offsets[t] = liveNums[t];
+        }
+
+        // Inclusive prefix sum (Hillis-Steele, as in the shader)
+        for (uint32_t stride = 1; stride < TILE_COMPACTION_THREAD_NUM; stride <<= 1)
+        {
+            uint32_t sums[TILE_COMPACTION_THREAD_NUM];
+            for (uint32_t t = 0; t < TILE_COMPACTION_THREAD_NUM; t++)
+                sums[t] = offsets[t] + (t >= stride ? offsets[t - stride] : 0);
+
+            for (uint32_t t = 0; t < TILE_COMPACTION_THREAD_NUM; t++)
+                offsets[t] = sums[t];
+        }
+
+        // Write the list
+        for (uint32_t t = 0; t < TILE_COMPACTION_THREAD_NUM; t++)
+        {
+            uint32_t chunkBegin = t * chunkSize < tilesNum ? t * chunkSize : tilesNum;
+            uint32_t chunkEnd = chunkBegin + chunkSize < tilesNum ? chunkBegin + chunkSize : tilesNum;
+
+            uint32_t listIndex = offsets[t] - liveNums[t];
+            for (uint32_t n = chunkBegin; n < chunkEnd; n++)
+            {
+                if (tiles[n] == 0.0f)
+                    tileList[listIndex++] = PackTile(n % tilesW, n / tilesW);
+            }
+        }
+
+        // Unused slots of the last row
+        uint32_t listNum = offsets[TILE_COMPACTION_THREAD_NUM - 1];
+        uint32_t listRowsNum = (listNum + tilesW - 1) / tilesW;
+        for (uint32_t n = listNum; n < listRowsNum * tilesW; n++)
+            tileList[n] = INVALID_TILE;
+
+        // Indirect arguments
+        indirectArgs[0] = groupsPerTileX * (listNum < tilesW ? listNum : tilesW);
+        indirectArgs[1] = groupsPerTileY * listRowsNum;
+        indirectArgs[2] = 1;
+
+        return listNum;
+    }
+}
@@ -40,6 +40,7 @@ constexpr std::array<nrd::Denoiser, (size_t)nrd::Denoiser::MAX_NUM> g_NrdSupport
     nrd::Denoiser::RELAX_DIFFUSE_SPECULAR_SH,
     nrd::Denoiser::SIGMA_SHADOW,
     nrd::Denoiser::SIGMA_SHADOW_TRANSLUCENCY,
+    nrd::Denoiser::SIGMA_SHADOW_ARRAY,
     nrd::Denoiser::REFERENCE,
 };
 
@@ -52,7 +53,12 @@ constexpr nrd::LibraryDesc g_NrdLibraryDesc =
     VERSION_MINOR,
     VERSION_BUILD,
     (nrd::NormalEncoding)NRD_NORMAL_ENCODING,
-    (nrd::RoughnessEncoding)NRD_ROUGHNESS_ENCODING
+    (nrd::RoughnessEncoding)NRD_ROUGHNESS_ENCODING,
+#ifdef NRD_BINDLESS
+    true,
+#else
+    false,
+#endif
 };
 
 const char* g_NrdResourceTypeNames[] =
@@ -94,6 +100,7 @@ const char* g_NrdResourceTypeNames[] =
 
     "TRANSIENT_POOL",
     "PERMANENT_POOL",
+    "INDIRECT_ARGUMENTS_POOL",
 };
 static_assert( GetCountOf(g_NrdResourceTypeNames) == (uint32_t)nrd::ResourceType::MAX_NUM );
 
@@ -119,6 +126,7 @@ const char* g_NrdDenoiserNames[] =
 
     "SIGMA_SHADOW",
     "SIGMA_SHADOW_TRANSLUCENCY",
+    "SIGMA_SHADOW_ARRAY",
 
     "REFERENCE",
 };
@@ -264,6 +272,24 @@ NRD_API nrd::Result NRD_CALL nrd::CreateInstance(const InstanceCreationDesc& ins
     return result;
 }
 
+NRD_API nrd::Result NRD_CALL nrd::CreateFrameContext(const Instance& instance, Instance*& frameContext)
+{
+    StdAllocator<uint8_t> memoryAllocator = ((const InstanceImpl&)instance).GetStdAllocator();
+
+    InstanceImpl* implementation = Allocate<InstanceImpl>(memoryAllocator, memoryAllocator);
+    const Result result = implementation->CreateFrameContext((const InstanceImpl&)instance);
+
+    if (result == Result::SUCCESS)
+    {
+        frameContext = (Instance*)implementation;
+        return Result::SUCCESS;
+    }
+
+    Deallocate(memoryAllocator, implementation);
+
+    return result;
+}
+
 NRD_API const nrd::InstanceDesc& NRD_CALL nrd::GetInstanceDesc(const Instance& denoiser)
 {
     return ((const InstanceImpl&)denoiser).GetDesc();
@@ -284,6 +310,21 @@ NRD_API nrd::Result NRD_CALL nrd::GetComputeDispatches(Instance& instance, const
     return ((InstanceImpl&)instance).GetComputeDispatches(identifiers, identifiersNum, dispatchDescs, dispatchDescsNum);
 }
 
+NRD_API nrd::Result NRD_CALL nrd::GetComputeDispatchesMultiView(Instance& instance, const ViewDesc* viewDescs, uint32_t viewDescsNum, const DispatchDesc*& dispatchDescs, uint32_t& dispatchDescsNum)
+{
+    return ((InstanceImpl&)instance).GetComputeDispatchesMultiView(viewDescs, viewDescsNum, dispatchDescs, dispatchDescsNum);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::ReleaseFrame(Instance& instance, const DispatchDesc* dispatchDescs)
+{
+    return ((InstanceImpl&)instance).ReleaseFrame(dispatchDescs);
+}
+
+NRD_API nrd::Result NRD_CALL nrd::GetDispatchDependencies(Instance& instance, const DispatchDependencyDesc*& dependencyDescs, uint32_t& dependencyDescsNum)
+{
+    return ((InstanceImpl&)instance).GetDispatchDependencies(dependencyDescs, dependencyDescsNum);
+}
+
 NRD_API void NRD_CALL nrd::DestroyInstance(Instance& instance)
 {
     StdAllocator<uint8_t> memoryAllocator = ((InstanceImpl&)instance).GetStdAllocator();
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Cost of "CreateInstance" + "DestroyInstance" for 1-64 denoisers (all denoiser types, round-robin)
+
+#include "NRD.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+constexpr uint32_t REPEAT_NUM = 20;
+
+static const char* g_ResultStrings[] = {"SUCCESS", "FAILURE", "INVALID_ARGUMENT", "UNSUPPORTED", "NON_UNIQUE_IDENTIFIER"};
+static_assert(sizeof(g_ResultStrings) / sizeof(g_ResultStrings[0]) == (uint32_t)nrd::Result::MAX_NUM, "Update 'g_ResultStrings'");
+
+// "CreateInstance" reports a single result for all denoisers, retry them one by one to name the culprit
+static void PrintFailure(const std::vector<nrd::DenoiserDesc>& denoiserDescs, nrd::Result result)
+{
+    printf("CreateInstance failed for %u denoisers: %s\n", (uint32_t)denoiserDescs.size(), g_ResultStrings[(uint32_t)result]);
+
+    for (const nrd::DenoiserDesc& denoiserDesc : denoiserDescs)
+    {
+        nrd::InstanceCreationDesc instanceCreationDesc = {};
+        instanceCreationDesc.denoisers = &denoiserDesc;
+        instanceCreationDesc.denoisersNum = 1;
+
+        nrd::Instance* instance = nullptr;
+        nrd::Result denoiserResult = nrd::CreateInstance(instanceCreationDesc, instance);
+        if (denoiserResult == nrd::Result::SUCCESS)
+            nrd::DestroyInstance(*instance);
+        else
+            printf("  identifier %u (%s): %s\n", denoiserDesc.identifier, nrd::GetDenoiserString(denoiserDesc.denoiser), g_ResultStrings[(uint32_t)denoiserResult]);
+    }
+}
+
+int main()
+{
+    printf("denoisers  pipelines  ms/instance\n");
+
+    for (uint32_t denoisersNum = 1; denoisersNum <= 64; denoisersNum *= 2)
+    {
+        std::vector<nrd::DenoiserDesc> denoiserDescs(denoisersNum);
+        for (uint32_t i = 0; i < denoisersNum; i++)
+        {
+            nrd::Denoiser denoiser = (nrd::Denoiser)(i % (uint32_t)nrd::Denoiser::MAX_NUM);
+            denoiserDescs[i] = {i + 1, denoiser};
+
+            if (denoiser == nrd::Denoiser::SIGMA_SHADOW_ARRAY)
+                denoiserDescs[i].layersNum = 4;
+        }
+
+        nrd::InstanceCreationDesc instanceCreationDesc = {};
+        instanceCreationDesc.denoisers = denoiserDescs.data();
+        instanceCreationDesc.denoisersNum = denoisersNum;
+
+        uint32_t pipelinesNum = 0;
+
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < REPEAT_NUM; i++)
+        {
+            nrd::Instance* instance = nullptr;
+            nrd::Result result = nrd::CreateInstance(instanceCreationDesc, instance);
+            if (result != nrd::Result::SUCCESS)
+            {
+                PrintFailure(denoiserDescs, result);
+                return 1;
+            }
+
+            pipelinesNum = nrd::GetInstanceDesc(*instance).pipelinesNum;
+
+            nrd::DestroyInstance(*instance);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - begin).count() / REPEAT_NUM;
+        printf("%9u  %9u  %11.3f\n", denoisersNum, pipelinesNum, ms);
+    }
+
+    return 0;
+}
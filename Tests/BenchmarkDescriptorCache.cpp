@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Cost of a descriptor cache lookup (as done by "NRDIntegration" per texture binding) for 16-1024 textures, with and without
+// recreating 1/8 of textures every frame (same native object, new texture object). Headless: textures and views are fake
+
+#include "../Integration/NRDDescriptorCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+constexpr uint32_t FRAME_NUM = 200;
+constexpr uint32_t BUFFERED_FRAMES_NUM = 2;
+constexpr uint32_t LOOKUPS_PER_TEXTURE = 8; // a texture is typically bound by several dispatches
+
+struct Texture
+{
+    uint64_t nativeObject;
+};
+
+struct Descriptor
+{
+    const Texture* texture;
+};
+
+int main()
+{
+    printf("textures  recreated/frame  lookup (ns)  views created/frame\n");
+
+    for (uint32_t churn = 0; churn < 2; churn++)
+    {
+        for (uint32_t texturesNum = 16; texturesNum <= 1024; texturesNum *= 4)
+        {
+            nrd::DescriptorCache<Texture, Descriptor> descriptorCache;
+            std::vector<Texture> textures[2] = {std::vector<Texture>(texturesNum), std::vector<Texture>(texturesNum)};
+            std::vector<Descriptor*> descriptorsInFlight[BUFFERED_FRAMES_NUM];
+
+            for (uint32_t i = 0; i < texturesNum; i++)
+                textures[0][i].nativeObject = textures[1][i].nativeObject = 0x10000 + i * 256;
+
+            uint32_t recreatedNum = churn ? texturesNum / 8 : 0;
+            uint64_t createdNum = 0;
+            uint64_t staleNum = 0;
+            double lookupNs = 0.0;
+
+            for (uint32_t frame = 0; frame < FRAME_NUM; frame++)
+            {
+                uint32_t bufferedFrame = frame % BUFFERED_FRAMES_NUM;
+                for (Descriptor* descriptor : descriptorsInFlight[bufferedFrame])
+                    delete descriptor;
+                descriptorsInFlight[bufferedFrame].clear();
+
+                auto retireInFlight = [&](Descriptor* descriptor) { descriptorsInFlight[bufferedFrame].push_back(descriptor); };
+                descriptorCache.Evict(frame, BUFFERED_FRAMES_NUM, retireInFlight);
+
+                // Recreated textures get the same native objects, but live in another texture object
+                std::vector<const Texture*> userPool(texturesNum);
+                for (uint32_t i = 0; i < texturesNum; i++)
+                    userPool[i] = &textures[i < recreatedNum ? (frame & 1) : 0][i];
+
+                auto t0 = std::chrono::high_resolution_clock::now();
+                for (uint32_t j = 0; j < LOOKUPS_PER_TEXTURE; j++)
+                {
+                    for (uint32_t i = 0; i < texturesNum; i++)
+                    {
+                        const Texture* texture = userPool[(i * 7 + j) % texturesNum];
+                        uint64_t key = texture->nativeObject | (uint64_t(j & 1) << 63ull);
+
+                        auto& entry = descriptorCache.Find(key, texture, frame, retireInFlight);
+                        if (!entry.descriptor)
+                        {
+                            entry.descriptor = new Descriptor{texture};
+                            createdNum++;
+                        }
+
+                        // A view of a recreated texture must not be returned
+                        staleNum += entry.descriptor->texture != texture ? 1 : 0;
+                    }
+                }
+                auto t1 = std::chrono::high_resolution_clock::now();
+
+                lookupNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            }
+
+            printf("%8u  %15u  %11.1f  %19.1f\n", texturesNum, recreatedNum, lookupNs / (FRAME_NUM * texturesNum * LOOKUPS_PER_TEXTURE), double(createdNum) / FRAME_NUM);
+
+            if (staleNum)
+                return 1;
+
+            descriptorCache.Clear([](Descriptor* descriptor) { delete descriptor; });
+            for (std::vector<Descriptor*>& descriptors : descriptorsInFlight)
+            {
+                for (Descriptor* descriptor : descriptors)
+                    delete descriptor;
+            }
+        }
+    }
+
+    return 0;
+}
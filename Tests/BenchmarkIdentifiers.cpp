@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Cost of "SetDenoiserSettings" (per call) and "GetComputeDispatches" (per frame) for 1-128 SIGMA_SHADOW identifiers (one per light).
+// "GetComputeDispatches" is measured with settings changing every frame (the frame plan gets rebuilt) and with fixed settings (the plan gets reused)
+
+#include "NRD.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+constexpr uint32_t FRAME_NUM = 200;
+
+int main()
+{
+    printf("identifiers  dispatches  SetDenoiserSettings (ns/call)  GetComputeDispatches (us/frame): changing settings  fixed settings\n");
+
+    for (uint32_t identifiersNum = 1; identifiersNum <= 128; identifiersNum *= 2)
+    {
+        // Sparse identifiers, as produced by light IDs
+        std::vector<nrd::DenoiserDesc> denoiserDescs(identifiersNum);
+        std::vector<nrd::Identifier> identifiers(identifiersNum);
+        for (uint32_t i = 0; i < identifiersNum; i++)
+        {
+            identifiers[i] = i * 7919 + 1;
+            denoiserDescs[i] = {identifiers[i], nrd::Denoiser::SIGMA_SHADOW};
+        }
+
+        nrd::InstanceCreationDesc instanceCreationDesc = {};
+        instanceCreationDesc.denoisers = denoiserDescs.data();
+        instanceCreationDesc.denoisersNum = identifiersNum;
+
+        nrd::Instance* instance = nullptr;
+        if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS)
+            return 1;
+
+        nrd::CommonSettings commonSettings = {};
+        commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 1920;
+        commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 1080;
+
+        nrd::SigmaSettings sigmaSettings = {};
+
+        const nrd::DispatchDesc* dispatchDescs = nullptr;
+        uint32_t dispatchDescsNum = 0;
+
+        double setNs = 0.0;
+        double getUs[2] = {};
+
+        for (uint32_t isSettingsFixed = 0; isSettingsFixed < 2; isSettingsFixed++)
+        {
+            for (uint32_t frame = 0; frame < FRAME_NUM; frame++)
+            {
+                commonSettings.frameIndex = frame;
+                nrd::SetCommonSettings(*instance, commonSettings);
+
+                auto t0 = std::chrono::high_resolution_clock::now();
+                for (uint32_t i = 0; i < identifiersNum; i++)
+                {
+                    sigmaSettings.lightDirection[0] = float(isSettingsFixed ? i : frame + i);
+                    nrd::SetDenoiserSettings(*instance, identifiers[i], &sigmaSettings);
+                }
+
+                auto t1 = std::chrono::high_resolution_clock::now();
+                nrd::GetComputeDispatches(*instance, identifiers.data(), identifiersNum, dispatchDescs, dispatchDescsNum);
+                auto t2 = std::chrono::high_resolution_clock::now();
+
+                setNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+                getUs[isSettingsFixed] += std::chrono::duration<double, std::micro>(t2 - t1).count();
+            }
+        }
+
+        printf("%11u  %10u  %29.1f  %49.1f  %14.1f\n", identifiersNum, dispatchDescsNum, setNs / (2 * FRAME_NUM * identifiersNum), getUs[0] / FRAME_NUM, getUs[1] / FRAME_NUM);
+
+        nrd::DestroyInstance(*instance);
+    }
+
+    return 0;
+}
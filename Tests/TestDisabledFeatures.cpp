@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Validates features needed by passes ("PassDesc::feature", "g_VariantFeatures"): disabling a feature in "DenoiserDesc::disabledFeatures"
+// removes exactly the pipelines of shaders named after it, and dispatches not needing it still work
+
+#include "NRD.h"
+
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+
+struct Feature
+{
+    nrd::DenoiserFeatureBits bit;
+    const char* shaderNamePart;
+};
+
+static const Feature g_Features[] =
+{
+    {nrd::DenoiserFeatureBits::PERFORMANCE_MODE, "_Perf_"},
+    {nrd::DenoiserFeatureBits::HIT_DISTANCE_RECONSTRUCTION, "_HitDistReconstruction"},
+    {nrd::DenoiserFeatureBits::SPLIT_SCREEN, "_SplitScreen"},
+    {nrd::DenoiserFeatureBits::VALIDATION, "_Validation"},
+};
+
+static bool GetPipelines(nrd::Denoiser denoiser, uint32_t disabledFeatures, std::set<std::string>& pipelines)
+{
+    nrd::DenoiserDesc denoiserDesc = {1, denoiser};
+    denoiserDesc.disabledFeatures = disabledFeatures;
+    denoiserDesc.layersNum = denoiser == nrd::Denoiser::SIGMA_SHADOW_ARRAY ? 2 : 0;
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = &denoiserDesc;
+    instanceCreationDesc.denoisersNum = 1;
+
+    nrd::Instance* instance = nullptr;
+    if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS)
+        return false;
+
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*instance);
+    for (uint32_t i = 0; i < instanceDesc.pipelinesNum; i++)
+        pipelines.insert(instanceDesc.pipelines[i].shaderFileName);
+
+    // Defaults don't request any of the tested features
+    nrd::CommonSettings commonSettings = {};
+    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 1920;
+    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 1080;
+    nrd::SetCommonSettings(*instance, commonSettings);
+
+    const nrd::DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+    nrd::Identifier identifier = 1;
+    nrd::Result result = nrd::GetComputeDispatches(*instance, &identifier, 1, dispatchDescs, dispatchDescsNum);
+
+    nrd::DestroyInstance(*instance);
+
+    return result == nrd::Result::SUCCESS && dispatchDescsNum != 0;
+}
+
+int main()
+{
+    uint32_t errorsNum = 0;
+    uint32_t removedNums[sizeof(g_Features) / sizeof(g_Features[0])] = {};
+
+    for (uint32_t d = 0; d < (uint32_t)nrd::Denoiser::MAX_NUM; d++)
+    {
+        nrd::Denoiser denoiser = (nrd::Denoiser)d;
+
+        std::set<std::string> pipelinesAll;
+        if (!GetPipelines(denoiser, 0, pipelinesAll))
+        {
+            printf("Denoiser %u: can't be created or dispatched\n", d);
+            errorsNum++;
+            continue;
+        }
+
+        for (size_t f = 0; f < sizeof(g_Features) / sizeof(g_Features[0]); f++)
+        {
+            const Feature& feature = g_Features[f];
+
+            std::set<std::string> pipelines;
+            if (!GetPipelines(denoiser, (uint32_t)feature.bit, pipelines))
+            {
+                printf("Denoiser %u, feature %u: can't be created or dispatched\n", d, (uint32_t)feature.bit);
+                errorsNum++;
+                continue;
+            }
+
+            std::set<std::string> pipelinesExpected;
+            for (const std::string& pipeline : pipelinesAll)
+            {
+                if (!strstr(pipeline.c_str(), feature.shaderNamePart))
+                    pipelinesExpected.insert(pipeline);
+            }
+
+            if (pipelines != pipelinesExpected)
+            {
+                printf("Denoiser %u, feature %u: %zu pipelines instead of %zu\n", d, (uint32_t)feature.bit, pipelines.size(), pipelinesExpected.size());
+                errorsNum++;
+            }
+
+            removedNums[f] += uint32_t(pipelinesAll.size() - pipelines.size());
+        }
+    }
+
+    // Each feature must have shaders to remove
+    for (size_t f = 0; f < sizeof(g_Features) / sizeof(g_Features[0]); f++)
+    {
+        if (!removedNums[f])
+        {
+            printf("Feature %u: no pipelines removed\n", (uint32_t)g_Features[f].bit);
+            errorsNum++;
+        }
+    }
+
+    printf("%s\n", errorsNum ? "FAILED" : "PASSED");
+
+    return errorsNum ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Validates "GetDispatchDependencies" against a brute-force hazard scan:
+// - every edge must connect a hazard pair ("before < after", a shared resource written by at least one of them)
+// - every hazard pair must be ordered by the graph (directly or transitively)
+
+#include "NRD.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static bool IsSameResource(const nrd::ResourceDesc& a, const nrd::ResourceDesc& b)
+{
+    if (a.type != b.type)
+        return false;
+
+    if (a.type == nrd::ResourceType::PERMANENT_POOL || a.type == nrd::ResourceType::TRANSIENT_POOL || a.type == nrd::ResourceType::INDIRECT_ARGUMENTS_POOL)
+        return a.indexInPool == b.indexInPool;
+
+    return true;
+}
+
+static bool IsRead(const nrd::ResourceDesc& resource)
+{
+    return resource.descriptorType == nrd::DescriptorType::TEXTURE || resource.descriptorType == nrd::DescriptorType::INDIRECT_ARGUMENTS;
+}
+
+static bool IsHazard(const nrd::DispatchDesc& a, const nrd::DispatchDesc& b)
+{
+    for (uint32_t i = 0; i < a.resourcesNum; i++)
+    {
+        for (uint32_t j = 0; j < b.resourcesNum; j++)
+        {
+            const nrd::ResourceDesc& resourceA = a.resources[i];
+            const nrd::ResourceDesc& resourceB = b.resources[j];
+
+            bool isWrite = !IsRead(resourceA) || !IsRead(resourceB);
+            if (isWrite && IsSameResource(resourceA, resourceB))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+int main()
+{
+    // Independent chains sharing read-only guides, plus a denoiser appearing only in some frames
+    const nrd::DenoiserDesc denoiserDescs[] =
+    {
+        {1, nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR},
+        {2, nrd::Denoiser::SIGMA_SHADOW},
+        {3, nrd::Denoiser::SIGMA_SHADOW},
+        {4, nrd::Denoiser::RELAX_DIFFUSE},
+        {5, nrd::Denoiser::REFERENCE},
+    };
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs;
+    instanceCreationDesc.denoisersNum = (uint32_t)(sizeof(denoiserDescs) / sizeof(denoiserDescs[0]));
+
+    nrd::Instance* instance = nullptr;
+    if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS)
+        return 1;
+
+    const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    const float projection[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, -0.1f, 0};
+
+    nrd::CommonSettings commonSettings = {};
+    memcpy(commonSettings.viewToClipMatrix, projection, sizeof(projection));
+    memcpy(commonSettings.viewToClipMatrixPrev, projection, sizeof(projection));
+    memcpy(commonSettings.worldToViewMatrix, identity, sizeof(identity));
+    memcpy(commonSettings.worldToViewMatrixPrev, identity, sizeof(identity));
+    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 1920;
+    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 1080;
+    commonSettings.timeDeltaBetweenFrames = 16.0f;
+
+    uint32_t errorsNum = 0;
+    for (uint32_t frame = 0; frame < 8; frame++)
+    {
+        // Covers both ping-pong parities, a history reset (clears) and a changing denoiser set
+        commonSettings.frameIndex = frame;
+        commonSettings.accumulationMode = frame == 5 ? nrd::AccumulationMode::CLEAR_AND_RESTART : nrd::AccumulationMode::CONTINUE;
+        nrd::SetCommonSettings(*instance, commonSettings);
+
+        const nrd::Identifier identifiers[] = {1, 2, 3, 4, 5};
+        uint32_t identifiersNum = frame >= 6 ? 5 : 4;
+
+        const nrd::DispatchDesc* dispatchDescs = nullptr;
+        uint32_t dispatchDescsNum = 0;
+        nrd::GetComputeDispatches(*instance, identifiers, identifiersNum, dispatchDescs, dispatchDescsNum);
+
+        const nrd::DispatchDependencyDesc* dependencyDescs = nullptr;
+        uint32_t dependencyDescsNum = 0;
+        if (nrd::GetDispatchDependencies(*instance, dependencyDescs, dependencyDescsNum) != nrd::Result::SUCCESS)
+            return 1;
+
+        // Direct edges
+        std::vector<char> edges(dispatchDescsNum * dispatchDescsNum, 0);
+        for (uint32_t i = 0; i < dependencyDescsNum; i++)
+        {
+            const nrd::DispatchDependencyDesc& dependencyDesc = dependencyDescs[i];
+            if (dependencyDesc.before >= dependencyDesc.after || dependencyDesc.after >= dispatchDescsNum)
+            {
+                printf("Frame %u: invalid edge %u -> %u\n", frame, dependencyDesc.before, dependencyDesc.after);
+                errorsNum++;
+            }
+            else
+                edges[dependencyDesc.before * dispatchDescsNum + dependencyDesc.after] = 1;
+        }
+
+        // Transitive closure (edges always point forward, so a reverse sweep is enough)
+        std::vector<char> reachable(dispatchDescsNum * dispatchDescsNum, 0);
+        for (uint32_t a = dispatchDescsNum; a-- > 0; )
+        {
+            for (uint32_t b = a + 1; b < dispatchDescsNum; b++)
+            {
+                if (!edges[a * dispatchDescsNum + b])
+                    continue;
+
+                reachable[a * dispatchDescsNum + b] = 1;
+                for (uint32_t c = b + 1; c < dispatchDescsNum; c++)
+                    reachable[a * dispatchDescsNum + c] |= reachable[b * dispatchDescsNum + c];
+            }
+        }
+
+        // Brute-force hazard scan over all pairs
+        for (uint32_t a = 0; a < dispatchDescsNum; a++)
+        {
+            for (uint32_t b = a + 1; b < dispatchDescsNum; b++)
+            {
+                bool isHazard = IsHazard(dispatchDescs[a], dispatchDescs[b]);
+
+                if (isHazard && !reachable[a * dispatchDescsNum + b])
+                {
+                    printf("Frame %u: missing dependency '%s' (%u) -> '%s' (%u)\n", frame, dispatchDescs[a].name, a, dispatchDescs[b].name, b);
+                    errorsNum++;
+                }
+
+                if (!isHazard && edges[a * dispatchDescsNum + b])
+                {
+                    printf("Frame %u: spurious dependency '%s' (%u) -> '%s' (%u)\n", frame, dispatchDescs[a].name, a, dispatchDescs[b].name, b);
+                    errorsNum++;
+                }
+            }
+        }
+    }
+
+    nrd::DestroyInstance(*instance);
+
+    printf("%s\n", errorsNum ? "FAILED" : "PASSED");
+
+    return errorsNum ? 1 : 0;
+}
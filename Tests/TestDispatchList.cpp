@@ -0,0 +1,330 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Compares dispatch lists of all denoisers over a sweep of settings with "DispatchList.txt" (CTest runs it in "Tests"). Per denoiser:
+// - pipelines
+// - distinct dispatches (name, shader, grid, resources as "[W:]type(indexInPool)") in order of appearance
+// - distinct sequences of dispatches returned by "GetComputeDispatches"
+// - per common settings variant: sequences for all combinations of denoiser settings
+// "TestDispatchList --update" rewrites the reference, so changes of registered passes get reviewed as a text diff
+
+#include "NRD.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+constexpr const char* REFERENCE_FILE_NAME = "DispatchList.txt";
+
+// Common settings
+enum CommonVariant
+{
+    BASE,
+    ODD_FRAME,
+    OPTIONAL_INPUTS,
+    VALIDATION,
+    SPLIT_SCREEN,
+    PASSTHROUGH,
+    RESTART,
+
+    COMMON_VARIANT_NUM
+};
+
+constexpr const char* g_CommonVariantNames[COMMON_VARIANT_NUM] = {"base", "odd frame", "optional inputs", "validation", "split screen", "passthrough", "restart"};
+
+static void Append(std::string& text, const char* format, ...)
+{
+    char buffer[1024];
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    text += buffer;
+}
+
+static void AppendDispatch(std::string& text, const nrd::DispatchDesc& dispatchDesc, const nrd::InstanceDesc& instanceDesc)
+{
+    static const char* descriptorTypePrefixes[] = {"", "W:", "B:", "I:"};
+
+    Append(text, "%s | %s | %ux%ux%u |", dispatchDesc.name, instanceDesc.pipelines[dispatchDesc.pipelineIndex].shaderFileName, dispatchDesc.gridWidth, dispatchDesc.gridHeight, dispatchDesc.gridDepth);
+
+    for (uint32_t i = 0; i < dispatchDesc.resourcesNum; i++)
+    {
+        const nrd::ResourceDesc& resource = dispatchDesc.resources[i];
+        Append(text, " %s%u(%u)", descriptorTypePrefixes[(uint32_t)resource.descriptorType], (uint32_t)resource.type, resource.indexInPool);
+    }
+}
+
+static void SetCommonSettings(nrd::Instance& instance, uint32_t commonVariant)
+{
+    const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    const float projection[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, -0.1f, 0};
+
+    nrd::CommonSettings commonSettings = {};
+    memcpy(commonSettings.viewToClipMatrix, projection, sizeof(projection));
+    memcpy(commonSettings.viewToClipMatrixPrev, projection, sizeof(projection));
+    memcpy(commonSettings.worldToViewMatrix, identity, sizeof(identity));
+    memcpy(commonSettings.worldToViewMatrixPrev, identity, sizeof(identity));
+    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 1917;
+    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 1071;
+    commonSettings.timeDeltaBetweenFrames = 16.0f;
+    commonSettings.frameIndex = commonVariant == ODD_FRAME ? 1 : 2;
+    commonSettings.isHistoryConfidenceAvailable = commonVariant == OPTIONAL_INPUTS;
+    commonSettings.isDisocclusionThresholdMixAvailable = commonVariant == OPTIONAL_INPUTS;
+    commonSettings.isBaseColorMetalnessAvailable = commonVariant == OPTIONAL_INPUTS;
+    commonSettings.enableValidation = commonVariant == VALIDATION;
+    commonSettings.splitScreen = commonVariant == SPLIT_SCREEN ? 0.5f : (commonVariant == PASSTHROUGH ? 1.0f : 0.0f);
+    commonSettings.accumulationMode = commonVariant == RESTART ? nrd::AccumulationMode::CLEAR_AND_RESTART : nrd::AccumulationMode::CONTINUE;
+
+    nrd::SetCommonSettings(instance, commonSettings);
+}
+
+// Combinations of denoiser settings, the first setting varies fastest
+static const char* GetSweepDescription(nrd::Denoiser denoiser)
+{
+    const char* denoiserName = nrd::GetDenoiserString(denoiser);
+
+    if (!strncmp(denoiserName, "REBLUR", 6))
+        return "performance mode (off, on) x hit distance reconstruction (off, 3x3, 5x5) x pre-pass (on, off) x stabilization (on, off) x checkerboard (off, on)";
+    else if (!strncmp(denoiserName, "RELAX", 5))
+        return "hit distance reconstruction (off, 3x3, 5x5) x pre-pass (on, off) x anti-firefly (off, on) x iterations (2, 3, 5) x checkerboard (off, on)";
+    else if (!strncmp(denoiserName, "SIGMA", 5))
+        return "stabilization (on, off)";
+
+    return "default";
+}
+
+// Returns "false" past the last combination
+static bool SetDenoiserSettings(nrd::Instance& instance, nrd::Denoiser denoiser, uint32_t combination)
+{
+    const char* denoiserName = nrd::GetDenoiserString(denoiser);
+    const nrd::HitDistanceReconstructionMode hitDistanceReconstructionModes[] = {nrd::HitDistanceReconstructionMode::OFF, nrd::HitDistanceReconstructionMode::AREA_3X3, nrd::HitDistanceReconstructionMode::AREA_5X5};
+
+    if (!strncmp(denoiserName, "REBLUR", 6))
+    {
+        if (combination >= 2 * 3 * 2 * 2 * 2)
+            return false;
+
+        nrd::ReblurSettings settings = {};
+        settings.enablePerformanceMode = combination % 2 != 0;
+        settings.hitDistanceReconstructionMode = hitDistanceReconstructionModes[combination / 2 % 3];
+        settings.diffusePrepassBlurRadius = combination / 6 % 2 ? 0.0f : settings.diffusePrepassBlurRadius;
+        settings.specularPrepassBlurRadius = combination / 6 % 2 ? 0.0f : settings.specularPrepassBlurRadius;
+        settings.stabilizationStrength = combination / 12 % 2 ? 0.0f : 1.0f;
+        settings.checkerboardMode = combination / 24 % 2 ? nrd::CheckerboardMode::WHITE : nrd::CheckerboardMode::OFF;
+        nrd::SetDenoiserSettings(instance, 1, &settings);
+    }
+    else if (!strncmp(denoiserName, "RELAX", 5))
+    {
+        const uint32_t atrousIterationNums[] = {2, 3, 5};
+        if (combination >= 3 * 2 * 2 * 3 * 2)
+            return false;
+
+        nrd::RelaxSettings settings = {};
+        settings.hitDistanceReconstructionMode = hitDistanceReconstructionModes[combination % 3];
+        settings.diffusePrepassBlurRadius = combination / 3 % 2 ? 0.0f : settings.diffusePrepassBlurRadius;
+        settings.specularPrepassBlurRadius = combination / 3 % 2 ? 0.0f : settings.specularPrepassBlurRadius;
+        settings.enableAntiFirefly = combination / 6 % 2 != 0;
+        settings.atrousIterationNum = atrousIterationNums[combination / 12 % 3];
+        settings.checkerboardMode = combination / 36 % 2 ? nrd::CheckerboardMode::WHITE : nrd::CheckerboardMode::OFF;
+        nrd::SetDenoiserSettings(instance, 1, &settings);
+    }
+    else if (denoiser == nrd::Denoiser::SIGMA_SHADOW_ARRAY)
+    {
+        if (combination >= 2)
+            return false;
+
+        nrd::SigmaArraySettings settings = {};
+        settings.sigma.stabilizationStrength = combination ? 0.0f : 1.0f;
+        nrd::SetDenoiserSettings(instance, 1, &settings);
+    }
+    else if (!strncmp(denoiserName, "SIGMA", 5))
+    {
+        if (combination >= 2)
+            return false;
+
+        nrd::SigmaSettings settings = {};
+        settings.stabilizationStrength = combination ? 0.0f : 1.0f;
+        nrd::SetDenoiserSettings(instance, 1, &settings);
+    }
+    else if (combination >= 1)
+        return false;
+
+    return true;
+}
+
+static bool AppendDenoiser(std::string& text, nrd::Denoiser denoiser)
+{
+    nrd::DenoiserDesc denoiserDesc = {1, denoiser};
+    if (denoiser == nrd::Denoiser::SIGMA_SHADOW_ARRAY)
+        denoiserDesc.layersNum = 2;
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = &denoiserDesc;
+    instanceCreationDesc.denoisersNum = 1;
+
+    nrd::Instance* instance = nullptr;
+    if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS)
+    {
+        printf("%s: can't create an instance\n", nrd::GetDenoiserString(denoiser));
+        return false;
+    }
+
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*instance);
+
+    std::vector<std::string> dispatches;
+    std::vector<std::string> sequences;
+    std::string combinations;
+    const nrd::Identifier identifier = 1;
+
+    for (uint32_t commonVariant = 0; commonVariant < COMMON_VARIANT_NUM; commonVariant++)
+    {
+        Append(combinations, "    %s:", g_CommonVariantNames[commonVariant]);
+
+        for (uint32_t combination = 0; ; combination++)
+        {
+            SetCommonSettings(*instance, commonVariant);
+            if (!SetDenoiserSettings(*instance, denoiser, combination))
+                break;
+
+            const nrd::DispatchDesc* dispatchDescs = nullptr;
+            uint32_t dispatchDescsNum = 0;
+            if (nrd::GetComputeDispatches(*instance, &identifier, 1, dispatchDescs, dispatchDescsNum) != nrd::Result::SUCCESS)
+            {
+                printf("%s: 'GetComputeDispatches' failed (%s, combination %u)\n", nrd::GetDenoiserString(denoiser), g_CommonVariantNames[commonVariant], combination);
+                nrd::DestroyInstance(*instance);
+
+                return false;
+            }
+
+            std::string sequence;
+            for (uint32_t i = 0; i < dispatchDescsNum; i++)
+            {
+                std::string dispatch;
+                AppendDispatch(dispatch, dispatchDescs[i], instanceDesc);
+
+                size_t dispatchIndex = 0;
+                while (dispatchIndex < dispatches.size() && dispatches[dispatchIndex] != dispatch)
+                    dispatchIndex++;
+
+                if (dispatchIndex == dispatches.size())
+                    dispatches.push_back(dispatch);
+
+                Append(sequence, " %u", (uint32_t)dispatchIndex);
+            }
+
+            size_t sequenceIndex = 0;
+            while (sequenceIndex < sequences.size() && sequences[sequenceIndex] != sequence)
+                sequenceIndex++;
+
+            if (sequenceIndex == sequences.size())
+                sequences.push_back(sequence);
+
+            Append(combinations, " %u", (uint32_t)sequenceIndex);
+        }
+
+        combinations += "\n";
+    }
+
+    Append(text, "%s\n", nrd::GetDenoiserString(denoiser));
+
+    Append(text, "  pipelines\n");
+    for (uint32_t i = 0; i < instanceDesc.pipelinesNum; i++)
+        Append(text, "    %u %s\n", i, instanceDesc.pipelines[i].shaderFileName);
+
+    Append(text, "  dispatches\n");
+    for (size_t i = 0; i < dispatches.size(); i++)
+        Append(text, "    %u %s\n", (uint32_t)i, dispatches[i].c_str());
+
+    Append(text, "  sequences\n");
+    for (size_t i = 0; i < sequences.size(); i++)
+        Append(text, "    %u:%s\n", (uint32_t)i, sequences[i].c_str());
+
+    Append(text, "  combinations: %s\n", GetSweepDescription(denoiser));
+    text += combinations;
+
+    nrd::DestroyInstance(*instance);
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool isUpdate = argc > 1 && !strcmp(argv[1], "--update");
+
+    std::string text;
+    for (uint32_t i = 0; i < (uint32_t)nrd::Denoiser::MAX_NUM; i++)
+    {
+        if (!AppendDenoiser(text, (nrd::Denoiser)i))
+        {
+            printf("FAILED\n");
+            return 1;
+        }
+    }
+
+    if (isUpdate)
+    {
+        FILE* file = fopen(REFERENCE_FILE_NAME, "wb");
+        if (!file || fwrite(text.data(), 1, text.size(), file) != text.size())
+        {
+            printf("Can't write '%s'\n", REFERENCE_FILE_NAME);
+            return 1;
+        }
+
+        fclose(file);
+        printf("'%s' updated\n", REFERENCE_FILE_NAME);
+
+        return 0;
+    }
+
+    std::string reference;
+    FILE* file = fopen(REFERENCE_FILE_NAME, "rb");
+    if (!file)
+    {
+        printf("Can't open '%s'\nFAILED\n", REFERENCE_FILE_NAME);
+        return 1;
+    }
+
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) != 0)
+        reference.append(buffer, size);
+
+    fclose(file);
+
+    // Report the first differing line
+    size_t textLineStart = 0;
+    size_t referenceLineStart = 0;
+    for (uint32_t line = 1; textLineStart < text.size() || referenceLineStart < reference.size(); line++)
+    {
+        size_t textLineEnd = text.find('\n', textLineStart);
+        size_t referenceLineEnd = reference.find('\n', referenceLineStart);
+
+        std::string textLine = textLineStart < text.size() ? text.substr(textLineStart, textLineEnd - textLineStart) : "<end>";
+        std::string referenceLine = referenceLineStart < reference.size() ? reference.substr(referenceLineStart, referenceLineEnd - referenceLineStart) : "<end>";
+
+        if (textLine != referenceLine)
+        {
+            printf("'%s', line %u:\n  expected: %s\n  actual:   %s\nFAILED\n", REFERENCE_FILE_NAME, line, referenceLine.c_str(), textLine.c_str());
+            return 1;
+        }
+
+        textLineStart = textLineEnd == std::string::npos ? text.size() : textLineEnd + 1;
+        referenceLineStart = referenceLineEnd == std::string::npos ? reference.size() : referenceLineEnd + 1;
+    }
+
+    printf("PASSED\n");
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// A reused frame plan must produce the same constants as a rebuilt one, while settings alternate between values differing
+// only in float signs (a hash of the plan key is not enough to tell such keys apart). The reference instance has an extra
+// denoiser (never dispatched), which settings change every frame, so its plan is always rebuilt
+
+#include "NRD.h"
+
+#include <cstdio>
+#include <cstring>
+
+int main()
+{
+    const nrd::DenoiserDesc denoiserDescs[] =
+    {
+        {1, nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR},
+        {2, nrd::Denoiser::SIGMA_SHADOW},
+        {3, nrd::Denoiser::SIGMA_SHADOW},
+    };
+
+    nrd::Instance* instances[2] = {};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        nrd::InstanceCreationDesc instanceCreationDesc = {};
+        instanceCreationDesc.denoisers = denoiserDescs;
+        instanceCreationDesc.denoisersNum = i ? 3 : 2;
+
+        if (nrd::CreateInstance(instanceCreationDesc, instances[i]) != nrd::Result::SUCCESS)
+            return 1;
+    }
+
+    const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    const float projection[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, -0.1f, 0};
+
+    nrd::CommonSettings commonSettings = {};
+    memcpy(commonSettings.viewToClipMatrix, projection, sizeof(projection));
+    memcpy(commonSettings.viewToClipMatrixPrev, projection, sizeof(projection));
+    memcpy(commonSettings.worldToViewMatrix, identity, sizeof(identity));
+    memcpy(commonSettings.worldToViewMatrixPrev, identity, sizeof(identity));
+    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 1920;
+    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 1080;
+    commonSettings.timeDeltaBetweenFrames = 16.0f;
+
+    uint32_t errorsNum = 0;
+    for (uint32_t frame = 0; frame < 8; frame++)
+    {
+        // Settings change every other frame
+        nrd::ReblurSettings reblurSettings = {};
+        if (frame & 2)
+        {
+            reblurSettings.hitDistanceParameters.B = -reblurSettings.hitDistanceParameters.B;
+            reblurSettings.hitDistanceParameters.D = -reblurSettings.hitDistanceParameters.D;
+        }
+
+        nrd::SigmaSettings sigmaSettings = {};
+        sigmaSettings.planeDistanceSensitivity = 0.01f * (frame + 1);
+
+        commonSettings.frameIndex = frame;
+
+        const nrd::DispatchDesc* dispatchDescs[2] = {};
+        uint32_t dispatchDescsNum[2] = {};
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            nrd::SetCommonSettings(*instances[i], commonSettings);
+            nrd::SetDenoiserSettings(*instances[i], 1, &reblurSettings);
+            if (i)
+                nrd::SetDenoiserSettings(*instances[i], 3, &sigmaSettings);
+
+            const nrd::Identifier identifiers[] = {1, 2};
+            nrd::GetComputeDispatches(*instances[i], identifiers, 2, dispatchDescs[i], dispatchDescsNum[i]);
+        }
+
+        if (dispatchDescsNum[0] != dispatchDescsNum[1])
+        {
+            printf("Frame %u: %u dispatches, expected %u\n", frame, dispatchDescsNum[0], dispatchDescsNum[1]);
+            errorsNum++;
+            continue;
+        }
+
+        for (uint32_t i = 0; i < dispatchDescsNum[0]; i++)
+        {
+            const nrd::DispatchDesc& dispatchDesc = dispatchDescs[0][i];
+            const nrd::DispatchDesc& dispatchDescRef = dispatchDescs[1][i];
+
+            bool isSame = dispatchDesc.sharedConstantBufferDataSize == dispatchDescRef.sharedConstantBufferDataSize
+                && dispatchDesc.constantBufferDataSize == dispatchDescRef.constantBufferDataSize
+                && !memcmp(dispatchDesc.sharedConstantBufferData, dispatchDescRef.sharedConstantBufferData, dispatchDesc.sharedConstantBufferDataSize)
+                && !memcmp(dispatchDesc.constantBufferData, dispatchDescRef.constantBufferData, dispatchDesc.constantBufferDataSize);
+
+            // A reused plan keeps constant buffer indices, they must still point to identical constants
+            for (uint32_t j = 0; j < i && isSame; j++)
+            {
+                const nrd::DispatchDesc& dispatchDescPrev = dispatchDescs[0][j];
+                if (dispatchDescPrev.constantBufferIndex != dispatchDesc.constantBufferIndex)
+                    continue;
+
+                isSame = dispatchDescPrev.sharedConstantBufferDataSize == dispatchDesc.sharedConstantBufferDataSize
+                    && dispatchDescPrev.constantBufferDataSize == dispatchDesc.constantBufferDataSize
+                    && !memcmp(dispatchDescPrev.sharedConstantBufferData, dispatchDesc.sharedConstantBufferData, dispatchDesc.sharedConstantBufferDataSize)
+                    && !memcmp(dispatchDescPrev.constantBufferData, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
+            }
+
+            if (!isSame || strcmp(dispatchDesc.name, dispatchDescRef.name))
+            {
+                printf("Frame %u: '%s' (%u) doesn't match the rebuilt plan\n", frame, dispatchDesc.name, i);
+                errorsNum++;
+            }
+        }
+    }
+
+    for (nrd::Instance* instance : instances)
+        nrd::DestroyInstance(*instance);
+
+    printf("%s\n", errorsNum ? "FAILED" : "PASSED");
+
+    return errorsNum ? 1 : 0;
+}
@@ -0,0 +1,265 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Validates "InstanceCreationDesc::enableGuideSharing":
+// - without it, each denoiser classifies tiles and owns previous-frame guides
+// - with it, tile classification is executed once, and previous-frame guides are shared: a denoiser reads the texture written
+//   by the previous frame (and only by it), passes after the write read the texture written in the current frame
+
+#include "NRD.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <vector>
+
+static const nrd::DenoiserDesc g_DenoiserDescs[] =
+{
+    {1, nrd::Denoiser::REBLUR_DIFFUSE},
+    {2, nrd::Denoiser::REBLUR_SPECULAR_OCCLUSION},
+    {3, nrd::Denoiser::RELAX_DIFFUSE},
+    {4, nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR},
+    {5, nrd::Denoiser::REBLUR_DIFFUSE_SH},
+};
+
+static const uint32_t g_DenoisersNum = (uint32_t)(sizeof(g_DenoiserDescs) / sizeof(g_DenoiserDescs[0]));
+static const uint32_t g_ReblurDenoisersNum = 4;
+
+static nrd::CommonSettings GetCommonSettings(uint32_t frameIndex)
+{
+    const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    const float projection[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, -0.1f, 0};
+
+    nrd::CommonSettings commonSettings = {};
+    memcpy(commonSettings.viewToClipMatrix, projection, sizeof(projection));
+    memcpy(commonSettings.viewToClipMatrixPrev, projection, sizeof(projection));
+    memcpy(commonSettings.worldToViewMatrix, identity, sizeof(identity));
+    memcpy(commonSettings.worldToViewMatrixPrev, identity, sizeof(identity));
+    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = 1920;
+    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = 1080;
+    commonSettings.timeDeltaBetweenFrames = 16.0f;
+    commonSettings.frameIndex = frameIndex;
+    commonSettings.accumulationMode = frameIndex == 4 ? nrd::AccumulationMode::CLEAR_AND_RESTART : nrd::AccumulationMode::CONTINUE;
+
+    return commonSettings;
+}
+
+static nrd::Instance* CreateInstance(bool enableGuideSharing)
+{
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = g_DenoiserDescs;
+    instanceCreationDesc.denoisersNum = g_DenoisersNum;
+    instanceCreationDesc.enableGuideSharing = enableGuideSharing;
+
+    nrd::Instance* instance = nullptr;
+    if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS)
+        return nullptr;
+
+    return instance;
+}
+
+static uint32_t CheckFrames(nrd::Instance& instance, bool enableGuideSharing)
+{
+    const char* name = enableGuideSharing ? "shared" : "not shared";
+
+    nrd::Identifier identifiers[g_DenoisersNum];
+    for (uint32_t i = 0; i < g_DenoisersNum; i++)
+        identifiers[i] = g_DenoiserDescs[i].identifier;
+
+    // Accesses of REBLUR passes to permanent textures
+    struct Access
+    {
+        const char* name;
+        uint32_t frameIndex;
+        uint16_t indexInPool;
+        bool isWrite;
+    };
+
+    std::vector<Access> accesses;
+
+    uint32_t errorsNum = 0;
+    for (uint32_t frameIndex = 0; frameIndex < 8; frameIndex++)
+    {
+        nrd::CommonSettings commonSettings = GetCommonSettings(frameIndex);
+        nrd::SetCommonSettings(instance, commonSettings);
+
+        const nrd::DispatchDesc* dispatchDescs = nullptr;
+        uint32_t dispatchDescsNum = 0;
+        if (nrd::GetComputeDispatches(instance, identifiers, g_DenoisersNum, dispatchDescs, dispatchDescsNum) != nrd::Result::SUCCESS)
+        {
+            printf("%s: frame %u failed\n", name, frameIndex);
+            return errorsNum + 1;
+        }
+
+        uint32_t classificationsNum = 0;
+        for (uint32_t i = 0; i < dispatchDescsNum; i++)
+        {
+            const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+            if (!strstr(dispatchDesc.name, "REBLUR"))
+                continue;
+
+            if (strstr(dispatchDesc.name, "Classify tiles"))
+                classificationsNum++;
+
+            for (uint32_t r = 0; r < dispatchDesc.resourcesNum; r++)
+            {
+                const nrd::ResourceDesc& resource = dispatchDesc.resources[r];
+                if (resource.type == nrd::ResourceType::PERMANENT_POOL)
+                    accesses.push_back( {dispatchDesc.name, frameIndex, resource.indexInPool, resource.descriptorType == nrd::DescriptorType::STORAGE_TEXTURE} );
+            }
+        }
+
+        uint32_t expectedClassificationsNum = enableGuideSharing ? 1 : g_ReblurDenoisersNum;
+        if (classificationsNum != expectedClassificationsNum)
+        {
+            printf("%s: frame %u: %u tile classifications, %u expected\n", name, frameIndex, classificationsNum, expectedClassificationsNum);
+            errorsNum++;
+        }
+    }
+
+    // "Temporal accumulation" reads textures written in the previous frame (nothing in the first frame). Previous-frame guides and
+    // internal data are written by "Blur" and "Post-blur", next passes read them in the current frame
+    std::map<uint16_t, int32_t> lastWrites;
+    std::map<uint16_t, bool> isGuide;
+    for (const Access& access : accesses)
+    {
+        if (access.isWrite && (strstr(access.name, " - Blur") || strstr(access.name, " - Post-blur")))
+            isGuide[access.indexInPool] = true;
+    }
+
+    for (const Access& access : accesses)
+    {
+        if (access.isWrite)
+        {
+            lastWrites[access.indexInPool] = int32_t(access.frameIndex);
+            continue;
+        }
+
+        auto lastWrite = lastWrites.find(access.indexInPool);
+        int32_t lastWriteFrameIndex = lastWrite == lastWrites.end() ? -1 : lastWrite->second;
+
+        int32_t expectedFrameIndex = int32_t(access.frameIndex);
+        if (strstr(access.name, "Temporal accumulation"))
+            expectedFrameIndex--;
+        else if (!isGuide[access.indexInPool])
+            continue;
+
+        if (lastWriteFrameIndex != expectedFrameIndex)
+        {
+            printf("%s: frame %u: '%s' reads texture %u written in frame %d, frame %d expected\n", name, access.frameIndex, access.name, access.indexInPool, lastWriteFrameIndex, expectedFrameIndex);
+            errorsNum++;
+        }
+    }
+
+    return errorsNum;
+}
+
+int main()
+{
+    uint32_t errorsNum = 0;
+
+    nrd::Instance* instance = CreateInstance(false);
+    nrd::Instance* instanceShared = CreateInstance(true);
+    nrd::Instance* instanceSharedRef = CreateInstance(true);
+    if (!instance || !instanceShared || !instanceSharedRef)
+    {
+        printf("FAILED\n");
+        return 1;
+    }
+
+    // Two textures per shared guide (view Z and normal-roughness) instead of one per denoiser
+    uint32_t permanentPoolSize = nrd::GetInstanceDesc(*instance).permanentPoolSize;
+    uint32_t permanentPoolSizeShared = nrd::GetInstanceDesc(*instanceShared).permanentPoolSize;
+    if (permanentPoolSize - permanentPoolSizeShared != (g_ReblurDenoisersNum - 2) * 2)
+    {
+        printf("Permanent pool: %u textures, %u shared\n", permanentPoolSize, permanentPoolSizeShared);
+        errorsNum++;
+    }
+
+    errorsNum += CheckFrames(*instance, false);
+    errorsNum += CheckFrames(*instanceShared, true);
+    CheckFrames(*instanceSharedRef, true);
+
+    // Shared previous-frame guides can't be written by several views
+    nrd::CommonSettings commonSettings = GetCommonSettings(0);
+    const nrd::Identifier identifiers0[] = {1, 2};
+    const nrd::Identifier identifiers1[] = {4};
+    const nrd::ViewDesc viewDescs[] = { {&commonSettings, identifiers0, 2}, {&commonSettings, identifiers1, 1} };
+
+    const nrd::DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+    if (nrd::GetComputeDispatchesMultiView(*instanceShared, viewDescs, 2, dispatchDescs, dispatchDescsNum) != nrd::Result::INVALID_ARGUMENT)
+    {
+        printf("Shared previous-frame guides are written by several views\n");
+        errorsNum++;
+    }
+
+    // A denoiser can't belong to several views, views must be complete
+    const nrd::Identifier identifiers2[] = {3, 1};
+    const nrd::ViewDesc viewDescsDuplicated[] = { {&commonSettings, identifiers0, 2}, {&commonSettings, identifiers2, 2} };
+    const nrd::ViewDesc viewDescsIncomplete[] = { {&commonSettings, identifiers0, 2}, {nullptr, identifiers1, 1} };
+    if (nrd::GetComputeDispatchesMultiView(*instanceShared, viewDescsDuplicated, 2, dispatchDescs, dispatchDescsNum) != nrd::Result::INVALID_ARGUMENT ||
+        nrd::GetComputeDispatchesMultiView(*instanceShared, viewDescsIncomplete, 2, dispatchDescs, dispatchDescsNum) != nrd::Result::INVALID_ARGUMENT)
+    {
+        printf("Invalid views are accepted\n");
+        errorsNum++;
+    }
+
+    // Rejected calls must not change the state: the next frame binds the same ping-pong and previous-frame textures as an instance,
+    // which hasn't seen them
+    nrd::Identifier identifiers[g_DenoisersNum];
+    for (uint32_t i = 0; i < g_DenoisersNum; i++)
+        identifiers[i] = g_DenoiserDescs[i].identifier;
+
+    nrd::CommonSettings commonSettingsNext = GetCommonSettings(8);
+    nrd::SetCommonSettings(*instanceShared, commonSettingsNext);
+    nrd::SetCommonSettings(*instanceSharedRef, commonSettingsNext);
+
+    const nrd::DispatchDesc* dispatchDescsRef = nullptr;
+    uint32_t dispatchDescsRefNum = 0;
+    nrd::Result result = nrd::GetComputeDispatches(*instanceShared, identifiers, g_DenoisersNum, dispatchDescs, dispatchDescsNum);
+    nrd::Result resultRef = nrd::GetComputeDispatches(*instanceSharedRef, identifiers, g_DenoisersNum, dispatchDescsRef, dispatchDescsRefNum);
+
+    bool isSame = result == nrd::Result::SUCCESS && resultRef == nrd::Result::SUCCESS && dispatchDescsNum == dispatchDescsRefNum;
+    for (uint32_t i = 0; i < dispatchDescsNum && isSame; i++)
+    {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+        const nrd::DispatchDesc& dispatchDescRef = dispatchDescsRef[i];
+
+        isSame = !strcmp(dispatchDesc.name, dispatchDescRef.name) && dispatchDesc.resourcesNum == dispatchDescRef.resourcesNum;
+        for (uint32_t r = 0; r < dispatchDesc.resourcesNum && isSame; r++)
+        {
+            const nrd::ResourceDesc& resource = dispatchDesc.resources[r];
+            const nrd::ResourceDesc& resourceRef = dispatchDescRef.resources[r];
+
+            isSame = resource.type == resourceRef.type && resource.indexInPool == resourceRef.indexInPool && resource.descriptorType == resourceRef.descriptorType;
+        }
+    }
+
+    if (!isSame)
+    {
+        printf("Rejected multi-view calls changed the state\n");
+        errorsNum++;
+    }
+
+    if (nrd::GetComputeDispatchesMultiView(*instance, viewDescs, 2, dispatchDescs, dispatchDescsNum) != nrd::Result::SUCCESS)
+    {
+        printf("Not shared previous-frame guides can't be written by several views\n");
+        errorsNum++;
+    }
+
+    nrd::DestroyInstance(*instance);
+    nrd::DestroyInstance(*instanceShared);
+    nrd::DestroyInstance(*instanceSharedRef);
+
+    printf("%s\n", errorsNum ? "FAILED" : "PASSED");
+
+    return errorsNum ? 1 : 0;
+}
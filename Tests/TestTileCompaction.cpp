@@ -0,0 +1,221 @@
+/*
+Copyright (c) 2022, NVIDIA CORPORATION. All rights reserved.
+
+NVIDIA CORPORATION and its licensors retain all intellectual property
+and proprietary rights in and to this software, related documentation
+and any modifications thereto. Any use, reproduction, disclosure or
+distribution of this software and related documentation without an express
+license agreement from NVIDIA CORPORATION is strictly prohibited.
+*/
+
+// Validates tile compaction and indirect dispatches:
+// - the CPU reference of "REBLUR_CompactTiles" against a brute-force row-major scan
+// - REBLUR dispatches: "Compact tiles" writes indirect arguments consumed by the following indirect dispatches
+
+#include "NRD.h"
+#include "../Source/TileCompaction.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static uint32_t CheckCompaction(const char* name, const std::vector<float>& tiles, uint32_t tilesW, uint32_t tilesH)
+{
+    const uint32_t groupsPerTileX = 2;
+    const uint32_t groupsPerTileY = 1;
+
+    std::vector<uint32_t> tileList(tilesW * tilesH, 0xCDCDCDCD);
+    uint32_t indirectArgs[3] = {};
+    uint32_t listNum = nrd::CompactTiles(tiles.data(), tilesW, tilesH, groupsPerTileX, groupsPerTileY, tileList.data(), indirectArgs);
+
+    // Brute force
+    std::vector<uint32_t> expected;
+    for (uint32_t y = 0; y < tilesH; y++)
+    {
+        for (uint32_t x = 0; x < tilesW; x++)
+        {
+            if (tiles[y * tilesW + x] == 0.0f)
+                expected.push_back(nrd::PackTile(x, y));
+        }
+    }
+
+    uint32_t errorsNum = 0;
+    if (listNum != expected.size())
+    {
+        printf("%s: %u tiles listed, %u expected\n", name, listNum, (uint32_t)expected.size());
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < listNum; i++)
+    {
+        if (tileList[i] != expected[i])
+        {
+            printf("%s: entry %u is %08X, %08X expected\n", name, i, tileList[i], expected[i]);
+            errorsNum++;
+            break;
+        }
+    }
+
+    uint32_t listRowsNum = (listNum + tilesW - 1) / tilesW;
+    for (uint32_t i = listNum; i < listRowsNum * tilesW; i++)
+    {
+        if (tileList[i] != nrd::INVALID_TILE)
+        {
+            printf("%s: unused entry %u is not invalid\n", name, i);
+            errorsNum++;
+            break;
+        }
+    }
+
+    // Every listed tile must be covered by exactly "groupsPerTile" groups, invalid slots are the only extra groups
+    uint32_t expectedArgs[3] = {groupsPerTileX * (listNum < tilesW ? listNum : tilesW), groupsPerTileY * listRowsNum, 1};
+    if (memcmp(indirectArgs, expectedArgs, sizeof(expectedArgs)))
+    {
+        printf("%s: indirect arguments %u x %u x %u, %u x %u x %u expected\n", name, indirectArgs[0], indirectArgs[1], indirectArgs[2], expectedArgs[0], expectedArgs[1], expectedArgs[2]);
+        errorsNum++;
+    }
+
+    if (indirectArgs[0] * indirectArgs[1] < listNum * groupsPerTileX * groupsPerTileY)
+    {
+        printf("%s: indirect arguments don't cover all listed tiles\n", name);
+        errorsNum++;
+    }
+
+    return errorsNum;
+}
+
+static uint32_t CheckDispatches()
+{
+    const nrd::DenoiserDesc denoiserDescs[] =
+    {
+        {1, nrd::Denoiser::REBLUR_DIFFUSE_SPECULAR},
+        {2, nrd::Denoiser::REBLUR_DIFFUSE_OCCLUSION},
+    };
+
+    nrd::InstanceCreationDesc instanceCreationDesc = {};
+    instanceCreationDesc.denoisers = denoiserDescs;
+    instanceCreationDesc.denoisersNum = (uint32_t)(sizeof(denoiserDescs) / sizeof(denoiserDescs[0]));
+
+    nrd::Instance* instance = nullptr;
+    if (nrd::CreateInstance(instanceCreationDesc, instance) != nrd::Result::SUCCESS)
+        return 1;
+
+    const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    const float projection[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, -0.1f, 0};
+
+    // Not a multiple of the tile size
+    const uint16_t rectW = 1917;
+    const uint16_t rectH = 1071;
+
+    nrd::CommonSettings commonSettings = {};
+    memcpy(commonSettings.viewToClipMatrix, projection, sizeof(projection));
+    memcpy(commonSettings.viewToClipMatrixPrev, projection, sizeof(projection));
+    memcpy(commonSettings.worldToViewMatrix, identity, sizeof(identity));
+    memcpy(commonSettings.worldToViewMatrixPrev, identity, sizeof(identity));
+    commonSettings.resourceSize[0] = commonSettings.resourceSizePrev[0] = commonSettings.rectSize[0] = commonSettings.rectSizePrev[0] = rectW;
+    commonSettings.resourceSize[1] = commonSettings.resourceSizePrev[1] = commonSettings.rectSize[1] = commonSettings.rectSizePrev[1] = rectH;
+    commonSettings.timeDeltaBetweenFrames = 16.0f;
+    nrd::SetCommonSettings(*instance, commonSettings);
+
+    const nrd::Identifier identifiers[] = {1, 2};
+    const nrd::DispatchDesc* dispatchDescs = nullptr;
+    uint32_t dispatchDescsNum = 0;
+    nrd::GetComputeDispatches(*instance, identifiers, 2, dispatchDescs, dispatchDescsNum);
+
+    uint32_t tilesW = (rectW + nrd::TILE_SIZE - 1) / nrd::TILE_SIZE;
+    uint32_t tilesH = (rectH + nrd::TILE_SIZE - 1) / nrd::TILE_SIZE;
+
+    uint32_t errorsNum = 0;
+    uint32_t compactionsNum = 0;
+    uint32_t indirectDispatchesNum = 0;
+    const nrd::ResourceDesc* indirectArguments = nullptr;
+    for (uint32_t i = 0; i < dispatchDescsNum; i++)
+    {
+        const nrd::DispatchDesc& dispatchDesc = dispatchDescs[i];
+        const nrd::ResourceDesc& lastResource = dispatchDesc.resources[dispatchDesc.resourcesNum - 1];
+
+        if (strstr(dispatchDesc.name, "Compact tiles"))
+        {
+            if (lastResource.descriptorType != nrd::DescriptorType::STORAGE_BUFFER || lastResource.type != nrd::ResourceType::INDIRECT_ARGUMENTS_POOL || dispatchDesc.isIndirect)
+            {
+                printf("'%s' (%u): doesn't write indirect arguments\n", dispatchDesc.name, i);
+                errorsNum++;
+            }
+
+            if (dispatchDesc.gridWidth != 1 || dispatchDesc.gridHeight != 1)
+            {
+                printf("'%s' (%u): not a single group\n", dispatchDesc.name, i);
+                errorsNum++;
+            }
+
+            indirectArguments = &lastResource;
+            compactionsNum++;
+        }
+        else if (dispatchDesc.isIndirect)
+        {
+            if (!indirectArguments || lastResource.descriptorType != nrd::DescriptorType::INDIRECT_ARGUMENTS || lastResource.indexInPool != indirectArguments->indexInPool)
+            {
+                printf("'%s' (%u): indirect arguments are not written by the preceding compaction\n", dispatchDesc.name, i);
+                errorsNum++;
+            }
+
+            // The grid is an upper bound of the arguments (2 x 1 groups of 8 x 16 threads per tile)
+            if (dispatchDesc.gridWidth < tilesW * 2 || dispatchDesc.gridHeight < tilesH)
+            {
+                printf("'%s' (%u): grid %u x %u is smaller than the indirect arguments bound\n", dispatchDesc.name, i, dispatchDesc.gridWidth, dispatchDesc.gridHeight);
+                errorsNum++;
+            }
+
+            indirectDispatchesNum++;
+        }
+    }
+
+    if (compactionsNum != 2 || indirectDispatchesNum == 0)
+    {
+        printf("Unexpected number of compactions (%u) or indirect dispatches (%u)\n", compactionsNum, indirectDispatchesNum);
+        errorsNum++;
+    }
+
+    const nrd::InstanceDesc& instanceDesc = nrd::GetInstanceDesc(*instance);
+    if (instanceDesc.indirectArgumentsPoolSize != 2 || instanceDesc.indirectArgumentsBufferSize < sizeof(uint32_t) * 3)
+    {
+        printf("Unexpected indirect arguments pool\n");
+        errorsNum++;
+    }
+
+    nrd::DestroyInstance(*instance);
+
+    return errorsNum;
+}
+
+int main()
+{
+    uint32_t errorsNum = 0;
+
+    // Random classifications, including sizes not divisible by the number of threads
+    const uint32_t sizes[][2] = { {120, 68}, {1, 1}, {17, 3}, {257, 1}, {480, 270} };
+    srand(1);
+    for (const auto& size : sizes)
+    {
+        std::vector<float> tiles(size[0] * size[1]);
+        for (float& tile : tiles)
+            tile = (rand() % 3) == 0 ? 1.0f : 0.0f;
+
+        errorsNum += CheckCompaction("random", tiles, size[0], size[1]);
+    }
+
+    // Extremes
+    errorsNum += CheckCompaction("all sky", std::vector<float>(120 * 68, 1.0f), 120, 68);
+    errorsNum += CheckCompaction("no sky", std::vector<float>(120 * 68, 0.0f), 120, 68);
+
+    std::vector<float> single(120 * 68, 1.0f);
+    single.back() = 0.0f;
+    errorsNum += CheckCompaction("last tile only", single, 120, 68);
+
+    errorsNum += CheckDispatches();
+
+    printf("%s\n", errorsNum ? "FAILED" : "PASSED");
+
+    return errorsNum ? 1 : 0;
+}